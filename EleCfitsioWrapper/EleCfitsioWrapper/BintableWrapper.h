@@ -23,6 +23,9 @@
 #include "EleCfitsioWrapper/CfitsioUtils.h"
 #include "EleCfitsioWrapper/TypeWrapper.h"
 #include "EleFitsData/Column.h"
+#include "EleFitsData/FixedStringColumn.h"
+#include "EleFitsData/TableCompression.h"
+#include "EleFitsData/VlaColumn.h"
 
 #include <tuple>
 #include <vector>
@@ -60,11 +63,174 @@ std::string columnName(fitsfile* fptr, long index);
  */
 void updateColumnName(fitsfile* fptr, long index, const std::string& newName);
 
+/**
+ * @brief Read the shape of the cells of a given column, i.e. `TDIMn`.
+ * @param index The 1-based column index
+ * @details
+ * An empty shape is returned if the cells are flat, i.e. if `TDIMn` is missing or one-dimensional.
+ */
+Fits::Position<-1> readColumnShape(fitsfile* fptr, long index);
+
+/**
+ * @brief Write the shape of the cells of a given column as `TDIMn`.
+ * @param index The 1-based column index
+ * @details
+ * Nothing is written if the shape is empty.
+ */
+void updateColumnShape(fitsfile* fptr, long index, const Fits::Position<-1>& shape);
+
 /**
  * @brief Get the index of a binary table column.
  */
 long columnIndex(fitsfile* fptr, const std::string& name);
 
+/**
+ * @brief Insert zero-initialized rows.
+ * @param fptr The file
+ * @param firstRow The 1-based index of the first inserted row
+ * @param rowCount The number of rows
+ */
+void insertRows(fitsfile* fptr, long firstRow, long rowCount);
+
+/**
+ * @brief Delete contiguous rows.
+ * @param fptr The file
+ * @param firstRow The 1-based index of the first deleted row
+ * @param rowCount The number of rows
+ */
+void deleteRows(fitsfile* fptr, long firstRow, long rowCount);
+
+/**
+ * @brief Insert contiguous zero-initialized columns.
+ * @param fptr The file
+ * @param index The 1-based index of the first inserted column
+ * @param names The column names
+ * @param tforms The column `TFORMn` values
+ * @param units The column units, possibly empty
+ * @details
+ * The header space is reserved at once for all the new keywords,
+ * and the data unit is rewritten once whatever the number of columns.
+ */
+void initColumns(
+    fitsfile* fptr,
+    long index,
+    const std::vector<std::string>& names,
+    const std::vector<std::string>& tforms,
+    const std::vector<std::string>& units);
+
+/**
+ * @brief Delete possibly non-contiguous columns.
+ * @param fptr The file
+ * @param indices The 1-based indices of the columns, in any order
+ * @details
+ * The new row layout is computed once, and the data unit (including the heap) is rewritten in a single pass,
+ * by blocks of rows of the size of the CFitsIO buffer.
+ */
+void deleteColumns(fitsfile* fptr, std::vector<long> indices);
+
+/**
+ * @brief Get the number of bytes of a field in a row, given its `TFORMn` value.
+ * @return The number of bytes, or -1 if the data type letter is unknown
+ */
+long fieldByteCount(const std::string& tform);
+
+/**
+ * @brief Read a block of contiguous rows as raw bytes.
+ * @param fptr The file
+ * @param firstRow The 1-based index of the first row
+ * @param rowCount The number of rows
+ * @param rowWidth The number of bytes per row, i.e. `NAXIS1`
+ * @param destination The output array of size `rowCount * rowWidth`
+ * @details
+ * Data is not decoded: values are big-endian and `TSCALn`/`TZEROn` are not applied.
+ */
+void readRowBytes(fitsfile* fptr, long firstRow, long rowCount, long rowWidth, unsigned char* destination);
+
+/**
+ * @brief Write a block of contiguous rows as raw bytes.
+ * @param fptr The file
+ * @param firstRow The 1-based index of the first row
+ * @param rowCount The number of rows
+ * @param rowWidth The number of bytes per row, i.e. `NAXIS1`
+ * @param source The input array of size `rowCount * rowWidth`, already encoded
+ * @details
+ * The table is extended if needed.
+ */
+void writeRowBytes(fitsfile* fptr, long firstRow, long rowCount, long rowWidth, const unsigned char* source);
+
+/**
+ * @brief Get the `TFORMn` letter of the values of a variable-length array column, e.g. `E` for `1PE(100)`.
+ * @param index The 1-based column index
+ * @details
+ * Throw if the column is not a variable-length array column.
+ */
+char vlaLetter(fitsfile* fptr, long index);
+
+/**
+ * @brief Read the descriptors of a segment of a variable-length array column.
+ * @param rows The 1-based row segment
+ * @param index The 1-based column index
+ * @param sizes The output numbers of values of the entries
+ * @param heapOffsets The output positions of the entries in the heap, in bytes
+ */
+void readDescriptors(
+    fitsfile* fptr,
+    const Fits::Segment& rows,
+    long index,
+    std::vector<long>& sizes,
+    std::vector<long>& heapOffsets);
+
+/**
+ * @brief Read a block of the heap as raw bytes.
+ * @param heapOffset The position of the block in the heap, in bytes
+ * @param byteCount The number of bytes
+ * @param destination The output array of size `byteCount`
+ * @details
+ * Data is not decoded: values are big-endian and `TSCALn`/`TZEROn` are not applied.
+ */
+void readHeapBytes(fitsfile* fptr, long heapOffset, long byteCount, unsigned char* destination);
+
+/**
+ * @brief Check whether the current HDU is a tile-compressed binary table, i.e. whether `ZTABLE` = `T`.
+ */
+bool isCompressed(fitsfile* fptr);
+
+/**
+ * @brief Read the compression parameters of a tile-compressed binary table.
+ * @details
+ * The parameters are read from the `ZTILELEN` and `ZCTYPn` records.
+ */
+Fits::TableCompression readCompression(fitsfile* fptr);
+
+/**
+ * @brief Uncompress a tile-compressed binary table into a memory file.
+ * @return The memory file, whose current HDU is the uncompressed binary table
+ * @details
+ * The memory file should be closed with `FileAccess::close()`.
+ */
+fitsfile* uncompress(fitsfile* fptr);
+
+/**
+ * @brief Compress the binary table of a memory file and append it to a file.
+ * @param buffer The memory file, whose current HDU is an uncompressed binary table
+ * @param compression The compression parameters
+ * @param fptr The destination file
+ * @details
+ * The parameters are written to the buffer header as `FZTILELN` and `FZALGn` records,
+ * which are read by CFitsIO.
+ */
+void compress(fitsfile* buffer, const Fits::TableCompression& compression, fitsfile* fptr);
+
+/**
+ * @brief Replace the current HDU of a file with the compressed binary table of a memory file.
+ * @copydetails compress()
+ * 
+ * The table is compressed into a temporary memory file, and then copied in place of the current HDU,
+ * such that the indices of the following HDUs are unchanged.
+ * The records which are related neither to the columns nor to the compression are kept from the current HDU.
+ */
+void updateCompressed(fitsfile* buffer, const Fits::TableCompression& compression, fitsfile* fptr);
+
 /**
  * @brief Read the metadata of a binary table column with given index.
  */
@@ -83,6 +249,41 @@ Fits::VecColumn<T> readColumn(fitsfile* fptr, long index);
 template <typename T>
 void readColumnSegment(fitsfile* fptr, const Fits::Segment& rows, long index, Fits::Column<T>& column);
 
+/**
+ * @brief Read contiguous elements of a cell of a vector column with given index.
+ * @param row The 1-based row index
+ * @param index The 1-based column index
+ * @param firstElement The 1-based index of the first element in the cell
+ * @param elementCount The number of elements
+ * @param destination The output array of size `elementCount`
+ */
+template <typename T>
+void readColumnElements(fitsfile* fptr, long row, long index, long firstElement, long elementCount, T* destination);
+
+/**
+ * @brief Read the segment of a string column with given index into a fixed-width string column.
+ * @param front The 0-based index of the first row of the column to be filled
+ * @details
+ * The strings are read with a single call to CFitsIO, directly into the arena of the column.
+ */
+void readColumnSegment(
+    fitsfile* fptr,
+    const Fits::Segment& rows,
+    long index,
+    Fits::FixedStringColumn& column,
+    long front = 0);
+
+/**
+ * @brief Read the segment of a variable-length array column with given index, and append it to a `VlaColumn`.
+ * @details
+ * The descriptors are read with a single call to CFitsIO.
+ * If the values can be decoded from raw bytes, the heap is then walked in increasing offset order,
+ * and adjacent or nearby entries are read together with a single heap access.
+ * Otherwise, the entries are read one by one by CFitsIO, which applies the conversions.
+ */
+template <typename T>
+void readColumnSegment(fitsfile* fptr, const Fits::Segment& rows, long index, Fits::VlaColumn<T>& column);
+
 /**
  * @brief Read a binary table column with given name.
  */
@@ -113,6 +314,44 @@ void writeColumn(fitsfile* fptr, const Fits::Column<T>& column);
 template <typename T>
 void writeColumnSegment(fitsfile* fptr, long firstRow, const Fits::Column<T>& column);
 
+/**
+ * @brief Write a segment of a binary table column with given index.
+ * @details
+ * As opposed to the previous overload, the column name is not looked up.
+ */
+template <typename T>
+void writeColumnSegment(fitsfile* fptr, long firstRow, long index, const Fits::Column<T>& column);
+
+/**
+ * @brief Write some rows of a fixed-width string column to the string column with given index.
+ * @param rows The 0-based indices of the rows of the column to be written
+ * @details
+ * The strings are written with a single call to CFitsIO, directly from the arena of the column.
+ */
+void writeColumnSegment(
+    fitsfile* fptr,
+    long firstRow,
+    long index,
+    const Fits::FixedStringColumn& column,
+    const Fits::Segment& rows);
+
+/**
+ * @brief Write some rows of a `VlaColumn` to the variable-length array column with given index.
+ * @param rows The 0-based indices of the rows of the column to be written
+ * @details
+ * The table is extended if needed.
+ * The values of all the entries are appended to the heap as a single contiguous block, with one call to CFitsIO,
+ * and the descriptors are then pointed to the entries inside the block.
+ * Heap space used by overwritten entries is not reclaimed.
+ */
+template <typename T>
+void writeColumnSegment(
+    fitsfile* fptr,
+    long firstRow,
+    long index,
+    const Fits::VlaColumn<T>& column,
+    const Fits::Segment& rows);
+
 /**
  * @brief Write several binary table columns.
  */
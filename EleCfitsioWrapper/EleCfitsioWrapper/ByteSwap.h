@@ -0,0 +1,231 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELECFITSIOWRAPPER_BYTESWAP_H
+#define _ELECFITSIOWRAPPER_BYTESWAP_H
+
+#include <complex>
+#include <cstdint>
+#include <string>
+
+namespace Euclid {
+namespace Cfitsio {
+
+/**
+ * @brief The encoding of a value type in binary tables, i.e. the `TFORMn` letter and the `TZEROn` value.
+ * @details
+ * Unsigned integers (resp. signed bytes) are stored in the file as signed integers (resp. unsigned bytes),
+ * with an offset which is equivalent to toggling the most significant bit.
+ * Plain `char` is encoded like `signed char`, with a `TZEROn` of -128, which is what `TypeCode<char>` writes:
+ * the bit patterns are the same as those CFitsIO reads, even where plain `char` is unsigned.
+ * Only the value types which binary table columns are bound to are encoded, e.g. `std::int64_t`:
+ * `long long` has no binary table type code when it is distinct from `std::int64_t`, and is not encoded then.
+ * Types which cannot be decoded from raw bytes, like strings, have a null letter.
+ */
+template <typename T>
+struct FitsEncoding {
+
+  /**
+   * @brief The `TFORMn` letter of the data in the file.
+   */
+  inline static char letter();
+
+  /**
+   * @brief The `TZEROn` value.
+   */
+  inline static double zero();
+};
+
+/**
+ * @brief Convert in place an array of big-endian values, as stored in FITS files, to the native byte order.
+ * @details
+ * This is a no-op on big-endian machines.
+ * The loop is written such that the compiler can vectorize it (e.g. as SIMD byte shuffles).
+ */
+template <typename T>
+void bigEndianToNative(T* data, long count);
+
+/**
+ * @brief Complex specialization, which swaps the real and imaginary parts separately.
+ */
+template <typename T>
+void bigEndianToNative(std::complex<T>* data, long count);
+
+/**
+ * @brief Toggle the most significant bit of an array of integers.
+ * @details
+ * This applies the `TZEROn` offset of unsigned integers and signed bytes.
+ */
+template <typename T>
+void toggleSignBit(T* data, long count);
+
+/**
+ * @brief Copy a field of each row of a block of raw rows into a contiguous array, and convert it to native values.
+ * @param block The raw rows, as read by `fits_read_tblbytes()`
+ * @param rowCount The number of rows
+ * @param rowWidth The number of bytes per row, i.e. `NAXIS1`
+ * @param byteOffset The position of the field in each row, in bytes
+ * @param repeatCount The number of values in the field
+ * @param destination The output array of size `rowCount * repeatCount`
+ * @details
+ * Rows are first copied contiguously, and bytes are swapped in a second pass,
+ * which is much easier to vectorize than strided accesses.
+ * `TZEROn` offsets are not applied.
+ */
+template <typename T>
+void scatterField(
+    const unsigned char* block,
+    long rowCount,
+    long rowWidth,
+    long byteOffset,
+    long repeatCount,
+    T* destination);
+
+/**
+ * @brief Scatter a field of a block of raw rows, and apply the `TZEROn` offset of the value type, if any.
+ * @copydetails scatterField()
+ */
+template <typename T>
+void decodeField(
+    const unsigned char* block,
+    long rowCount,
+    long rowWidth,
+    long byteOffset,
+    long repeatCount,
+    T* destination);
+
+/**
+ * @brief String overload, which throws because strings cannot be decoded from raw bytes.
+ */
+void decodeField(
+    const unsigned char* block,
+    long rowCount,
+    long rowWidth,
+    long byteOffset,
+    long repeatCount,
+    std::string* destination);
+
+/**
+ * @brief Encode values as big-endian, as stored in FITS files, and write them as a field of a block of raw rows.
+ * @param source The input array of size `rowCount * repeatCount`
+ * @param rowCount The number of rows
+ * @param rowWidth The number of bytes per row, i.e. `NAXIS1`
+ * @param byteOffset The position of the field in each row, in bytes
+ * @param repeatCount The number of values in the field
+ * @param block The raw rows, to be written by `fits_write_tblbytes()`
+ * @details
+ * This is the inverse of `decodeField()`, including the `TZEROn` offset of the value type.
+ * Values are first copied and byteswapped in a contiguous buffer, and then copied to the rows.
+ * Other fields of the block are left untouched, such that independent fields can be encoded concurrently.
+ */
+template <typename T>
+void encodeField(
+    const T* source,
+    long rowCount,
+    long rowWidth,
+    long byteOffset,
+    long repeatCount,
+    unsigned char* block);
+
+/**
+ * @brief String overload, which throws because strings cannot be encoded as raw bytes.
+ */
+void encodeField(
+    const std::string* source,
+    long rowCount,
+    long rowWidth,
+    long byteOffset,
+    long repeatCount,
+    unsigned char* block);
+
+/**
+ * @brief Copy the bit (`X`) field of each row of a block of raw rows into a packed bitset.
+ * @param block The raw rows, as read by `fits_read_tblbytes()`
+ * @param rowCount The number of rows
+ * @param rowWidth The number of bytes per row, i.e. `NAXIS1`
+ * @param byteOffset The position of the field in each row, in bytes
+ * @param repeatCount The number of bits in the field
+ * @param bits The output bitset, where the first bit is the most significant bit of the first byte
+ * @param firstBit The position in the bitset of the first bit of the first row
+ * @details
+ * In the file, each field is padded to a whole number of bytes, while rows are contiguous in the bitset.
+ * Bits are copied byte by byte, with shifts if the rows are not aligned to bytes in the bitset.
+ * Other bits of the bitset are left untouched.
+ */
+void decodeBitField(
+    const unsigned char* block,
+    long rowCount,
+    long rowWidth,
+    long byteOffset,
+    long repeatCount,
+    unsigned char* bits,
+    long firstBit);
+
+/**
+ * @brief Write a packed bitset as the bit (`X`) field of each row of a block of raw rows.
+ * @details
+ * This is the inverse of `decodeBitField()`. The padding bits of the fields are set to 0.
+ */
+void encodeBitField(
+    const unsigned char* bits,
+    long firstBit,
+    long rowCount,
+    long rowWidth,
+    long byteOffset,
+    long repeatCount,
+    unsigned char* block);
+
+/**
+ * @brief Pack the logical (`L`) field of each row of a block of raw rows into a bitset.
+ * @copydetails decodeBitField()
+ * Values are `true` if stored as `T`, and `false` if stored as `F` or null.
+ */
+void decodeLogicalField(
+    const unsigned char* block,
+    long rowCount,
+    long rowWidth,
+    long byteOffset,
+    long repeatCount,
+    unsigned char* bits,
+    long firstBit);
+
+/**
+ * @brief Write a packed bitset as the logical (`L`) field of each row of a block of raw rows.
+ * @details
+ * This is the inverse of `decodeLogicalField()`: values are stored as `T` or `F`.
+ */
+void encodeLogicalField(
+    const unsigned char* bits,
+    long firstBit,
+    long rowCount,
+    long rowWidth,
+    long byteOffset,
+    long repeatCount,
+    unsigned char* block);
+
+} // namespace Cfitsio
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELECFITSIOWRAPPER_BYTESWAP_IMPL
+#include "EleCfitsioWrapper/impl/ByteSwap.hpp"
+#undef _ELECFITSIOWRAPPER_BYTESWAP_IMPL
+/// @endcond
+
+#endif
@@ -42,6 +42,22 @@ namespace Cfitsio {
  */
 std::unique_ptr<char[]> toCharPtr(const std::string& str);
 
+/**
+ * @brief Cast away the constness of an input data array.
+ * @details
+ * CFitsIO functions which write data (e.g. `fits_write_col()` or `fits_write_img()`)
+ * take their input array as a `void *` although they only read it.
+ * Instead of copying the whole array into a temporary non-const buffer,
+ * which doubles the memory footprint and costs a full copy per write operation, do:
+ * \code
+ * fits_write_img(fptr, TypeCode<T>::forImage(), 1, raster.size(), nonconstData(raster.data()), &status);
+ * \endcode
+ * @warning
+ * The returned pointer must only be passed to CFitsIO functions which do not modify the data.
+ */
+template <typename T>
+T* nonconstData(const T* data);
+
 /**
  * @brief A helper structure to safely convert `vector<string>` to `char **`.
  * @details
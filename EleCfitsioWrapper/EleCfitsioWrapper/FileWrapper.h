@@ -70,11 +70,24 @@ void close(fitsfile*& fptr);
  */
 void closeAndDelete(fitsfile*& fptr);
 
+/**
+ * @brief Write the buffers of a Fits file to disk, if it is open with write permission.
+ */
+void flush(fitsfile* fptr);
+
 /**
  * @brief Get the file name.
  */
 std::string name(fitsfile* fptr);
 
+/**
+ * @brief Check whether a Fits file is a plain disk file, which can be read directly at the HDU offsets.
+ * @details
+ * This is false, e.g., for gzipped files, in-memory files, or files filtered with the extended file name syntax,
+ * which CFitsIO decompresses or copies in memory at opening.
+ */
+bool isDiskFile(fitsfile* fptr);
+
 /**
  * @brief Check whether a Fits file is open with write permission.
  */
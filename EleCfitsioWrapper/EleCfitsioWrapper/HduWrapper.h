@@ -59,6 +59,11 @@ long count(fitsfile* fptr);
  */
 long currentIndex(fitsfile* fptr);
 
+/**
+ * @brief Get the position of the data unit of the current HDU in the file, in bytes.
+ */
+long currentDataOffset(fitsfile* fptr);
+
 /**
  * @brief Get the name of the current HDU.
  */
@@ -144,12 +149,42 @@ void createImageExtension(fitsfile* fptr, const std::string& name, const Fits::P
 template <typename T, long n = 2>
 void createImageExtension(fitsfile* fptr, const std::string& name, const Fits::Raster<T, n>& raster);
 
+/**
+ * @brief Create a new tile-compressed image HDU with given name, pixel type and shape.
+ */
+template <typename T, long n = 2>
+void createImageExtension(
+    fitsfile* fptr,
+    const std::string& name,
+    const Fits::Position<n>& shape,
+    const Fits::ImageCompression& compression);
+
+/**
+ * @brief Write a Raster in a new tile-compressed image HDU.
+ */
+template <typename T, long n = 2>
+void createImageExtension(
+    fitsfile* fptr,
+    const std::string& name,
+    const Fits::Raster<T, n>& raster,
+    const Fits::ImageCompression& compression);
+
 /**
  * @brief Create a new binary table HDU with given name and column infos.
  */
 template <typename... Ts>
 void createBintableExtension(fitsfile* fptr, const std::string& name, const Fits::ColumnInfo<Ts>&... infos);
 
+/**
+ * @brief Create a new binary table HDU with given name and column names, formats and units.
+ */
+void createBintableExtension(
+    fitsfile* fptr,
+    const std::string& name,
+    const std::vector<std::string>& names,
+    const std::vector<std::string>& tforms,
+    const std::vector<std::string>& units);
+
 /**
  * @brief Create a new binary table HDU with given name and columns.
  */
@@ -20,9 +20,11 @@
 #ifndef _ELECFITSIOWRAPPER_IMAGEWRAPPER_H
 #define _ELECFITSIOWRAPPER_IMAGEWRAPPER_H
 
+#include "EleCfitsioWrapper/CfitsioUtils.h"
 #include "EleCfitsioWrapper/ErrorWrapper.h"
 #include "EleCfitsioWrapper/FileWrapper.h"
 #include "EleCfitsioWrapper/TypeWrapper.h"
+#include "EleFitsData/ImageCompression.h"
 #include "EleFitsData/Raster.h"
 
 #include <fitsio.h>
@@ -48,6 +50,35 @@ const std::type_info& readTypeid(fitsfile* fptr);
 template <long n = 2>
 Fits::Position<n> readShape(fitsfile* fptr);
 
+/**
+ * @brief Check whether the current image HDU is tile-compressed.
+ * @details
+ * Compressed images are read and written transparently by CFitsIO, but their data unit is a binary table.
+ */
+bool isCompressed(fitsfile* fptr);
+
+/**
+ * @brief Compress the next image HDUs to be created with given parameters.
+ * @details
+ * The parameters apply to all the image extensions created with `fptr` until `resetCompression()` is called.
+ */
+void setCompression(fitsfile* fptr, const Fits::ImageCompression& compression);
+
+/**
+ * @brief Do not compress the next image HDUs to be created.
+ */
+void resetCompression(fitsfile* fptr);
+
+/**
+ * @brief Check whether the raw values of the image can be decoded as values of given type.
+ * @details
+ * This is the case if `BITPIX` matches the type, the image is not compressed,
+ * and it is neither scaled nor offset (except for the standard offsets of unsigned integers).
+ * @see decodeField()
+ */
+template <typename T>
+bool isRawDecodable(fitsfile* fptr);
+
 /**
  * @brief Reshape the current image HDU.
  */
@@ -78,13 +109,43 @@ void readRasterTo(fitsfile* fptr, Fits::Subraster<T, n>& destination);
 template <typename T, long m, long n>
 Fits::VecRaster<T, m> readRegion(fitsfile* fptr, const Fits::Region<n>& region);
 
+/**
+ * @brief Read every `step[i]`-th pixel along each axis `i` of a region of the current image HDU.
+ * @details
+ * The decimated raster shape is `(region.shape() + step - 1) / step`, and its first pixel is `region.front`.
+ * Steps must be positive.
+ * The increments are applied by CFitsIO.
+ */
+template <typename T, long m, long n>
+Fits::VecRaster<T, m> readRegion(fitsfile* fptr, const Fits::Region<n>& region, const Fits::Position<n>& step);
+
+/**
+ * @brief Read a region of the current image HDU binned by blocks of pixels.
+ * @tparam T The type of the binned pixels, which may differ from the image type, e.g. to sum small integers
+ * @param binShape The shape of the blocks, which must be positive
+ * @param aggregation The operation which reduces each block to a pixel
+ * @details
+ * The binned raster shape is `(region.shape() + binShape - 1) / binShape`,
+ * such that blocks on the upper edges of the region may be smaller (their mean is computed accordingly).
+ * Pixels are aggregated as `double`s, and the results are saturated to the range of `T`.
+ * The lines are reduced as they are read, by spans of bounded size:
+ * the memory footprint is that of the binned raster, plus one accumulator per binned pixel.
+ */
+template <typename T, long m, long n>
+Fits::VecRaster<T, m> readRegion(
+    fitsfile* fptr,
+    const Fits::Region<n>& region,
+    const Fits::Position<n>& binShape,
+    Fits::Aggregation aggregation);
+
 /**
  * @brief Read a region of the current image HDU into a pre-existing raster.
  * @param region The source region
  * @param destination The destination raster
  * @details
- * Similarly to a blit operation, this method reads the data line-by-line
- * directly in a destination raster.
+ * Similarly to a blit operation, this method reads the data directly in a destination raster.
+ * Lines are merged into the largest contiguous spans of the file,
+ * and nearby spans are read together through a scratch buffer.
  */
 template <typename T, long m, long n>
 void readRegionTo(fitsfile* fptr, const Fits::Region<n>& region, Fits::Raster<T, m>& destination);
@@ -94,12 +155,25 @@ void readRegionTo(fitsfile* fptr, const Fits::Region<n>& region, Fits::Raster<T,
  * @param region The source region
  * @param destination The destination subraster
  * @details
- * Similarly to a blit operation, this method reads the data line-by-line
- * directly in a destination subraster.
+ * Similarly to a blit operation, this method reads the data in a destination subraster.
+ * Lines are merged into the largest contiguous spans of the file,
+ * and nearby spans are read together through a scratch buffer, which is then scattered line by line.
  */
 template <typename T, long m, long n>
 void readRegionTo(fitsfile* fptr, const Fits::Region<n>& region, Fits::Subraster<T, m>& destination);
 
+/**
+ * @brief Read a list of regions of the current image HDU.
+ * @param regions The source regions, in any order, possibly overlapping
+ * @return The rasters, in the order of the regions
+ * @details
+ * The lines of all the regions are sorted by position in the file,
+ * and those which overlap or are separated by less than one FITS block are read with a single call to CFitsIO,
+ * through a scratch buffer, from which they are distributed to the rasters.
+ */
+template <typename T, long m, long n>
+std::vector<Fits::VecRaster<T, m>> readRegions(fitsfile* fptr, const std::vector<Fits::Region<n>>& regions);
+
 /**
  * @brief Write a whole raster in the current image HDU.
  */
@@ -110,6 +184,8 @@ void writeRaster(fitsfile* fptr, const Fits::Raster<T, n>& raster);
  * @brief Write a whole raster into a region of the current image HDU.
  * @param raster The raster to be written
  * @param destination The destination position (size is deduced from raster size)
+ * @details
+ * Lines which are contiguous in the file are written together.
  */
 template <typename T, long m, long n>
 void writeRegion(fitsfile* fptr, const Fits::Raster<T, m>& raster, const Fits::Position<n>& destination);
@@ -118,9 +194,11 @@ void writeRegion(fitsfile* fptr, const Fits::Raster<T, m>& raster, const Fits::P
  * @brief Write a subraster into a region of the current image HDU.
  * @param subraster The subraster to be written
  * @param destination The destination position (size is deduced from subraster size)
+ * @details
+ * Lines which are contiguous in the file are gathered into a scratch buffer and written together.
  */
 template <typename T, long m, long n>
-void writeRegion(fitsfile* fptr, const Fits::Subraster<T, n>& subraster, const Fits::Position<n>& destination);
+void writeRegion(fitsfile* fptr, const Fits::Subraster<T, m>& subraster, const Fits::Position<n>& destination);
 
 } // namespace ImageIo
 } // namespace Cfitsio
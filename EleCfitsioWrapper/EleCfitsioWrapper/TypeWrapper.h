@@ -54,6 +54,13 @@ struct TypeCode {
    */
   inline static std::string tform(long repeatCount);
 
+  /**
+   * @brief Get the TFORM value to handle variable-length array columns, e.g. `1PE`.
+   * @details
+   * The maximum array length, e.g. `(100)`, is omitted: CFitsIO appends it when closing the HDU.
+   */
+  inline static std::string tformVla();
+
   /**
    * @brief Get the type code for an image.
    */
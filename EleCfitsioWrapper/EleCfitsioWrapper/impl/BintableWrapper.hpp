@@ -20,11 +20,13 @@
 #if defined(_ELECFITSIOWRAPPER_BINTABLEWRAPPER_IMPL) || defined(CHECK_QUALITY)
 
   #include "EleCfitsioWrapper/BintableWrapper.h"
+  #include "EleCfitsioWrapper/ByteSwap.h"
   #include "EleCfitsioWrapper/ErrorWrapper.h"
   #include "EleFitsData/FitsError.h"
   #include "ElementsKernel/Unused.h"
 
   #include <algorithm> // transform
+  #include <numeric> // iota
 
 namespace Euclid {
 namespace Cfitsio {
@@ -110,15 +112,19 @@ void writeColumnChunkImpl<std::string>(
 
 template <typename T>
 void writeColumnChunkImpl(fitsfile* fptr, long index, const Fits::Column<T>& column, long firstRow, long rowCount) {
-  /* Allocate vector */
   const auto clipedRowCount = std::min(rowCount, column.rowCount() - firstRow + 1);
   const auto begin = column.data() + (firstRow - 1) * column.info().repeatCount;
   const auto size = clipedRowCount * column.info().repeatCount;
-  const auto end = begin + size;
-  std::vector<std::decay_t<T>> vec(begin, end);
-  /* Write data */
   int status = 0;
-  fits_write_col(fptr, TypeCode<T>::forBintable(), static_cast<int>(index), firstRow, 1, size, vec.data(), &status);
+  fits_write_col(
+      fptr,
+      TypeCode<T>::forBintable(),
+      static_cast<int>(index),
+      firstRow,
+      1,
+      size,
+      nonconstData(begin),
+      &status);
   CfitsioError::mayThrow(
       status,
       fptr,
@@ -219,6 +225,31 @@ struct ColumnLooperImpl<std::size_t(-1), Ts...> {
       ELEMENTS_UNUSED long rowCount) {}
 };
 
+/**
+ * @brief The largest gap between two entries of the heap which are read together, in bytes.
+ * @details
+ * This is one FITS block: reading it is cheaper than seeking.
+ */
+constexpr long maxHeapGap = 2880;
+
+/**
+ * @brief The largest block of the heap which is read at once, in bytes, unless a single entry is larger.
+ */
+constexpr long maxHeapBlock = 1 << 20;
+
+/**
+ * @brief Check whether the values of a variable-length array column can be decoded from raw bytes as `T`.
+ */
+template <typename T>
+bool isVlaRawDecodable(fitsfile* fptr, long index, char letter) {
+  double scale = 1.;
+  double zero = 0.;
+  int status = 0;
+  fits_get_bcolparms(fptr, index, nullptr, nullptr, nullptr, nullptr, &scale, &zero, nullptr, nullptr, &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot read column info: #" + std::to_string(index - 1));
+  return letter != 0 && letter == FitsEncoding<T>::letter() && scale == 1. && zero == FitsEncoding<T>::zero();
+}
+
 } // namespace Internal
 /// @endcond
 
@@ -241,7 +272,7 @@ Fits::ColumnInfo<T> readColumnInfo(fitsfile* fptr, long index) {
       nullptr, // tdisp
       &status);
   CfitsioError::mayThrow(status, fptr, "Cannot read column info: #" + std::to_string(index - 1));
-  return { name, unit, repeatCount };
+  return { name, unit, repeatCount, readColumnShape(fptr, index) };
 }
 
 template <typename T>
@@ -281,6 +312,94 @@ void readColumnSegment(fitsfile* fptr, const Fits::Segment& rows, long index, Fi
   CfitsioError::mayThrow(status, fptr, "Cannot read column data: #" + std::to_string(index - 1));
 }
 
+template <typename T>
+void readColumnElements(fitsfile* fptr, long row, long index, long firstElement, long elementCount, T* destination) {
+  int status = 0;
+  fits_read_col(
+      fptr,
+      TypeCode<T>::forBintable(),
+      static_cast<int>(index),
+      row,
+      firstElement,
+      elementCount,
+      nullptr,
+      destination,
+      nullptr,
+      &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot read column elements: #" + std::to_string(index - 1));
+}
+
+template <typename T>
+void readColumnSegment(fitsfile* fptr, const Fits::Segment& rows, long index, Fits::VlaColumn<T>& column) {
+
+  /* Read the descriptors and allocate the entries */
+  std::vector<long> sizes;
+  std::vector<long> heapOffsets;
+  readDescriptors(fptr, rows, index, sizes, heapOffsets);
+  const long rowCount = sizes.size();
+  const long front = column.rowCount();
+  column.reserve(front + rowCount, column.elementCount() + std::accumulate(sizes.begin(), sizes.end(), 0L));
+  for (auto s : sizes) {
+    column.append(s);
+  }
+
+  /* Let CFitsIO convert the values entry by entry if needed */
+  if (not Internal::isVlaRawDecodable<T>(fptr, index, vlaLetter(fptr, index))) {
+    int status = 0;
+    for (long i = 0; i < rowCount; ++i) {
+      if (sizes[i] > 0) {
+        fits_read_col(
+            fptr,
+            TypeCode<T>::forBintable(),
+            static_cast<int>(index),
+            rows.front + i,
+            1,
+            sizes[i],
+            nullptr,
+            column.entry(front + i),
+            nullptr,
+            &status);
+      }
+    }
+    CfitsioError::mayThrow(status, fptr, "Cannot read column data: #" + std::to_string(index - 1));
+    return;
+  }
+
+  /* Walk the heap in offset order and merge nearby entries */
+  constexpr long valueSize = sizeof(T);
+  std::vector<long> order(rowCount);
+  std::iota(order.begin(), order.end(), 0L);
+  std::stable_sort(order.begin(), order.end(), [&](long lhs, long rhs) {
+    return heapOffsets[lhs] < heapOffsets[rhs];
+  });
+  std::vector<unsigned char> block;
+  long i = 0;
+  while (i < rowCount) {
+    if (sizes[order[i]] == 0) {
+      ++i;
+      continue;
+    }
+    const long blockFront = heapOffsets[order[i]];
+    long blockEnd = blockFront + sizes[order[i]] * valueSize;
+    long j = i + 1;
+    for (; j < rowCount; ++j) {
+      const auto r = order[j];
+      const long end = std::max(blockEnd, heapOffsets[r] + sizes[r] * valueSize);
+      if (heapOffsets[r] > blockEnd + Internal::maxHeapGap || end - blockFront > Internal::maxHeapBlock) {
+        break;
+      }
+      blockEnd = end;
+    }
+    block.resize(blockEnd - blockFront);
+    readHeapBytes(fptr, blockFront, block.size(), block.data());
+    for (; i < j; ++i) {
+      const auto r = order[i];
+      const auto* entry = block.data() + heapOffsets[r] - blockFront;
+      decodeField(entry, 1, sizes[r] * valueSize, 0, sizes[r], column.entry(front + r));
+    }
+  }
+}
+
 template <typename T>
 Fits::VecColumn<T> readColumn(fitsfile* fptr, const std::string& name) {
   return readColumn<T>(fptr, columnIndex(fptr, name));
@@ -295,9 +414,6 @@ void writeColumn<std::string>(fitsfile* fptr, const Fits::Column<std::string>& c
 template <typename T>
 void writeColumn(fitsfile* fptr, const Fits::Column<T>& column) {
   long index = columnIndex(fptr, column.info().name);
-  const auto begin = column.data();
-  const auto end = begin + column.elementCount();
-  std::vector<std::decay_t<T>> nonconstData(begin, end); // We need a non-const data for CFitsIO
   int status = 0;
   fits_write_col(
       fptr,
@@ -306,7 +422,7 @@ void writeColumn(fitsfile* fptr, const Fits::Column<T>& column) {
       1, // firstrow (1-based)
       1, // firstelem (1-based)
       column.elementCount(), // nelements
-      nonconstData.data(),
+      nonconstData(column.data()),
       &status);
   CfitsioError::mayThrow(status, fptr, "Cannot write column data: " + column.info().name);
 }
@@ -315,20 +431,24 @@ void writeColumn(fitsfile* fptr, const Fits::Column<T>& column) {
  * @brief String specialization.
  */
 template <>
-void writeColumnSegment<std::string>(fitsfile* fptr, long firstRow, const Fits::Column<std::string>& column);
+void writeColumnSegment<std::string>(
+    fitsfile* fptr,
+    long firstRow,
+    long index,
+    const Fits::Column<std::string>& column);
 
 /**
  * @brief Const string specialization.
  */
 template <>
-void writeColumnSegment<const std::string>(fitsfile* fptr, long firstRow, const Fits::Column<const std::string>& column);
+void writeColumnSegment<const std::string>(
+    fitsfile* fptr,
+    long firstRow,
+    long index,
+    const Fits::Column<const std::string>& column);
 
 template <typename T>
-void writeColumnSegment(fitsfile* fptr, long firstRow, const Fits::Column<T>& column) {
-  long index = columnIndex(fptr, column.info().name);
-  const auto begin = column.data();
-  const auto end = begin + column.elementCount();
-  std::vector<std::decay_t<T>> nonconstData(begin, end); // We need a non-const data for CFitsIO
+void writeColumnSegment(fitsfile* fptr, long firstRow, long index, const Fits::Column<T>& column) {
   int status = 0;
   fits_write_col(
       fptr,
@@ -337,11 +457,86 @@ void writeColumnSegment(fitsfile* fptr, long firstRow, const Fits::Column<T>& co
       firstRow, // firstrow (1-based)
       1, // firstelem (1-based)
       column.elementCount(), // nelements
-      nonconstData.data(),
+      nonconstData(column.data()),
       &status);
   CfitsioError::mayThrow(status, fptr, "Cannot write column data: " + column.info().name);
 }
 
+template <typename T>
+void writeColumnSegment(
+    fitsfile* fptr,
+    long firstRow,
+    long index,
+    const Fits::VlaColumn<T>& column,
+    const Fits::Segment& rows) {
+
+  /* Extend the table such that all the descriptors exist */
+  const long lastRow = firstRow + rows.size() - 1;
+  const long initialRowCount = rowCount(fptr);
+  int status = 0;
+  if (lastRow > initialRowCount) {
+    fits_insert_rows(fptr, initialRowCount, lastRow - initialRowCount, &status);
+    CfitsioError::mayThrow(status, fptr, "Cannot extend table to write column: " + column.info().name);
+  }
+
+  /* Write the bits entry by entry, because they are packed */
+  const auto& offsets = column.offsets();
+  const long valueCount = offsets[rows.back + 1] - offsets[rows.front];
+  const char letter = vlaLetter(fptr, index);
+  if (letter == 'X') {
+    for (long i = 0; i < rows.size(); ++i) {
+      const auto row = rows.front + i;
+      fits_write_col(
+          fptr,
+          TypeCode<T>::forBintable(),
+          static_cast<int>(index),
+          firstRow + i,
+          1,
+          column.entrySize(row),
+          nonconstData(column.entry(row)),
+          &status);
+    }
+    CfitsioError::mayThrow(status, fptr, "Cannot write column data: " + column.info().name);
+    return;
+  }
+
+  /* Append all the values to the heap at once, as the entry of the first row */
+  LONGLONG heapOffset = 0;
+  if (valueCount > 0) {
+    LONGLONG length = 0;
+    fits_write_col(
+        fptr,
+        TypeCode<T>::forBintable(),
+        static_cast<int>(index),
+        firstRow,
+        1,
+        valueCount,
+        nonconstData(column.entry(rows.front)),
+        &status);
+    fits_read_descriptll(fptr, static_cast<int>(index), firstRow, &length, &heapOffset, &status);
+    CfitsioError::mayThrow(status, fptr, "Cannot write column data: " + column.info().name);
+  }
+
+  /* Point the descriptors to the entries */
+  const long valueSize = fieldByteCount(std::string("1") + letter);
+  for (long i = 0; i < rows.size(); ++i) {
+    const auto row = rows.front + i;
+    fits_write_descript(
+        fptr,
+        static_cast<int>(index),
+        firstRow + i,
+        column.entrySize(row),
+        heapOffset + (offsets[row] - offsets[rows.front]) * valueSize,
+        &status);
+  }
+  CfitsioError::mayThrow(status, fptr, "Cannot write descriptors of column: " + column.info().name);
+}
+
+template <typename T>
+void writeColumnSegment(fitsfile* fptr, long firstRow, const Fits::Column<T>& column) {
+  writeColumnSegment(fptr, firstRow, columnIndex(fptr, column.info().name), column);
+}
+
 template <typename... Ts>
 std::tuple<Fits::VecColumn<Ts>...> readColumns(fitsfile* fptr, const std::vector<long>& indices) {
   /* Read column metadata */
@@ -406,6 +601,8 @@ void insertColumn(fitsfile* fptr, long index, const Fits::Column<T>& column) {
   // FIXME write unit
   int status = 0;
   fits_insert_col(fptr, static_cast<int>(index), name.get(), tform.get(), &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot insert column: " + column.info().name);
+  updateColumnShape(fptr, index, column.info().shape);
   writeColumn(fptr, column);
 }
 
@@ -416,6 +613,10 @@ void insertColumns(fitsfile* fptr, long index, const Fits::Column<Ts>&... column
   // FIXME write unit
   int status = 0;
   fits_insert_cols(fptr, static_cast<int>(index), sizeof...(Ts), names.data(), tforms.data(), &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot insert columns");
+  long shapeIndex = index;
+  using mockUnpack = int[];
+  (void)mockUnpack { 0, (updateColumnShape(fptr, shapeIndex++, columns.info().shape), 0)... };
   writeColumns(fptr, columns...);
 }
 
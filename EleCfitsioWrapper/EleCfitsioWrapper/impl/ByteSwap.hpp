@@ -0,0 +1,232 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#if defined(_ELECFITSIOWRAPPER_BYTESWAP_IMPL) || defined(CHECK_QUALITY)
+
+  #include "EleCfitsioWrapper/ByteSwap.h"
+
+  #include <cstring>
+  #include <type_traits>
+  #include <vector>
+
+namespace Euclid {
+namespace Cfitsio {
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief Swap the bytes of values of given size.
+ * @details
+ * Values are accessed through `std::memcpy` to comply with strict aliasing,
+ * which the compiler optimizes out.
+ */
+template <std::size_t size>
+struct ByteSwapper;
+
+/**
+ * @brief Single bytes are left untouched.
+ */
+template <>
+struct ByteSwapper<1> {
+  static void swap(unsigned char*, long) {}
+};
+
+template <>
+struct ByteSwapper<2> {
+  static void swap(unsigned char* data, long count) {
+    std::uint16_t v;
+    for (long i = 0; i < count; ++i, data += 2) {
+      std::memcpy(&v, data, 2);
+      v = static_cast<std::uint16_t>((v >> 8) | (v << 8));
+      std::memcpy(data, &v, 2);
+    }
+  }
+};
+
+template <>
+struct ByteSwapper<4> {
+  static void swap(unsigned char* data, long count) {
+    std::uint32_t v;
+    for (long i = 0; i < count; ++i, data += 4) {
+      std::memcpy(&v, data, 4);
+      v = ((v & 0x000000FFU) << 24) | ((v & 0x0000FF00U) << 8) | ((v & 0x00FF0000U) >> 8) |
+          ((v & 0xFF000000U) >> 24);
+      std::memcpy(data, &v, 4);
+    }
+  }
+};
+
+template <>
+struct ByteSwapper<8> {
+  static void swap(unsigned char* data, long count) {
+    std::uint64_t v;
+    for (long i = 0; i < count; ++i, data += 8) {
+      std::memcpy(&v, data, 8);
+      v = ((v & 0x00000000000000FFULL) << 56) | ((v & 0x000000000000FF00ULL) << 40) |
+          ((v & 0x0000000000FF0000ULL) << 24) | ((v & 0x00000000FF000000ULL) << 8) |
+          ((v & 0x000000FF00000000ULL) >> 8) | ((v & 0x0000FF0000000000ULL) >> 24) |
+          ((v & 0x00FF000000000000ULL) >> 40) | ((v & 0xFF00000000000000ULL) >> 56);
+      std::memcpy(data, &v, 8);
+    }
+  }
+};
+
+/**
+ * @brief Swap bytes unless the machine is big-endian.
+ */
+template <std::size_t size>
+void swapBytes(unsigned char* data, long count) {
+  #if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+  (void)data;
+  (void)count;
+  #else
+  ByteSwapper<size>::swap(data, count);
+  #endif
+}
+
+/**
+ * @brief Apply the `TZEROn` offset of integers.
+ */
+template <typename T>
+void applyZero(T* data, long count, std::true_type) {
+  if (FitsEncoding<T>::zero() != 0.) {
+    toggleSignBit(data, count);
+  }
+}
+
+/**
+ * @brief Non-integer types have no offset.
+ */
+template <typename T>
+void applyZero(T*, long, std::false_type) {}
+
+} // namespace Internal
+/// @endcond
+
+  #ifndef DEF_FITS_ENCODING
+    #define DEF_FITS_ENCODING(type, code, offset) \
+      template <> \
+      inline char FitsEncoding<type>::letter() { \
+        return code; \
+      } \
+      template <> \
+      inline double FitsEncoding<type>::zero() { \
+        return offset; \
+      }
+DEF_FITS_ENCODING(signed char, 'B', -128.)
+DEF_FITS_ENCODING(char, 'B', -128.) // Like TypeCode<char>, whatever the signedness of plain char
+DEF_FITS_ENCODING(std::int16_t, 'I', 0.)
+DEF_FITS_ENCODING(std::int32_t, 'J', 0.)
+DEF_FITS_ENCODING(std::int64_t, 'K', 0.)
+DEF_FITS_ENCODING(float, 'E', 0.)
+DEF_FITS_ENCODING(double, 'D', 0.)
+DEF_FITS_ENCODING(std::complex<float>, 'C', 0.)
+DEF_FITS_ENCODING(std::complex<double>, 'M', 0.)
+DEF_FITS_ENCODING(unsigned char, 'B', 0.)
+DEF_FITS_ENCODING(std::uint16_t, 'I', 32768.)
+DEF_FITS_ENCODING(std::uint32_t, 'J', 2147483648.)
+DEF_FITS_ENCODING(std::uint64_t, 'K', 9223372036854775808.)
+    #undef DEF_FITS_ENCODING
+  #endif
+
+template <typename T>
+inline char FitsEncoding<T>::letter() {
+  return 0;
+}
+
+template <typename T>
+inline double FitsEncoding<T>::zero() {
+  return 0.;
+}
+
+template <typename T>
+void bigEndianToNative(T* data, long count) {
+  Internal::swapBytes<sizeof(T)>(reinterpret_cast<unsigned char*>(data), count);
+}
+
+template <typename T>
+void bigEndianToNative(std::complex<T>* data, long count) {
+  Internal::swapBytes<sizeof(T)>(reinterpret_cast<unsigned char*>(data), count * 2);
+}
+
+template <typename T>
+void toggleSignBit(T* data, long count) {
+  using U = std::make_unsigned_t<T>;
+  constexpr U mask = static_cast<U>(U(1) << (sizeof(T) * 8 - 1));
+  auto* it = reinterpret_cast<U*>(data); // Signed and unsigned variants can alias each other
+  for (long i = 0; i < count; ++i) {
+    it[i] ^= mask;
+  }
+}
+
+template <typename T>
+void scatterField(
+    const unsigned char* block,
+    long rowCount,
+    long rowWidth,
+    long byteOffset,
+    long repeatCount,
+    T* destination) {
+  const long fieldWidth = repeatCount * sizeof(T);
+  const unsigned char* in = block + byteOffset;
+  auto* out = reinterpret_cast<unsigned char*>(destination);
+  for (long row = 0; row < rowCount; ++row, in += rowWidth, out += fieldWidth) {
+    std::memcpy(out, in, fieldWidth);
+  }
+  bigEndianToNative(destination, rowCount * repeatCount);
+}
+
+template <typename T>
+void decodeField(
+    const unsigned char* block,
+    long rowCount,
+    long rowWidth,
+    long byteOffset,
+    long repeatCount,
+    T* destination) {
+  scatterField(block, rowCount, rowWidth, byteOffset, repeatCount, destination);
+  Internal::applyZero(destination, rowCount * repeatCount, std::is_integral<T>());
+}
+
+template <typename T>
+void encodeField(
+    const T* source,
+    long rowCount,
+    long rowWidth,
+    long byteOffset,
+    long repeatCount,
+    unsigned char* block) {
+  using Value = std::decay_t<T>;
+  const long count = rowCount * repeatCount;
+  std::vector<Value> buffer(source, source + count);
+  Internal::applyZero(buffer.data(), count, std::is_integral<Value>());
+  bigEndianToNative(buffer.data(), count); // Swapping is symmetric
+  const long fieldWidth = repeatCount * sizeof(Value);
+  const auto* in = reinterpret_cast<const unsigned char*>(buffer.data());
+  unsigned char* out = block + byteOffset;
+  for (long row = 0; row < rowCount; ++row, in += fieldWidth, out += rowWidth) {
+    std::memcpy(out, in, fieldWidth);
+  }
+}
+
+} // namespace Cfitsio
+} // namespace Euclid
+
+#endif
@@ -42,6 +42,11 @@ CStrArray::CStrArray(const T begin, const T end) : smartPtrVector(end - begin),
   });
 }
 
+template <typename T>
+T* nonconstData(const T* data) {
+  return const_cast<T*>(data);
+}
+
 } // namespace Cfitsio
 } // namespace Euclid
 
@@ -44,6 +44,32 @@ void createImageExtension(fitsfile* fptr, const std::string& name, const Fits::R
   ImageIo::writeRaster<T, n>(fptr, raster);
 }
 
+template <typename T, long n>
+void createImageExtension(
+    fitsfile* fptr,
+    const std::string& name,
+    const Fits::Position<n>& shape,
+    const Fits::ImageCompression& compression) {
+  try {
+    ImageIo::setCompression(fptr, compression);
+    createImageExtension<T, n>(fptr, name, shape);
+  } catch (...) {
+    ImageIo::resetCompression(fptr);
+    throw;
+  }
+  ImageIo::resetCompression(fptr); // Next HDUs are not compressed
+}
+
+template <typename T, long n>
+void createImageExtension(
+    fitsfile* fptr,
+    const std::string& name,
+    const Fits::Raster<T, n>& raster,
+    const Fits::ImageCompression& compression) {
+  createImageExtension<T, n>(fptr, name, raster.shape(), compression);
+  ImageIo::writeRaster<T, n>(fptr, raster);
+}
+
 template <typename... Ts>
 void createBintableExtension(fitsfile* fptr, const std::string& name, const Fits::ColumnInfo<Ts>&... infos) {
   constexpr long ncols = sizeof...(Ts);
@@ -53,6 +79,9 @@ void createBintableExtension(fitsfile* fptr, const std::string& name, const Fits
   int status = 0;
   fits_create_tbl(fptr, BINARY_TBL, 0, ncols, colName.data(), colFormat.data(), colUnit.data(), name.c_str(), &status);
   CfitsioError::mayThrow(status, fptr, "Cannot create binary table extension: " + name);
+  long index = 0;
+  using mockUnpack = int[];
+  (void)mockUnpack { 0, (BintableIo::updateColumnShape(fptr, ++index, infos.shape), 0)... };
 }
 
 template <typename... Ts>
@@ -64,6 +93,9 @@ void createBintableExtension(fitsfile* fptr, const std::string& name, const Fits
   int status = 0;
   fits_create_tbl(fptr, BINARY_TBL, 0, ncols, colName.data(), colFormat.data(), colUnit.data(), name.c_str(), &status);
   CfitsioError::mayThrow(status, fptr, "Cannot create binary table extension: " + name);
+  long index = 0;
+  using mockUnpack = int[];
+  (void)mockUnpack { 0, (BintableIo::updateColumnShape(fptr, ++index, columns.info().shape), 0)... };
   BintableIo::writeColumns(fptr, columns...);
 }
 
@@ -97,6 +129,7 @@ void createBintableExtension(fitsfile* fptr, const std::string& name, const Fits
   int status = 0;
   fits_create_tbl(fptr, BINARY_TBL, 0, columnCount, &cName, &cFormat, &cUnit, name.c_str(), &status);
   CfitsioError::mayThrow(status, fptr, "Cannot create binary table extension: " + name);
+  BintableIo::updateColumnShape(fptr, 1, column.info().shape);
   BintableIo::writeColumn(fptr, column);
 }
 
@@ -19,8 +19,15 @@
 
 #if defined(_ELECFITSIOWRAPPER_IMAGEWRAPPER_IMPL) || defined(CHECK_QUALITY)
 
+  #include "EleCfitsioWrapper/ByteSwap.h"
   #include "EleCfitsioWrapper/ImageWrapper.h"
 
+  #include <algorithm> // copy_n, max
+  #include <cstdlib>
+  #include <limits> // lowest
+  #include <utility> // pair
+  #include <vector>
+
 namespace Euclid {
 namespace Cfitsio {
 namespace ImageIo {
@@ -31,7 +38,7 @@ namespace ImageIo {
 template <>
 Fits::Position<-1> readShape<-1>(fitsfile* fptr);
 
-template <long n = 2>
+template <long n>
 Fits::Position<n> readShape(fitsfile* fptr) {
   Fits::Position<n> shape;
   int status = 0;
@@ -40,6 +47,374 @@ Fits::Position<n> readShape(fitsfile* fptr) {
   return shape;
 }
 
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief Create the region of given front position and shape, padded with ones along the extra axes.
+ */
+template <long m, long n>
+Fits::Region<n> paddedRegion(const Fits::Position<n>& front, const Fits::Position<m>& shape) {
+  Fits::Region<n> region { front, front };
+  for (long i = 0; i < shape.size(); ++i) {
+    region.back[i] += shape[i] - 1;
+  }
+  return region;
+}
+
+/**
+ * @brief Throw if a region does not lie within an image of given shape.
+ * @details
+ * Regions are transferred by flat pixel index, such that a region out of the image bounds
+ * would otherwise silently wrap to the neighboring lines.
+ */
+template <long m, long n>
+void mayThrowOutOfImage(const Fits::Position<m>& shape, const Fits::Region<n>& region) {
+  for (long i = 0; i < region.front.size(); ++i) {
+    const std::pair<long, long> bounds { 0, i < shape.size() ? shape[i] - 1 : 0 };
+    const auto prefix = "Cannot access image region along axis " + std::to_string(i);
+    Fits::OutOfBoundsError::mayThrow(prefix, region.front[i], bounds);
+    Fits::OutOfBoundsError::mayThrow(prefix, region.back[i], bounds);
+  }
+}
+
+/**
+ * @brief Throw if some step of a decimation or binning is not positive.
+ */
+template <long n>
+void mayThrowNonPositiveSteps(const Fits::Position<n>& steps, const Fits::Region<n>& region) {
+  if (steps.size() != region.front.size()) {
+    throw Fits::FitsError("Step dimension does not match region dimension.");
+  }
+  for (long i = 0; i < steps.size(); ++i) {
+    if (steps[i] <= 0) {
+      throw Fits::FitsError("Steps must be positive; axis " + std::to_string(i) + ": " + std::to_string(steps[i]));
+    }
+  }
+}
+
+/**
+ * @brief Cast a value, saturated to the range of the destination type.
+ * @details
+ * Out-of-range conversions from `double` are undefined behavior, e.g. for sums of small integers.
+ */
+template <typename T>
+T saturatedCast(double value) {
+  if (value <= static_cast<double>(std::numeric_limits<T>::lowest())) {
+    return std::numeric_limits<T>::lowest();
+  }
+  if (value >= static_cast<double>(std::numeric_limits<T>::max())) {
+    return std::numeric_limits<T>::max();
+  }
+  return static_cast<T>(value);
+}
+
+/**
+ * @brief Read the shape of the current image HDU, and throw if a region does not lie within the image.
+ */
+template <long n>
+Fits::Position<n> readShapeContaining(fitsfile* fptr, const Fits::Region<n>& region) {
+  const auto shape = readShape<n>(fptr);
+  mayThrowOutOfImage(shape, region);
+  return shape;
+}
+
+/**
+ * @brief Compute the strides of a raster along each axis of a region, in number of pixels.
+ * @details
+ * The axes of the region beyond the raster dimension are considered as contiguous continuations of the raster.
+ */
+template <long m, long n>
+Fits::Position<n> rasterStrides(const Fits::Position<m>& shape, const Fits::Region<n>& region) {
+  auto strides = region.front;
+  long stride = 1;
+  for (long i = 0; i < strides.size(); ++i) {
+    strides[i] = stride;
+    stride *= i < shape.size() ? shape[i] : region.back[i] - region.front[i] + 1;
+  }
+  return strides;
+}
+
+/**
+ * @brief The lines of an image region, grouped into spans which are transferred with a single call to CFitsIO.
+ * @details
+ * Lines are visited in file order.
+ * Consecutive lines are appended to the current span as long as the gap between them is at most `maxGap` pixels,
+ * and the span fits in the scratch buffer, unless it is contiguous both in the file and in memory,
+ * in which case it is transferred directly from or to memory, whatever its size.
+ */
+class RegionSpans {
+
+public:
+  /**
+   * @brief Constructor.
+   * @param lineSize The number of pixels per line
+   * @param maxGap The maximum number of pixels between two lines of a span
+   * @param capacity The maximum number of pixels of the scratch buffer
+   * @param isDirect Whether spans which are contiguous in memory are transferred directly, whatever their size
+   */
+  RegionSpans(long lineSize, long maxGap, long capacity, bool isDirect = true) :
+      m_lineSize(lineSize), m_maxGap(maxGap), m_capacity(std::max(lineSize, capacity)), m_isDirect(isDirect),
+      m_lines(), m_isContiguous(isDirect) {}
+
+  /**
+   * @brief Try to append a line to the current span.
+   * @param fileIndex The index of the first pixel of the line in the file
+   * @param memoryIndex The index of the first pixel of the line in memory
+   * @return False if the span is full and should be transferred before the line is appended.
+   */
+  bool append(long fileIndex, long memoryIndex) {
+    if (not m_lines.empty()) {
+      const auto& last = m_lines.back();
+      const long gap = fileIndex - last.first - m_lineSize;
+      const bool isContiguous = m_isContiguous && gap == 0 && memoryIndex == last.second + m_lineSize;
+      if (gap > m_maxGap || (not isContiguous && fileIndex + m_lineSize - m_lines.front().first > m_capacity)) {
+        return false;
+      }
+      m_isContiguous = isContiguous;
+    }
+    m_lines.emplace_back(fileIndex, memoryIndex);
+    return true;
+  }
+
+  /**
+   * @brief Check whether the span is empty.
+   */
+  bool empty() const {
+    return m_lines.empty();
+  }
+
+  /**
+   * @brief Check whether the span is contiguous both in the file and in memory.
+   */
+  bool isContiguous() const {
+    return m_isContiguous;
+  }
+
+  /**
+   * @brief The index of the first pixel of the span in the file.
+   */
+  long fileFront() const {
+    return m_lines.front().first;
+  }
+
+  /**
+   * @brief The index of the first pixel of the span in memory.
+   */
+  long memoryFront() const {
+    return m_lines.front().second;
+  }
+
+  /**
+   * @brief The number of pixels of the span in the file, including the gaps.
+   */
+  long size() const {
+    return m_lines.back().first + m_lineSize - m_lines.front().first;
+  }
+
+  /**
+   * @brief The file and memory indices of the lines.
+   */
+  const std::vector<std::pair<long, long>>& lines() const {
+    return m_lines;
+  }
+
+  /**
+   * @brief Start a new span.
+   */
+  void clear() {
+    m_lines.clear();
+    m_isContiguous = m_isDirect;
+  }
+
+private:
+  long m_lineSize;
+  long m_maxGap;
+  long m_capacity;
+  bool m_isDirect;
+  std::vector<std::pair<long, long>> m_lines;
+  bool m_isContiguous;
+};
+
+/**
+ * @brief Call a function on each line of a region, with the file and memory indices of its first pixel.
+ */
+template <long n, typename TFunc>
+void regionLinesForeach(
+    const Fits::Region<n>& region,
+    const Fits::Position<n>& fileStrides,
+    const Fits::Position<n>& memoryStrides,
+    TFunc&& func) {
+  auto lines = region;
+  lines.back[0] = lines.front[0];
+  for (const auto& front : lines) {
+    long fileIndex = 0;
+    long memoryIndex = 0;
+    for (long i = 0; i < front.size(); ++i) {
+      fileIndex += front[i] * fileStrides[i];
+      memoryIndex += (front[i] - region.front[i]) * memoryStrides[i];
+    }
+    func(fileIndex, memoryIndex);
+  }
+}
+
+/**
+ * @brief The size of the scratch buffer of region transfers, in bytes.
+ */
+constexpr long regionScratchBytes = 1 << 20;
+
+/**
+ * @brief Read a region into strided memory, by spans of lines.
+ * @param destination The destination of the first pixel of the region
+ * @param strides The destination strides along each axis of the region
+ * @details
+ * Lines which are nearby in the file, i.e. separated by less than one FITS block, are read together,
+ * through a scratch buffer which is reused by all the spans,
+ * and then scattered to the destination line by line.
+ * Spans which are contiguous both in the file and in memory are read directly into the destination.
+ */
+template <typename T, long n>
+void readRegionSpans(fitsfile* fptr, const Fits::Region<n>& region, T* destination, const Fits::Position<n>& strides) {
+  const long lineSize = region.back[0] - region.front[0] + 1;
+  const long pixelBytes = sizeof(T);
+  RegionSpans span(lineSize, 2880 / pixelBytes, regionScratchBytes / pixelBytes);
+  std::vector<T> scratch;
+  int status = 0;
+  const auto transfer = [&]() {
+    if (span.isContiguous()) {
+      auto* data = destination + span.memoryFront();
+      fits_read_img(fptr, TypeCode<T>::forImage(), span.fileFront() + 1, span.size(), nullptr, data, nullptr, &status);
+    } else {
+      scratch.resize(std::max<std::size_t>(scratch.size(), span.size()));
+      auto* data = scratch.data();
+      fits_read_img(fptr, TypeCode<T>::forImage(), span.fileFront() + 1, span.size(), nullptr, data, nullptr, &status);
+      for (const auto& line : span.lines()) {
+        std::copy_n(data + line.first - span.fileFront(), lineSize, destination + line.second);
+      }
+    }
+    CfitsioError::mayThrow(status, fptr, "Cannot read image region.");
+    span.clear();
+  };
+  const auto fileStrides = rasterStrides(readShapeContaining(fptr, region), region);
+  regionLinesForeach(region, fileStrides, strides, [&](long fileIndex, long memoryIndex) {
+    if (not span.append(fileIndex, memoryIndex)) {
+      transfer();
+      span.append(fileIndex, memoryIndex);
+    }
+  });
+  if (not span.empty()) {
+    transfer();
+  }
+}
+
+/**
+ * @brief Read a region by spans of lines, and call a function on each line.
+ * @param func The function, called as `func(index, line)`,
+ * where `index` is the index of the first pixel of the line in the region, as if it was contiguous,
+ * and `line` is a pointer to the pixels of the line
+ * @details
+ * Lines which are nearby in the file are read together, through a scratch buffer which is reused by all the spans,
+ * and whose size is bounded whatever the region size.
+ */
+template <typename T, long n, typename TFunc>
+void readRegionLines(fitsfile* fptr, const Fits::Region<n>& region, TFunc&& func) {
+  const long lineSize = region.back[0] - region.front[0] + 1;
+  const long pixelBytes = sizeof(T);
+  RegionSpans span(lineSize, 2880 / pixelBytes, regionScratchBytes / pixelBytes, false);
+  std::vector<T> scratch;
+  int status = 0;
+  const auto transfer = [&]() {
+    scratch.resize(std::max<std::size_t>(scratch.size(), span.size()));
+    auto* data = scratch.data();
+    fits_read_img(fptr, TypeCode<T>::forImage(), span.fileFront() + 1, span.size(), nullptr, data, nullptr, &status);
+    CfitsioError::mayThrow(status, fptr, "Cannot read image region.");
+    for (const auto& line : span.lines()) {
+      func(line.second, static_cast<const T*>(data + line.first - span.fileFront()));
+    }
+    span.clear();
+  };
+  const auto fileStrides = rasterStrides(readShapeContaining(fptr, region), region);
+  const auto strides = rasterStrides(region.shape(), region);
+  regionLinesForeach(region, fileStrides, strides, [&](long fileIndex, long index) {
+    if (not span.append(fileIndex, index)) {
+      transfer();
+      span.append(fileIndex, index);
+    }
+  });
+  if (not span.empty()) {
+    transfer();
+  }
+}
+
+/**
+ * @brief Write strided memory into a region, by spans of lines.
+ * @param source The source of the first pixel of the region
+ * @param strides The source strides along each axis of the region
+ * @details
+ * Lines which are contiguous in the file are gathered into a scratch buffer which is reused by all the spans,
+ * and written together.
+ * Spans which are contiguous both in the file and in memory are written directly from the source.
+ */
+template <typename T, long n>
+void writeRegionSpans(
+    fitsfile* fptr,
+    const T* source,
+    const Fits::Position<n>& strides,
+    const Fits::Region<n>& region) {
+  mayThrowReadonlyError(fptr);
+  const long lineSize = region.back[0] - region.front[0] + 1;
+  const long pixelBytes = sizeof(T);
+  RegionSpans span(lineSize, 0, regionScratchBytes / pixelBytes);
+  std::vector<std::decay_t<T>> scratch;
+  int status = 0;
+  const auto transfer = [&]() {
+    if (span.isContiguous()) {
+      auto* data = nonconstData(source + span.memoryFront());
+      fits_write_img(fptr, TypeCode<T>::forImage(), span.fileFront() + 1, span.size(), data, &status);
+    } else {
+      scratch.resize(std::max<std::size_t>(scratch.size(), span.size()));
+      for (const auto& line : span.lines()) {
+        std::copy_n(source + line.second, lineSize, scratch.data() + line.first - span.fileFront());
+      }
+      fits_write_img(fptr, TypeCode<T>::forImage(), span.fileFront() + 1, span.size(), scratch.data(), &status);
+    }
+    CfitsioError::mayThrow(status, fptr, "Cannot write image region.");
+    span.clear();
+  };
+  const auto fileStrides = rasterStrides(readShapeContaining(fptr, region), region);
+  regionLinesForeach(region, fileStrides, strides, [&](long fileIndex, long memoryIndex) {
+    if (not span.append(fileIndex, memoryIndex)) {
+      transfer();
+      span.append(fileIndex, memoryIndex);
+    }
+  });
+  if (not span.empty()) {
+    transfer();
+  }
+}
+
+} // namespace Internal
+/// @endcond
+
+template <typename T>
+bool isRawDecodable(fitsfile* fptr) {
+  if (isCompressed(fptr)) {
+    return false;
+  }
+  int status = 0;
+  int bitpix = 0;
+  fits_get_img_type(fptr, &bitpix, &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot read image type.");
+  double scale = 1.;
+  double zero = 0.;
+  int keywordStatus = 0;
+  fits_read_key(fptr, TDOUBLE, "BSCALE", &scale, nullptr, &keywordStatus); // Default is kept if missing
+  keywordStatus = 0;
+  fits_read_key(fptr, TDOUBLE, "BZERO", &zero, nullptr, &keywordStatus); // idem
+  return FitsEncoding<T>::letter() != 0 && (bitpix < 0) == std::is_floating_point<T>::value &&
+      std::abs(bitpix) / 8 == static_cast<int>(sizeof(T)) && scale == 1. && zero == FitsEncoding<T>::zero();
+}
+
 template <long n>
 void updateShape(fitsfile* fptr, const Fits::Position<n>& shape) {
   int status = 0;
@@ -96,117 +471,181 @@ Fits::VecRaster<T, m> readRegion(fitsfile* fptr, const Fits::Region<n>& region)
 
 template <typename T, long m, long n>
 void readRegionTo(fitsfile* fptr, const Fits::Region<n>& region, Fits::Raster<T, m>& raster) {
-  int status = 0;
-  const std::size_t dim = region.dimension();
-  Fits::Position<n> front = region.front; // Copy for const-correctness
-  Fits::Position<n> back = region.back; // idem
-  std::vector<long> step(dim, 1);
-  for (std::size_t i = 0; i < dim; ++i) {
-    front[i]++; // CFitsIO is 1-based
-    back[i]++; // idem
+  Internal::readRegionSpans(fptr, region, raster.data(), Internal::rasterStrides(raster.shape(), region));
+}
+
+template <typename T, long m, long n>
+void readRegionTo(fitsfile* fptr, const Fits::Region<n>& region, Fits::Subraster<T, m>& destination) {
+  auto& parent = destination.parent();
+  Internal::readRegionSpans(
+      fptr,
+      region,
+      &parent[destination.region().front],
+      Internal::rasterStrides(parent.shape(), region));
+}
+
+template <typename T, long m, long n>
+Fits::VecRaster<T, m> readRegion(fitsfile* fptr, const Fits::Region<n>& region, const Fits::Position<n>& step) {
+  Internal::mayThrowNonPositiveSteps(step, region);
+  Internal::readShapeContaining(fptr, region);
+  auto shape = region.shape();
+  for (long i = 0; i < shape.size(); ++i) {
+    shape[i] = (shape[i] + step[i] - 1) / step[i];
   }
+  Fits::VecRaster<T, m> raster(shape.template slice<m>());
+  auto front = region.front + 1; // 1-based
+  auto back = region.back + 1; // idem
+  std::vector<long> increments(step.begin(), step.end());
+  int status = 0;
   fits_read_subset(
       fptr,
       TypeCode<T>::forImage(),
       front.data(),
       back.data(),
-      step.data(),
+      increments.data(),
       nullptr,
       raster.data(),
       nullptr,
       &status);
-  CfitsioError::mayThrow(status, fptr, "Cannot read image region.");
+  CfitsioError::mayThrow(status, fptr, "Cannot read decimated image region.");
+  return raster;
 }
 
 template <typename T, long m, long n>
-void readRegionTo(fitsfile* fptr, const Fits::Region<n>& region, Fits::Subraster<T, m>& destination) {
+Fits::VecRaster<T, m> readRegion(
+    fitsfile* fptr,
+    const Fits::Region<n>& region,
+    const Fits::Position<n>& binShape,
+    Fits::Aggregation aggregation) {
 
-  /* 1-based, flatten region (beginning of each line) */
-  Fits::Region<n> srcRegion = region + 1;
-  srcRegion.back[0] = srcRegion.front[0];
-  const auto srcCount = srcRegion.size();
+  /* Binned shape and accumulators */
+  Internal::mayThrowNonPositiveSteps(binShape, region);
+  const auto extent = region.shape();
+  auto shape = extent;
+  for (long i = 0; i < shape.size(); ++i) {
+    shape[i] = (extent[i] + binShape[i] - 1) / binShape[i];
+  }
+  const auto strides = Internal::rasterStrides(extent, region);
+  const auto binnedStrides = Internal::rasterStrides(shape, region);
+  const bool isMax = aggregation == Fits::Aggregation::Max;
+  std::vector<double> accumulators(Fits::shapeSize(shape), isMax ? std::numeric_limits<double>::lowest() : 0.);
 
-  /* Screening positions */
-  auto srcFront = srcRegion.front;
-  auto srcBack = srcFront;
-  srcBack[0] += region.shape()[0] - 1;
-  auto dstFront = destination.region().front;
-  Fits::RegionScreener<n> srcScreener(srcRegion, { srcBack, dstFront });
+  /* Reduce the lines as they are read */
+  const long lineSize = extent[0];
+  const long binWidth = binShape[0];
+  Internal::readRegionLines<double>(fptr, region, [&](long index, const double* line) {
+    long binnedIndex = 0;
+    for (long i = 1; i < extent.size(); ++i) {
+      binnedIndex += (index / strides[i] % extent[i]) / binShape[i] * binnedStrides[i];
+    }
+    auto* accumulator = accumulators.data() + binnedIndex;
+    for (long x = 0; x < lineSize; ++x) {
+      auto& a = accumulator[x / binWidth];
+      a = isMax ? std::max(a, line[x]) : a + line[x];
+    }
+  });
 
-  /* Step */
-  std::vector<long> step(srcRegion.dimension(), 1L);
+  /* Normalize and convert */
+  Fits::VecRaster<T, m> raster(shape.template slice<m>());
+  auto* data = raster.data();
+  if (aggregation != Fits::Aggregation::Mean) {
+    std::transform(accumulators.begin(), accumulators.end(), data, Internal::saturatedCast<T>);
+    return raster;
+  }
+  const Fits::Region<n> domain { shape - shape, shape - 1 };
+  long index = 0;
+  for (const auto& p : domain) {
+    long count = 1;
+    for (long i = 0; i < p.size(); ++i) {
+      count *= std::min(binShape[i], extent[i] - p[i] * binShape[i]);
+    }
+    data[index] = Internal::saturatedCast<T>(accumulators[index] / count);
+    ++index;
+  }
+  return raster;
+}
+
+template <typename T, long m, long n>
+std::vector<Fits::VecRaster<T, m>> readRegions(fitsfile* fptr, const std::vector<Fits::Region<n>>& regions) {
 
-  /* Process each line */
+  /* List the lines of all the regions, sorted by file index */
+  struct Line {
+    long fileIndex;
+    long size;
+    std::size_t raster;
+    long memoryIndex;
+  };
+  std::vector<Fits::VecRaster<T, m>> rasters;
+  rasters.reserve(regions.size());
+  std::vector<Line> lines;
+  const auto shape = readShape<n>(fptr);
+  long maxLineSize = 0;
+  for (const auto& region : regions) {
+    Internal::mayThrowOutOfImage(shape, region);
+    rasters.emplace_back(region.shape().template slice<m>());
+    const auto fileStrides = Internal::rasterStrides(shape, region);
+    const auto memoryStrides = Internal::rasterStrides(rasters.back().shape(), region);
+    const long lineSize = region.back[0] - region.front[0] + 1;
+    maxLineSize = std::max(maxLineSize, lineSize);
+    Internal::regionLinesForeach(region, fileStrides, memoryStrides, [&](long fileIndex, long memoryIndex) {
+      lines.push_back({ fileIndex, lineSize, rasters.size() - 1, memoryIndex });
+    });
+  }
+  std::sort(lines.begin(), lines.end(), [](const Line& lhs, const Line& rhs) {
+    return lhs.fileIndex < rhs.fileIndex;
+  });
+
+  /* Read overlapping or nearby lines together and distribute them */
+  const long pixelBytes = sizeof(T);
+  const long maxGap = 2880 / pixelBytes;
+  const long capacity = std::max(maxLineSize, Internal::regionScratchBytes / pixelBytes);
+  std::vector<T> scratch;
   int status = 0;
-  for (long i = 0; i < srcCount; ++i) {
-    fits_read_subset(
-        fptr,
-        TypeCode<T>::forImage(),
-        srcFront.data(),
-        srcBack.data(),
-        step.data(),
-        nullptr,
-        &destination.parent()[dstFront],
-        nullptr,
-        &status);
-    CfitsioError::mayThrow(status, fptr, "Cannot read image region.");
-    srcScreener.next();
-    srcFront = srcScreener.current();
-    srcBack = srcScreener.followers()[0];
-    dstFront = srcScreener.followers()[1];
+  for (auto first = lines.begin(); first != lines.end();) {
+    const long front = first->fileIndex;
+    long back = front + first->size;
+    auto last = first + 1;
+    for (; last != lines.end(); ++last) {
+      const long end = std::max(back, last->fileIndex + last->size);
+      if (last->fileIndex - back > maxGap || end - front > capacity) {
+        break;
+      }
+      back = end;
+    }
+    scratch.resize(std::max<std::size_t>(scratch.size(), back - front));
+    fits_read_img(fptr, TypeCode<T>::forImage(), front + 1, back - front, nullptr, scratch.data(), nullptr, &status);
+    CfitsioError::mayThrow(status, fptr, "Cannot read image regions.");
+    for (; first != last; ++first) {
+      auto* destination = rasters[first->raster].data() + first->memoryIndex;
+      std::copy_n(scratch.data() + first->fileIndex - front, first->size, destination);
+    }
   }
+  return rasters;
 }
 
 template <typename T, long n>
 void writeRaster(fitsfile* fptr, const Fits::Raster<T, n>& raster) {
   mayThrowReadonlyError(fptr);
   int status = 0;
-  const auto begin = raster.data();
-  const auto end = begin + raster.size();
-  std::vector<std::decay_t<T>> nonconstData(begin, end); // For const-correctness issue
-  fits_write_img(fptr, TypeCode<T>::forImage(), 1, raster.size(), nonconstData.data(), &status);
+  fits_write_img(fptr, TypeCode<T>::forImage(), 1, raster.size(), nonconstData(raster.data()), &status);
   CfitsioError::mayThrow(status, fptr, "Cannot write image.");
 }
 
 template <typename T, long m, long n>
 void writeRegion(fitsfile* fptr, const Fits::Raster<T, m>& raster, const Fits::Position<n>& destination) {
-  int status = 0;
-  auto front = destination + 1;
-  const auto shape = raster.shape().extend(destination);
-  auto back = destination + shape; // = front + raster.shape() - 1
-  const auto begin = raster.data();
-  const auto end = begin + raster.size();
-  std::vector<std::decay_t<T>> nonconstData(begin, end); // For const-correctness issue
-  fits_write_subset(fptr, TypeCode<T>::forImage(), front.data(), back.data(), nonconstData.data(), &status);
-  CfitsioError::mayThrow(status, fptr, "Cannot write image region.");
+  const auto region = Internal::paddedRegion(destination, raster.shape());
+  Internal::writeRegionSpans(fptr, raster.data(), Internal::rasterStrides(raster.shape(), region), region);
 }
 
 template <typename T, long m, long n>
 void writeRegion(fitsfile* fptr, const Fits::Subraster<T, m>& subraster, const Fits::Position<n>& destination) {
-
-  /* 1-based, flatten region (beginning of each line) */
-  const auto shape = subraster.shape().extend(destination);
-  Fits::Region<n> dstRegion { destination + 1, destination + shape };
-  dstRegion.back[0] = dstRegion.front[0];
-
-  /* Screening positions */
-  const auto dstSize = shape[0];
-  const auto delta = subraster.region().front.extend(dstRegion.front) - dstRegion.front;
-
-  /* Process each line */
-  int status = 0;
-  Fits::Position<n> dstBack;
-  Fits::Position<n> srcFront;
-  std::vector<std::decay_t<T>> line(dstSize);
-  for (auto dstFront : dstRegion) {
-    dstBack = dstFront;
-    dstBack[0] += dstSize - 1;
-    srcFront = dstFront + delta;
-    line.assign(&subraster[srcFront], &subraster[srcFront] + dstSize);
-    fits_write_pix(fptr, TypeCode<T>::forImage(), dstFront.data(), dstSize, line.data(), &status);
-    // fits_write_subset(fptr, TypeCode<T>::forImage(), dstFront.data(), dstBack.data(), line.data(), &status);
-    CfitsioError::mayThrow(status, fptr, "Cannot write image region.");
-  }
+  const auto& parent = subraster.parent();
+  const auto region = Internal::paddedRegion(destination, subraster.shape());
+  Internal::writeRegionSpans(
+      fptr,
+      &parent[subraster.region().front],
+      Internal::rasterStrides(parent.shape(), region),
+      region);
 }
 
 } // namespace ImageIo
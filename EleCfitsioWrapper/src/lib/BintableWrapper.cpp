@@ -20,14 +20,77 @@
 #include "EleCfitsioWrapper/BintableWrapper.h"
 
 #include "EleCfitsioWrapper/CfitsioUtils.h"
+#include "EleCfitsioWrapper/FileWrapper.h"
+#include "EleCfitsioWrapper/HduWrapper.h"
 #include "EleCfitsioWrapper/HeaderWrapper.h"
 
 #include <algorithm>
+#include <cctype>
+#include <cstring> // strlen
 
 namespace Euclid {
 namespace Cfitsio {
 namespace BintableIo {
 
+namespace {
+
+/**
+ * @brief Low-level access to the current HDU, which bypasses the table structure.
+ * @details
+ * CFitsIO offers no public function to read or write bytes at arbitrary offsets of an HDU
+ * (e.g. in the heap, or beyond the current row width while the rows are shifted),
+ * to insert or delete whole header or data blocks, or to delete and renumber indexed keywords.
+ * The following functions are thin wrappers of the corresponding CFitsIO internals,
+ * which are prototyped in `fitsio.h` but not documented in the user's guide.
+ * They are the only uses of CFitsIO internals in the library,
+ * and have been stable from CFitsIO 3.0 to at least 4.x: check them first in case of a CFitsIO upgrade.
+ * Errors are accumulated in `status` like in CFitsIO, such that calls can be chained and checked once.
+ */
+namespace RawAccess {
+
+/**
+ * @brief Read bytes at a given offset from the beginning of the file (`ffmbyt()` and `ffgbyt()`).
+ */
+void readBytes(fitsfile* fptr, long offset, long count, void* destination, int& status) {
+  ffmbyt(fptr, offset, REPORT_EOF, &status);
+  ffgbyt(fptr, count, destination, &status);
+}
+
+/**
+ * @brief Write bytes at a given offset from the beginning of the file, possibly past its end
+ * (`ffmbyt()` and `ffpbyt()`).
+ */
+void writeBytes(fitsfile* fptr, long offset, long count, const unsigned char* source, int& status) {
+  ffmbyt(fptr, offset, IGNORE_EOF, &status);
+  ffpbyt(fptr, count, nonconstData(source), &status);
+}
+
+/**
+ * @brief Insert blocks of 2880 bytes at the end of the header (`ffiblk()`).
+ */
+void insertHeaderBlocks(fitsfile* fptr, long count, int& status) {
+  ffiblk(fptr, count, 0, &status);
+}
+
+/**
+ * @brief Delete blocks of 2880 bytes at the end of the data unit (`ffdblk()`).
+ */
+void deleteDataBlocks(fitsfile* fptr, long count, int& status) {
+  ffdblk(fptr, count, &status);
+}
+
+/**
+ * @brief Delete the indexed keywords of a column, and decrement the index of the keywords of the next columns
+ * (`ffkshf()`).
+ */
+void deleteColumnKeywords(fitsfile* fptr, long index, long columnCount, int& status) {
+  ffkshf(fptr, static_cast<int>(index), static_cast<int>(columnCount), -1, &status);
+}
+
+} // namespace RawAccess
+
+} // namespace
+
 long columnCount(fitsfile* fptr) {
   int status = 0;
   int ncols = 0;
@@ -44,6 +107,168 @@ long rowCount(fitsfile* fptr) {
   return nrows;
 }
 
+void insertRows(fitsfile* fptr, long firstRow, long rowCount) {
+  int status = 0;
+  fits_insert_rows(fptr, firstRow - 1, rowCount, &status); // Insert after row firstRow - 1
+  CfitsioError::mayThrow(status, fptr, "Cannot insert rows");
+}
+
+void deleteRows(fitsfile* fptr, long firstRow, long rowCount) {
+  int status = 0;
+  fits_delete_rows(fptr, firstRow, rowCount, &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot delete rows");
+}
+
+void initColumns(
+    fitsfile* fptr,
+    long index,
+    const std::vector<std::string>& names,
+    const std::vector<std::string>& tforms,
+    const std::vector<std::string>& units) {
+  const long count = names.size();
+  if (count == 0) {
+    return;
+  }
+  int status = 0;
+
+  /* Reserve header space at once instead of one block per overflow */
+  const auto unitCount = std::count_if(units.begin(), units.end(), [](const std::string& u) {
+    return not u.empty();
+  });
+  int keywordCount = 0;
+  int freeCount = 0;
+  fits_get_hdrspace(fptr, &keywordCount, &freeCount, &status);
+  const long missingCount = 2 * count + unitCount - freeCount;
+  if (missingCount > 0) {
+    RawAccess::insertHeaderBlocks(fptr, (missingCount + 35) / 36, status); // 36 records per block
+  }
+  CfitsioError::mayThrow(status, fptr, "Cannot reserve header space for " + std::to_string(count) + " columns");
+
+  /* Shift the data unit once */
+  CStrArray cNames(names);
+  CStrArray cTforms(tforms);
+  fits_insert_cols(fptr, static_cast<int>(index), static_cast<int>(count), cNames.data(), cTforms.data(), &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot init columns from #" + std::to_string(index - 1));
+
+  for (long i = 0; i < count && i < static_cast<long>(units.size()); ++i) {
+    if (not units[i].empty()) {
+      const auto keyword = "TUNIT" + std::to_string(index + i);
+      HeaderIo::updateRecord<std::string>(fptr, { keyword, units[i], "", "physical unit of field" });
+    }
+  }
+}
+
+void deleteColumns(fitsfile* fptr, std::vector<long> indices) {
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+  if (indices.empty()) {
+    return;
+  }
+  long columnCount = BintableIo::columnCount(fptr);
+  Fits::OutOfBoundsError::mayThrow("Cannot delete column", indices.front() - 1, { 0, columnCount - 1 });
+  Fits::OutOfBoundsError::mayThrow("Cannot delete column", indices.back() - 1, { 0, columnCount - 1 });
+
+  /* Compute the new row layout as contiguous byte spans to be kept */
+  const long rowWidth = HeaderIo::parseRecord<long>(fptr, "NAXIS1");
+  const long rowCount = BintableIo::rowCount(fptr);
+  std::vector<std::pair<long, long>> spans; // Byte offsets in the old row and byte counts
+  long newRowWidth = 0;
+  const auto keep = [&](long offset, long width) {
+    if (not spans.empty() && spans.back().first + spans.back().second == offset) {
+      spans.back().second += width;
+    } else {
+      spans.emplace_back(offset, width);
+    }
+    newRowWidth += width;
+  };
+  long offset = 0;
+  auto deleted = indices.begin();
+  for (long i = 1; i <= columnCount; ++i) {
+    const std::string tform = HeaderIo::parseRecord<std::string>(fptr, "TFORM" + std::to_string(i));
+    const long width = fieldByteCount(tform);
+    if (width < 0) {
+      throw Fits::FitsError("Cannot delete columns: Unknown TFORM" + std::to_string(i) + " = " + tform);
+    }
+    if (deleted != indices.end() && *deleted == i) {
+      ++deleted;
+    } else if (width > 0) {
+      keep(offset, width);
+    }
+    offset += width;
+  }
+  if (offset < rowWidth) { // Unused trailing bytes are preserved like in fits_delete_col
+    keep(offset, rowWidth - offset);
+  }
+
+  /* Shift the rows by blocks, in place: the write position never overtakes the read position */
+  const long dataOffset = HduAccess::currentDataOffset(fptr);
+  int status = 0;
+  long bufferRowCount = 0;
+  fits_get_rowsize(fptr, &bufferRowCount, &status);
+  bufferRowCount = std::max(1L, bufferRowCount);
+  std::vector<unsigned char> source(std::min(bufferRowCount, rowCount) * rowWidth);
+  std::vector<unsigned char> destination(std::min(bufferRowCount, rowCount) * newRowWidth);
+  for (long front = 0; front < rowCount; front += bufferRowCount) {
+    const long size = std::min(bufferRowCount, rowCount - front);
+    RawAccess::readBytes(fptr, dataOffset + front * rowWidth, size * rowWidth, source.data(), status);
+    auto* out = destination.data();
+    for (long r = 0; r < size; ++r) {
+      const auto* in = source.data() + r * rowWidth;
+      for (const auto& s : spans) {
+        out = std::copy_n(in + s.first, s.second, out);
+      }
+    }
+    RawAccess::writeBytes(fptr, dataOffset + front * newRowWidth, size * newRowWidth, destination.data(), status);
+    CfitsioError::mayThrow(
+        status,
+        fptr,
+        "Cannot shift rows: [" + std::to_string(front) + "-" + std::to_string(front + size - 1) + "]");
+  }
+
+  /* Shift the heap (and the gap before it) by the same amount, with the same buffer */
+  const long shift = (rowWidth - newRowWidth) * rowCount;
+  const long oldTableSize = rowWidth * rowCount;
+  const long heapSize = HeaderIo::parseRecord<long>(fptr, "PCOUNT");
+  const long heapBufferSize = std::max(static_cast<long>(source.size()), 2880L);
+  source.resize(heapBufferSize);
+  for (long front = 0; front < heapSize; front += heapBufferSize) {
+    const long size = std::min(heapBufferSize, heapSize - front);
+    RawAccess::readBytes(fptr, dataOffset + oldTableSize + front, size, source.data(), status);
+    RawAccess::writeBytes(fptr, dataOffset + oldTableSize - shift + front, size, source.data(), status);
+    CfitsioError::mayThrow(status, fptr, "Cannot shift heap");
+  }
+
+  /* Zero-fill the last block and release the unused ones */
+  const long oldSize = oldTableSize + heapSize;
+  const long newSize = oldSize - shift;
+  const long newBlockCount = (newSize + 2879) / 2880;
+  const long releasedBlockCount = (oldSize + 2879) / 2880 - newBlockCount;
+  const std::vector<unsigned char> padding(newBlockCount * 2880 - newSize, 0);
+  if (not padding.empty()) {
+    RawAccess::writeBytes(fptr, dataOffset + newSize, padding.size(), padding.data(), status);
+  }
+  if (releasedBlockCount > 0) {
+    RawAccess::deleteDataBlocks(fptr, releasedBlockCount, status);
+  }
+  CfitsioError::mayThrow(status, fptr, "Cannot release data blocks");
+
+  /* Update the header, from the last deleted column to keep indices valid */
+  for (auto it = indices.rbegin(); it != indices.rend(); ++it) {
+    RawAccess::deleteColumnKeywords(fptr, *it, columnCount, status);
+    --columnCount;
+  }
+  CfitsioError::mayThrow(status, fptr, "Cannot delete column keywords");
+  char keepComment[] = "&"; // Special value to keep the comment unchanged
+  fits_modify_key_lng(fptr, "TFIELDS", columnCount, keepComment, &status);
+  fits_modify_key_lng(fptr, "NAXIS1", newRowWidth, keepComment, &status);
+  if (HeaderIo::hasKeyword(fptr, "THEAP")) {
+    const long heapOffset = HeaderIo::parseRecord<long>(fptr, "THEAP");
+    fits_modify_key_lng(fptr, "THEAP", heapOffset - shift, keepComment, &status);
+  }
+  fits_set_hdustruc(fptr, &status); // Update internal fptr state to take into account new layout
+  CfitsioError::mayThrow(status, fptr, "Cannot update table structure");
+}
+
 bool hasColumn(fitsfile* fptr, const std::string& name) {
   int index = 0;
   int status = 0;
@@ -80,6 +305,28 @@ void updateColumnName(fitsfile* fptr, long index, const std::string& newName) {
   CfitsioError::mayThrow(status, fptr, "Cannot update name of column #" + std::to_string(index - 1));
 }
 
+Fits::Position<-1> readColumnShape(fitsfile* fptr, long index) {
+  std::vector<long> shape(999); // Max dimension of the standard
+  int dimension = 0;
+  int status = 0;
+  fits_read_tdim(fptr, static_cast<int>(index), shape.size(), &dimension, shape.data(), &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot read shape of column #" + std::to_string(index - 1));
+  if (dimension <= 1) {
+    return {};
+  }
+  return Fits::Position<-1>(shape.begin(), shape.begin() + dimension);
+}
+
+void updateColumnShape(fitsfile* fptr, long index, const Fits::Position<-1>& shape) {
+  if (shape.size() == 0) {
+    return;
+  }
+  auto nonconstShape = shape; // const-correctness issue
+  int status = 0;
+  fits_write_tdim(fptr, static_cast<int>(index), shape.size(), nonconstShape.data(), &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot update shape of column #" + std::to_string(index - 1));
+}
+
 long columnIndex(fitsfile* fptr, const std::string& name) {
   int index = 0;
   int status = 0;
@@ -88,6 +335,352 @@ long columnIndex(fitsfile* fptr, const std::string& name) {
   return index;
 }
 
+long fieldByteCount(const std::string& tform) {
+  std::size_t letterPos = 0;
+  long repeatCount = 1;
+  if (not tform.empty() && std::isdigit(tform[0])) {
+    repeatCount = std::stol(tform, &letterPos);
+  }
+  if (letterPos >= tform.length()) {
+    return -1;
+  }
+  switch (tform[letterPos]) {
+    case 'L':
+    case 'B':
+    case 'A':
+      return repeatCount;
+    case 'X':
+      return (repeatCount + 7) / 8;
+    case 'I':
+      return repeatCount * 2;
+    case 'J':
+    case 'E':
+      return repeatCount * 4;
+    case 'K':
+    case 'D':
+    case 'C':
+    case 'P':
+      return repeatCount * 8;
+    case 'M':
+    case 'Q':
+      return repeatCount * 16;
+    default:
+      return -1;
+  }
+}
+
+void readRowBytes(fitsfile* fptr, long firstRow, long rowCount, long rowWidth, unsigned char* destination) {
+  int status = 0;
+  fits_read_tblbytes(fptr, firstRow, 1, rowCount * rowWidth, destination, &status);
+  CfitsioError::mayThrow(
+      status,
+      fptr,
+      "Cannot read raw rows: [" + std::to_string(firstRow - 1) + "-" + std::to_string(firstRow - 2 + rowCount) + "]");
+}
+
+void writeRowBytes(fitsfile* fptr, long firstRow, long rowCount, long rowWidth, const unsigned char* source) {
+  int status = 0;
+  fits_write_tblbytes(fptr, firstRow, 1, rowCount * rowWidth, nonconstData(source), &status);
+  CfitsioError::mayThrow(
+      status,
+      fptr,
+      "Cannot write raw rows: [" + std::to_string(firstRow - 1) + "-" + std::to_string(firstRow - 2 + rowCount) + "]");
+}
+
+char vlaLetter(fitsfile* fptr, long index) {
+  const auto tform = HeaderIo::parseRecord<std::string>(fptr, "TFORM" + std::to_string(index)).value;
+  const auto pos = tform.find_first_of("PQ");
+  if (pos == std::string::npos || pos + 1 >= tform.length()) {
+    throw Fits::FitsError("Not a variable-length array column: #" + std::to_string(index - 1) + " (" + tform + ")");
+  }
+  return tform[pos + 1];
+}
+
+void readDescriptors(
+    fitsfile* fptr,
+    const Fits::Segment& rows,
+    long index,
+    std::vector<long>& sizes,
+    std::vector<long>& heapOffsets) {
+  const auto rowCount = rows.size();
+  std::vector<LONGLONG> lengths(rowCount);
+  std::vector<LONGLONG> addresses(rowCount);
+  int status = 0;
+  fits_read_descriptsll(
+      fptr,
+      static_cast<int>(index),
+      rows.front,
+      rowCount,
+      lengths.data(),
+      addresses.data(),
+      &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot read descriptors of column #" + std::to_string(index - 1));
+  sizes.assign(lengths.begin(), lengths.end());
+  heapOffsets.assign(addresses.begin(), addresses.end());
+}
+
+void readHeapBytes(fitsfile* fptr, long heapOffset, long byteCount, unsigned char* destination) {
+  const long dataOffset = HduAccess::currentDataOffset(fptr);
+  const long heapStart = HeaderIo::hasKeyword(fptr, "THEAP") ?
+      HeaderIo::parseRecord<long>(fptr, "THEAP").value :
+      HeaderIo::parseRecord<long>(fptr, "NAXIS1").value * HeaderIo::parseRecord<long>(fptr, "NAXIS2").value;
+  int status = 0;
+  RawAccess::readBytes(fptr, dataOffset + heapStart + heapOffset, byteCount, destination, status);
+  CfitsioError::mayThrow(
+      status,
+      fptr,
+      "Cannot read heap bytes: [" + std::to_string(heapOffset) + "-" + std::to_string(heapOffset + byteCount - 1) +
+          "]");
+}
+
+void readColumnSegment(
+    fitsfile* fptr,
+    const Fits::Segment& rows,
+    long index,
+    Fits::FixedStringColumn& column,
+    long front) {
+  std::vector<char*> cells(rows.size()); // Pointers to the arena, such that no string is allocated
+  for (long i = 0; i < rows.size(); ++i) {
+    cells[i] = column.cell(front + i);
+  }
+  int status = 0;
+  fits_read_col(
+      fptr,
+      TSTRING,
+      static_cast<int>(index),
+      rows.front,
+      1, // firstelemn (1-based)
+      cells.size(), // nelements = number of rows for strings
+      nullptr, // nulval
+      cells.data(),
+      nullptr, // anynul
+      &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot read string column #" + std::to_string(index - 1));
+}
+
+void writeColumnSegment(
+    fitsfile* fptr,
+    long firstRow,
+    long index,
+    const Fits::FixedStringColumn& column,
+    const Fits::Segment& rows) {
+  std::vector<char*> cells(rows.size()); // Pointers to the arena, such that no string is allocated
+  for (long i = 0; i < rows.size(); ++i) {
+    cells[i] = nonconstData(column.cell(rows.front + i));
+  }
+  int status = 0;
+  fits_write_col(
+      fptr,
+      TSTRING,
+      static_cast<int>(index), // colnum // column indices are int
+      firstRow, // firstrow (1-based)
+      1, // firstelem (1-based)
+      cells.size(), // nelements
+      cells.data(),
+      &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot write string column data: " + column.info().name);
+}
+
+namespace {
+
+/**
+ * @brief The CFitsIO name of a table compression algorithm.
+ */
+std::string algorithmName(Fits::TableCompression::Algorithm algo) {
+  switch (algo) {
+    case Fits::TableCompression::Algorithm::Gzip:
+      return "GZIP_1";
+    case Fits::TableCompression::Algorithm::Rice:
+      return "RICE_1";
+    default:
+      return "GZIP_2";
+  }
+}
+
+/**
+ * @brief The kinds of records of a compressed binary table header.
+ */
+enum class RecordKind
+{
+  Structure, ///< Written by `fits_insert_btbl()`
+  Table, ///< Other column or compression record, e.g. `TSCALn` or `ZCTYPn`
+  User ///< Any other record
+};
+
+/**
+ * @brief Check whether a keyword is made of a given prefix followed by a column or axis index, e.g. `TSCAL12`.
+ */
+bool isIndexed(const std::string& keyword, const std::string& prefix) {
+  if (keyword.size() <= prefix.size() || keyword.compare(0, prefix.size(), prefix) != 0) {
+    return false;
+  }
+  return std::all_of(keyword.begin() + prefix.size(), keyword.end(), [](char c) {
+    return std::isdigit(static_cast<unsigned char>(c));
+  });
+}
+
+/**
+ * @brief Get the kind of a record.
+ * @details
+ * Table records are those reserved by the tiled table and image compression conventions,
+ * and the column records which are not written by `fits_insert_btbl()`.
+ */
+RecordKind recordKind(const std::string& keyword) {
+  static const std::vector<std::string> structureKeywords {
+      "XTENSION", "BITPIX", "NAXIS", "NAXIS1", "NAXIS2", "PCOUNT", "GCOUNT", "TFIELDS", "EXTNAME", "END"};
+  static const std::vector<std::string> structurePrefixes {"TTYPE", "TFORM", "TUNIT"};
+  static const std::vector<std::string> tableKeywords {
+      "ZIMAGE", "ZTENSION", "ZBITPIX", "ZNAXIS", "ZCMPTYPE", "ZTABLE", "ZTILELEN", "ZPCOUNT", "ZGCOUNT",
+      "ZTHEAP", "ZSIMPLE", "ZEXTEND", "ZHECKSUM", "ZDATASUM", "ZQUANTIZ", "ZDITHER0", "ZBLANK",
+      "FZTILELN", "FZALGOR", "THEAP"};
+  static const std::vector<std::string> tablePrefixes {
+      "ZNAXIS", "ZTILE", "ZNAME", "ZVAL", "ZFORM", "ZCTYP", "FZALG", "TSCAL", "TZERO", "TNULL", "TDIM", "TDISP"};
+  const auto isIndexedBy = [&](const std::string& prefix) {
+    return isIndexed(keyword, prefix);
+  };
+  if (std::find(structureKeywords.begin(), structureKeywords.end(), keyword) != structureKeywords.end() ||
+      std::any_of(structurePrefixes.begin(), structurePrefixes.end(), isIndexedBy)) {
+    return RecordKind::Structure;
+  }
+  if (std::find(tableKeywords.begin(), tableKeywords.end(), keyword) != tableKeywords.end() ||
+      std::any_of(tablePrefixes.begin(), tablePrefixes.end(), isIndexedBy)) {
+    return RecordKind::Table;
+  }
+  return RecordKind::User;
+}
+
+/**
+ * @brief Read the records of a given kind in the current HDU.
+ */
+std::vector<std::string> readRecords(fitsfile* fptr, RecordKind kind, int& status) {
+  int count = 0;
+  fits_get_hdrspace(fptr, &count, nullptr, &status);
+  std::vector<std::string> records;
+  char record[FLEN_CARD] {};
+  for (int i = 1; i <= count && status == 0; ++i) {
+    fits_read_record(fptr, i, record, &status);
+    std::string keyword(record, std::min<std::size_t>(8, std::strlen(record)));
+    keyword.erase(keyword.find_last_not_of(' ') + 1);
+    if (recordKind(keyword) == kind) {
+      records.emplace_back(record);
+    }
+  }
+  return records;
+}
+
+} // namespace
+
+bool isCompressed(fitsfile* fptr) {
+  int status = 0;
+  int ztable = 0;
+  fits_read_key(fptr, TLOGICAL, "ZTABLE", &ztable, nullptr, &status); // Default is kept if missing
+  return status == 0 && ztable;
+}
+
+Fits::TableCompression readCompression(fitsfile* fptr) {
+  int status = 0;
+  long tileRowCount = 0;
+  fits_read_key(fptr, TLONG, "ZTILELEN", &tileRowCount, nullptr, &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot read the tile size of compressed binary table");
+  Fits::TableCompression compression(tileRowCount);
+  const auto count = columnCount(fptr);
+  for (long i = 1; i <= count; ++i) {
+    const auto keyword = "ZCTYP" + std::to_string(i);
+    if (not HeaderIo::hasKeyword(fptr, keyword)) {
+      continue;
+    }
+    const auto name = HeaderIo::parseRecord<std::string>(fptr, keyword).value;
+    for (auto algo : { Fits::TableCompression::Algorithm::Gzip,
+                       Fits::TableCompression::Algorithm::ShuffledGzip,
+                       Fits::TableCompression::Algorithm::Rice }) {
+      if (name == algorithmName(algo)) {
+        compression.assign(columnName(fptr, i), algo);
+      }
+    }
+  }
+  return compression;
+}
+
+fitsfile* uncompress(fitsfile* fptr) {
+  auto buffer = FileAccess::createAndOpen("mem://", FileAccess::CreatePolicy::CreateOnly);
+  int status = 0;
+  fits_uncompress_table(fptr, buffer, &status);
+  if (status != 0) {
+    FileAccess::close(buffer);
+  }
+  CfitsioError::mayThrow(status, fptr, "Cannot uncompress binary table");
+  return buffer;
+}
+
+void compress(fitsfile* buffer, const Fits::TableCompression& compression, fitsfile* fptr) {
+  if (compression.tileRowCount > 0) {
+    HeaderIo::updateRecord(buffer, Fits::Record<long>("FZTILELN", compression.tileRowCount));
+  }
+  const auto count = columnCount(buffer);
+  for (long i = 1; i <= count; ++i) {
+    const auto algo = compression.algorithm(columnName(buffer, i));
+    HeaderIo::updateRecord(buffer, Fits::Record<std::string>("FZALG" + std::to_string(i), algorithmName(algo)));
+  }
+  int status = 0;
+  fits_compress_table(buffer, fptr, &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot compress binary table");
+}
+
+void updateCompressed(fitsfile* buffer, const Fits::TableCompression& compression, fitsfile* fptr) {
+
+  /* Compress into memory */
+  auto compressed = FileAccess::createAndOpen("mem://", FileAccess::CreatePolicy::CreateOnly);
+  try {
+    compress(buffer, compression, compressed);
+  } catch (...) {
+    FileAccess::close(compressed);
+    throw;
+  }
+
+  /* Read the structure */
+  // CFitsIO functions do nothing if status is not 0, which is checked once at the end
+  int status = 0;
+  const auto count = columnCount(compressed);
+  CStrArray names(std::vector<std::string>(count, std::string(FLEN_VALUE, ' ')));
+  CStrArray tforms(std::vector<std::string>(count, std::string(FLEN_VALUE, ' ')));
+  CStrArray units(std::vector<std::string>(count, std::string(FLEN_VALUE, ' ')));
+  char extname[FLEN_VALUE] {};
+  long rowCount = 0;
+  long heapSize = 0;
+  int tfields = 0;
+  fits_read_btblhdr(
+      compressed,
+      count,
+      &rowCount,
+      &tfields,
+      names.data(),
+      tforms.data(),
+      units.data(),
+      extname,
+      &heapSize,
+      &status);
+
+  /* Replace the HDU with an empty one of same structure */
+  // User records are kept from the current HDU, because they may have been edited since uncompression
+  const auto userRecords = readRecords(fptr, RecordKind::User, status);
+  const auto tableRecords = readRecords(compressed, RecordKind::Table, status);
+  const auto index = HduAccess::currentIndex(fptr);
+  fits_delete_hdu(fptr, nullptr, &status);
+  fits_movabs_hdu(fptr, index - 1, nullptr, &status);
+  fits_insert_btbl(fptr, rowCount, tfields, names.data(), tforms.data(), units.data(), extname, heapSize, &status);
+
+  /* Copy the other records and the data unit */
+  for (const auto& records : { tableRecords, userRecords }) {
+    for (const auto& record : records) {
+      fits_write_record(fptr, record.c_str(), &status);
+    }
+  }
+  fits_set_hdustruc(fptr, &status);
+  fits_copy_data(compressed, fptr, &status);
+  FileAccess::close(compressed);
+  CfitsioError::mayThrow(status, fptr, "Cannot replace compressed binary table");
+}
+
 namespace Internal {
 
 template <> // TODO clean
@@ -219,8 +812,11 @@ void writeColumn<std::string>(fitsfile* fptr, const Fits::Column<std::string>& c
 }
 
 template <>
-void writeColumnSegment<std::string>(fitsfile* fptr, long firstRow, const Fits::Column<std::string>& column) {
-  long index = columnIndex(fptr, column.info().name);
+void writeColumnSegment<std::string>(
+    fitsfile* fptr,
+    long firstRow,
+    long index,
+    const Fits::Column<std::string>& column) {
   const auto begin = column.data();
   const auto end = begin + column.elementCount();
   CStrArray array(begin, end);
@@ -236,12 +832,15 @@ void writeColumnSegment<std::string>(fitsfile* fptr, long firstRow, const Fits::
       column.elementCount(), // nelements
       array.data(),
       &status);
-  CfitsioError::mayThrow(status, fptr, "Cannot write string column dat: " + column.info().name);
+  CfitsioError::mayThrow(status, fptr, "Cannot write string column data: " + column.info().name);
 }
 
 template <>
-void writeColumnSegment<const std::string>(fitsfile* fptr, long firstRow, const Fits::Column<const std::string>& column) {
-  long index = columnIndex(fptr, column.info().name);
+void writeColumnSegment<const std::string>(
+    fitsfile* fptr,
+    long firstRow,
+    long index,
+    const Fits::Column<const std::string>& column) {
   const auto begin = column.data();
   const auto end = begin + column.elementCount();
   CStrArray array(begin, end);
@@ -257,7 +856,7 @@ void writeColumnSegment<const std::string>(fitsfile* fptr, long firstRow, const
       column.elementCount(), // nelements
       array.data(),
       &status);
-  CfitsioError::mayThrow(status, fptr, "Cannot write string column dat: " + column.info().name);
+  CfitsioError::mayThrow(status, fptr, "Cannot write string column data: " + column.info().name);
 }
 
 } // namespace BintableIo
@@ -0,0 +1,156 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleCfitsioWrapper/ByteSwap.h"
+
+#include "EleFitsData/FitsError.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Euclid {
+namespace Cfitsio {
+
+void decodeField(const unsigned char*, long, long, long, long, std::string*) {
+  throw Fits::FitsError("Cannot decode string columns from raw bytes.");
+}
+
+void encodeField(const std::string*, long, long, long, long, unsigned char*) {
+  throw Fits::FitsError("Cannot encode string columns as raw bytes.");
+}
+
+namespace {
+
+/**
+ * @brief Get a mask of the `count` most significant bits of a byte.
+ */
+unsigned char leadingMask(long count) {
+  return static_cast<unsigned char>(0xFF << (8 - count));
+}
+
+/**
+ * @brief Copy `count` bits from the beginning of `source` to position `firstBit` of `destination`.
+ */
+void copyBitsTo(const unsigned char* source, long count, unsigned char* destination, long firstBit) {
+  auto* out = destination + firstBit / 8;
+  const long shift = firstBit % 8;
+  if (shift == 0) {
+    std::memcpy(out, source, count / 8);
+    if (count % 8 != 0) {
+      const auto mask = leadingMask(count % 8);
+      out[count / 8] = (out[count / 8] & ~mask) | (source[count / 8] & mask);
+    }
+    return;
+  }
+  for (long i = 0; i < count; i += 8, ++out) {
+    const auto mask = leadingMask(std::min(8L, count - i));
+    const unsigned char byte = *source++ & mask;
+    out[0] = (out[0] & ~(mask >> shift)) | (byte >> shift);
+    const unsigned char lowMask = mask << (8 - shift);
+    if (lowMask != 0) {
+      out[1] = (out[1] & ~lowMask) | static_cast<unsigned char>(byte << (8 - shift));
+    }
+  }
+}
+
+/**
+ * @brief Copy `count` bits from position `firstBit` of `source` to the beginning of `destination`, with null padding.
+ */
+void copyBitsFrom(const unsigned char* source, long firstBit, long count, unsigned char* destination) {
+  const auto* in = source + firstBit / 8;
+  const long shift = firstBit % 8;
+  for (long i = 0; i < count; i += 8, ++in) {
+    const long n = std::min(8L, count - i);
+    unsigned char byte = in[0] << shift;
+    if (shift + n > 8) {
+      byte |= in[1] >> (8 - shift);
+    }
+    *destination++ = byte & leadingMask(n);
+  }
+}
+
+} // namespace
+
+void decodeBitField(
+    const unsigned char* block,
+    long rowCount,
+    long rowWidth,
+    long byteOffset,
+    long repeatCount,
+    unsigned char* bits,
+    long firstBit) {
+  const auto* field = block + byteOffset;
+  for (long row = 0; row < rowCount; ++row, field += rowWidth, firstBit += repeatCount) {
+    copyBitsTo(field, repeatCount, bits, firstBit);
+  }
+}
+
+void encodeBitField(
+    const unsigned char* bits,
+    long firstBit,
+    long rowCount,
+    long rowWidth,
+    long byteOffset,
+    long repeatCount,
+    unsigned char* block) {
+  auto* field = block + byteOffset;
+  for (long row = 0; row < rowCount; ++row, field += rowWidth, firstBit += repeatCount) {
+    copyBitsFrom(bits, firstBit, repeatCount, field);
+  }
+}
+
+void decodeLogicalField(
+    const unsigned char* block,
+    long rowCount,
+    long rowWidth,
+    long byteOffset,
+    long repeatCount,
+    unsigned char* bits,
+    long firstBit) {
+  const auto* field = block + byteOffset;
+  for (long row = 0; row < rowCount; ++row, field += rowWidth) {
+    for (long i = 0; i < repeatCount; ++i, ++firstBit) {
+      const unsigned char mask = 0x80 >> (firstBit % 8);
+      if (field[i] == 'T') {
+        bits[firstBit / 8] |= mask;
+      } else {
+        bits[firstBit / 8] &= ~mask;
+      }
+    }
+  }
+}
+
+void encodeLogicalField(
+    const unsigned char* bits,
+    long firstBit,
+    long rowCount,
+    long rowWidth,
+    long byteOffset,
+    long repeatCount,
+    unsigned char* block) {
+  auto* field = block + byteOffset;
+  for (long row = 0; row < rowCount; ++row, field += rowWidth) {
+    for (long i = 0; i < repeatCount; ++i, ++firstBit) {
+      field[i] = (bits[firstBit / 8] & (0x80 >> (firstBit % 8))) ? 'T' : 'F';
+    }
+  }
+}
+
+} // namespace Cfitsio
+} // namespace Euclid
@@ -72,6 +72,15 @@ void closeAndDelete(fitsfile*& fptr) {
   fptr = nullptr;
 }
 
+void flush(fitsfile* fptr) {
+  if (not isWritable(fptr)) {
+    return;
+  }
+  int status = 0;
+  fits_flush_file(fptr, &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot flush file");
+}
+
 std::string name(fitsfile* fptr) {
   int status = 0;
   char filename[FLEN_FILENAME];
@@ -80,6 +89,14 @@ std::string name(fitsfile* fptr) {
   return filename;
 }
 
+bool isDiskFile(fitsfile* fptr) {
+  int status = 0;
+  char urltype[FLEN_FILENAME];
+  fits_url_type(fptr, urltype, &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot read URL type");
+  return std::string(urltype) == "file://";
+}
+
 bool isWritable(fitsfile* fptr) {
   int status = 0;
   int filemode;
@@ -40,6 +40,16 @@ long currentIndex(fitsfile* fptr) {
   return index;
 }
 
+long currentDataOffset(fitsfile* fptr) {
+  LONGLONG headerStart = 0;
+  LONGLONG dataStart = 0;
+  LONGLONG dataEnd = 0;
+  int status = 0;
+  fits_get_hduaddrll(fptr, &headerStart, &dataStart, &dataEnd, &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot read data unit position");
+  return dataStart;
+}
+
 std::string currentName(fitsfile* fptr) {
   if (HeaderIo::hasKeyword(fptr, "EXTNAME")) {
     return HeaderIo::parseRecord<std::string>(fptr, "EXTNAME");
@@ -146,6 +156,29 @@ void createMetadataExtension(fitsfile* fptr, const std::string& name) {
   createImageExtension<unsigned char, 0>(fptr, name, Fits::Position<0>());
 }
 
+void createBintableExtension(
+    fitsfile* fptr,
+    const std::string& name,
+    const std::vector<std::string>& names,
+    const std::vector<std::string>& tforms,
+    const std::vector<std::string>& units) {
+  CStrArray colName(names);
+  CStrArray colFormat(tforms);
+  CStrArray colUnit(units);
+  int status = 0;
+  fits_create_tbl(
+      fptr,
+      BINARY_TBL,
+      0,
+      names.size(),
+      colName.data(),
+      colFormat.data(),
+      colUnit.data(),
+      name.c_str(),
+      &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot create binary table extension: " + name);
+}
+
 void deleteHdu(fitsfile* fptr, long index) {
   gotoIndex(fptr, index);
   int status = 0;
@@ -21,6 +21,9 @@
 
 #include "EleFitsData/Raster.h" // ELEFITS_FOREACH_RASTER_TYPE
 
+#include <algorithm> // copy
+#include <vector>
+
 namespace Euclid {
 namespace Cfitsio {
 namespace ImageIo {
@@ -39,6 +42,71 @@ const std::type_info& readTypeid(fitsfile* fptr) {
   throw Fits::FitsError("Unknown BITPIX: " + std::to_string(bitpix));
 }
 
+namespace {
+
+/**
+ * @brief The CFitsIO code of an image compression algorithm.
+ */
+int algorithmCode(Fits::ImageCompression::Algorithm algo) {
+  switch (algo) {
+    case Fits::ImageCompression::Algorithm::Rice:
+      return RICE_1;
+    case Fits::ImageCompression::Algorithm::Gzip:
+      return GZIP_1;
+    case Fits::ImageCompression::Algorithm::ShuffledGzip:
+      return GZIP_2;
+    case Fits::ImageCompression::Algorithm::Hcompress:
+      return HCOMPRESS_1;
+    case Fits::ImageCompression::Algorithm::Plio:
+      return PLIO_1;
+  }
+  throw Fits::FitsError("Unknown image compression algorithm");
+}
+
+/**
+ * @brief The CFitsIO code of a dithering method.
+ */
+int ditheringCode(Fits::ImageCompression::Dithering method) {
+  switch (method) {
+    case Fits::ImageCompression::Dithering::None:
+      return NO_DITHER;
+    case Fits::ImageCompression::Dithering::EveryPixel:
+      return SUBTRACTIVE_DITHER_1;
+    case Fits::ImageCompression::Dithering::NonZeroPixel:
+      return SUBTRACTIVE_DITHER_2;
+  }
+  throw Fits::FitsError("Unknown dithering method");
+}
+
+} // namespace
+
+bool isCompressed(fitsfile* fptr) {
+  int status = 0;
+  const int compressed = fits_is_compressed_image(fptr, &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot check whether image is compressed");
+  return compressed;
+}
+
+void setCompression(fitsfile* fptr, const Fits::ImageCompression& compression) {
+  if (compression.tileShape.size() > MAX_COMPRESS_DIM) {
+    throw Fits::FitsError("Tile dimension is greater than " + std::to_string(MAX_COMPRESS_DIM));
+  }
+  int status = 0;
+  fits_set_compression_type(fptr, algorithmCode(compression.algorithm), &status);
+  std::vector<long> tileShape(MAX_COMPRESS_DIM, 0); // 0 for CFitsIO default, i.e. row by row
+  std::copy(compression.tileShape.begin(), compression.tileShape.end(), tileShape.begin());
+  fits_set_tile_dim(fptr, MAX_COMPRESS_DIM, tileShape.data(), &status);
+  fits_set_quantize_level(fptr, compression.quantization, &status); // 0 for lossless
+  fits_set_quantize_method(fptr, ditheringCode(compression.dithering), &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot set image compression parameters");
+}
+
+void resetCompression(fitsfile* fptr) {
+  int status = 0;
+  fits_set_compression_type(fptr, 0, &status);
+  CfitsioError::mayThrow(status, fptr, "Cannot reset image compression");
+}
+
 template <>
 Fits::Position<-1> readShape<-1>(fitsfile* fptr) {
   int status = 0;
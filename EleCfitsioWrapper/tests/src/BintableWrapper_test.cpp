@@ -164,6 +164,15 @@ BOOST_FIXTURE_TEST_CASE(append_columns_test, Fits::Test::MinimalFile) {
   BOOST_TEST(radecs.vector() == table.radecs);
 }
 
+BOOST_AUTO_TEST_CASE(field_byte_count_test) {
+  BOOST_TEST(BintableIo::fieldByteCount("3E") == 12);
+  BOOST_TEST(BintableIo::fieldByteCount("J") == 4);
+  BOOST_TEST(BintableIo::fieldByteCount("10X") == 2);
+  BOOST_TEST(BintableIo::fieldByteCount("1PE(8)") == 8);
+  BOOST_TEST(BintableIo::fieldByteCount("2Z") == -1); // Unknown letter
+  BOOST_TEST(BintableIo::fieldByteCount("") == -1);
+}
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,147 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleCfitsioWrapper/ByteSwap.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+
+using namespace Euclid::Cfitsio;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(ByteSwap_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(big_endian_to_native_test) {
+  const unsigned char bytes[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+  std::int32_t values[2];
+  std::memcpy(values, bytes, sizeof(bytes));
+  bigEndianToNative(values, 2);
+  BOOST_TEST(values[0] == 0x01020304);
+  BOOST_TEST(values[1] == 0x05060708);
+  const unsigned char complexBytes[] = { 0x3F, 0x80, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00 }; // 1 + 2i
+  std::complex<float> c;
+  std::memcpy(&c, complexBytes, sizeof(c));
+  bigEndianToNative(&c, 1);
+  BOOST_TEST(c.real() == 1.F);
+  BOOST_TEST(c.imag() == 2.F);
+}
+
+BOOST_AUTO_TEST_CASE(toggle_sign_bit_test) {
+  std::uint16_t unsignedValues[] = { 0, 0x8000, 0xFFFF };
+  toggleSignBit(unsignedValues, 3);
+  BOOST_TEST(unsignedValues[0] == 0x8000);
+  BOOST_TEST(unsignedValues[1] == 0);
+  BOOST_TEST(unsignedValues[2] == 0x7FFF);
+  signed char signedBytes[] = { 0, 127 };
+  toggleSignBit(signedBytes, 2);
+  BOOST_TEST(signedBytes[0] == -128);
+  BOOST_TEST(signedBytes[1] == -1);
+}
+
+BOOST_AUTO_TEST_CASE(byte_encoding_test) {
+  BOOST_TEST(FitsEncoding<signed char>::letter() == 'B');
+  BOOST_TEST(FitsEncoding<signed char>::zero() == -128.);
+  BOOST_TEST(FitsEncoding<unsigned char>::letter() == 'B');
+  BOOST_TEST(FitsEncoding<unsigned char>::zero() == 0.);
+  BOOST_TEST(FitsEncoding<char>::letter() == 'B');
+  BOOST_TEST(FitsEncoding<char>::zero() == -128.);
+}
+
+BOOST_AUTO_TEST_CASE(decode_field_test) {
+  // 3 rows of { 1B, 2I, 1B } fields, i.e. 6 bytes per row
+  const unsigned char block[] = { 0xFF, 0x00, 0x01, 0x00, 0x02, 0x80, //
+                                  0xFF, 0x00, 0x03, 0x00, 0x04, 0x00, //
+                                  0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x7F };
+  std::int16_t shorts[6];
+  decodeField(block, 3, 6, 1, 2, shorts);
+  BOOST_TEST(shorts[0] == 1);
+  BOOST_TEST(shorts[1] == 2);
+  BOOST_TEST(shorts[2] == 3);
+  BOOST_TEST(shorts[3] == 4);
+  BOOST_TEST(shorts[4] == -1);
+  BOOST_TEST(shorts[5] == 0);
+  char bytes[3];
+  decodeField(block, 3, 6, 5, 1, bytes); // TZERO = -128
+  BOOST_TEST(bytes[0] == 0);
+  BOOST_TEST(bytes[1] == -128);
+  BOOST_TEST(bytes[2] == -1);
+}
+
+BOOST_AUTO_TEST_CASE(encode_decode_field_test) {
+  // 2 rows of { 1V, 2E } fields, i.e. 12 bytes per row
+  const std::uint32_t ints[] = { 0, 0xFFFFFFFF };
+  const float floats[] = { 1.F, -2.F, 3.5F, 0.F };
+  unsigned char block[24] = {};
+  encodeField(ints, 2, 12, 0, 1, block);
+  encodeField(floats, 2, 12, 4, 2, block);
+  BOOST_TEST(block[0] == 0x80); // TZERO = 2^31
+  BOOST_TEST(block[12] == 0x7F);
+  BOOST_TEST(block[4] == 0x3F); // Big-endian 1.F
+  std::uint32_t decodedInts[2];
+  float decodedFloats[4];
+  decodeField(block, 2, 12, 0, 1, decodedInts);
+  decodeField(block, 2, 12, 4, 2, decodedFloats);
+  for (long i = 0; i < 2; ++i) {
+    BOOST_TEST(decodedInts[i] == ints[i]);
+  }
+  for (long i = 0; i < 4; ++i) {
+    BOOST_TEST(decodedFloats[i] == floats[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(encode_decode_bit_field_test) {
+  // 3 rows of { 1B, 11X } fields, i.e. 3 bytes per row
+  const unsigned char bits[] = { 0xB5, 0x9E, 0x3C, 0x7A, 0x80 }; // 33 bits + padding
+  unsigned char block[9] = {};
+  encodeBitField(bits, 0, 3, 3, 1, 11, block);
+  BOOST_TEST(block[1] == 0xB5);
+  BOOST_TEST(block[2] == 0x80); // 100 + padding
+  BOOST_TEST(block[4] == 0xF1); // 11110001
+  BOOST_TEST(block[5] == 0xE0); // 111 + padding
+  unsigned char decoded[5] = {};
+  decodeBitField(block, 3, 3, 1, 11, decoded, 0);
+  for (long i = 0; i < 5; ++i) {
+    BOOST_TEST(decoded[i] == bits[i]);
+  }
+  unsigned char shifted[6] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+  decodeBitField(block, 3, 3, 1, 11, shifted, 5); // Unaligned, surrounding bits are kept
+  BOOST_TEST(shifted[0] == 0xFD); // 11111 + 101
+  BOOST_TEST(shifted[4] == 0xD7); // 110101 + 11
+  BOOST_TEST(shifted[5] == 0xFF); // Untouched
+}
+
+BOOST_AUTO_TEST_CASE(encode_decode_logical_field_test) {
+  // 2 rows of { 3L } fields
+  const unsigned char bits[] = { 0x9C }; // 100 111 + padding
+  unsigned char block[6] = {};
+  encodeLogicalField(bits, 0, 2, 3, 0, 3, block);
+  const std::string expected = "TFFTTT";
+  BOOST_TEST(std::string(block, block + 6) == expected);
+  block[1] = 0; // Null
+  unsigned char decoded[1] = { 0xFF };
+  decodeLogicalField(block, 2, 3, 0, 3, decoded, 0);
+  BOOST_TEST(decoded[0] == 0x9F); // 100 111 + untouched
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -89,6 +89,49 @@ BOOST_FIXTURE_TEST_CASE(region_is_read_back, Fits::Test::MinimalFile) {
   }
 }
 
+BOOST_FIXTURE_TEST_CASE(subraster_is_written_back, Fits::Test::MinimalFile) {
+  Fits::VecRaster<long, 3> image({ 3, 4, 5 });
+  HduAccess::createImageExtension(fptr, "EXT", image);
+  Fits::VecRaster<long, 3> input({ 5, 6, 4 });
+  for (long i = 0; i < input.size(); ++i) {
+    input.data()[i] = i + 1;
+  }
+  const auto full = Fits::Region<3>::fromShape({ 1, 1, 0 }, { 3, 4, 2 }); // Contiguous in the file
+  const auto partial = Fits::Region<3>::fromShape({ 0, 2, 1 }, { 2, 3, 3 }); // Lines with gaps
+  for (const auto& src : { full, partial }) {
+    const Fits::Position<3> dst { 0, 0, src.front[2] + 1 };
+    ImageIo::writeRegion(fptr, Fits::Subraster<long, 3> { input, src }, dst);
+    const auto output = ImageIo::readRegion<long, 3>(fptr, Fits::Region<3>::fromShape(dst, src.shape()));
+    for (const auto& p : Fits::Region<3>::fromShape(Fits::Position<3>::zero(), src.shape())) {
+      BOOST_TEST(output[p] == input[p + src.front]);
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(out_of_bounds_region_throws, Fits::Test::MinimalFile) {
+  Fits::VecRaster<long, 2> image({ 4, 3 });
+  for (long i = 0; i < image.size(); ++i) {
+    image.data()[i] = i + 1;
+  }
+  HduAccess::createImageExtension(fptr, "EXT", image);
+  const auto beyondLine = Fits::Region<2>::fromShape({ 2, 0 }, { 3, 2 }); // Would wrap to the next line
+  const auto beyondImage = Fits::Region<2>::fromShape({ 0, 2 }, { 4, 2 });
+  const auto beforeImage = Fits::Region<2>::fromShape({ -1, 0 }, { 2, 2 });
+  for (const auto& region : { beyondLine, beyondImage, beforeImage }) {
+    BOOST_CHECK_THROW((ImageIo::readRegion<long, 2>(fptr, region)), Fits::OutOfBoundsError);
+    const std::vector<Fits::Region<2>> regions { region };
+    BOOST_CHECK_THROW((ImageIo::readRegions<long, 2>(fptr, regions)), Fits::OutOfBoundsError);
+    BOOST_CHECK_THROW((ImageIo::readRegion<long, 2>(fptr, region, { 1, 1 })), Fits::OutOfBoundsError);
+    BOOST_CHECK_THROW(
+        (ImageIo::readRegion<long, 2>(fptr, region, { 2, 2 }, Fits::Aggregation::Sum)),
+        Fits::OutOfBoundsError);
+    Fits::VecRaster<long, 2> patch(region.shape());
+    BOOST_CHECK_THROW(ImageIo::writeRegion(fptr, patch, region.front), Fits::OutOfBoundsError);
+  }
+  const auto output = ImageIo::readRaster<long, 2>(fptr);
+  BOOST_TEST(output.vector() == image.vector()); // Nothing was overwritten
+}
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -20,15 +20,26 @@
 #ifndef _ELEFITS_BINTABLECOLUMNS_H
 #define _ELEFITS_BINTABLECOLUMNS_H
 
+#include "EleFitsData/BitColumn.h"
 #include "EleFitsData/Column.h"
+#include "EleFitsData/FixedStringColumn.h"
+#include "EleFitsData/NullableColumn.h"
+#include "EleFitsData/VlaColumn.h"
 #include "EleFits/FileMemSegments.h"
+#include "EleFits/TableSchema.h"
 
 #include <fitsio.h>
 #include <functional>
+#include <string>
+#include <vector>
 
 namespace Euclid {
 namespace Fits {
 
+// Forward declaration for BintableColumns::stream()
+template <typename... Ts>
+class BintableStreamReader;
+
 /**
  * @ingroup bintable_handlers
  * @brief Column-wise reader-writer for the binary table data unit.
@@ -42,7 +53,7 @@ namespace Fits {
  * 
  * For reading, new columns can be either returned, or existing columns can be filled.
  * Columns can be specified either by their name or index;
- * using index is faster because names are internally converted to indices anyway, via a read operation.
+ * using index is slightly faster because names are internally converted to indices anyway.
  * When filling an existing column, the name of the column can also be used to specify the column to be read.
  * 
  * When writing, if more rows are needed, they are automatically filled with zeros.
@@ -58,6 +69,13 @@ namespace Fits {
  * It is therefore much more efficient to use those than to chain several calls to methods for single columns.
  * Depending on the table width, the speed-up can reach several orders of magnitude.
  * 
+ * The table schema (column names, formats, repeat counts and units, as well as the row count)
+ * is read once and cached, such that the read and write loops do not parse the header again.
+ * The cache is updated by the methods of this class which modify the schema,
+ * e.g. `init()`, `remove()`, `rename()` or `write()` when rows are appended,
+ * and is invalidated when the file is reopened.
+ * If column keywords are modified by other means (e.g. via the `Header` handler), the cache is outdated.
+ * 
  * Method to read and write columns conform to the following naming convention:
  * - Start with `read` or `write`;
  * - Contain `Segment` for reading or writing segments;
@@ -93,6 +111,9 @@ class BintableColumns {
 
 private:
   friend class BintableHdu;
+  friend class MefFile; // For invalidating the schema at closing
+  template <typename... Ts>
+  friend class BintableStreamReader; // For prefetching
 
   /**
    * @brief Constructor.
@@ -112,9 +133,18 @@ public:
 
   /**
    * @brief Get the current number of rows.
+   * @details
+   * Rows which were reserved but not yet written are not counted.
+   * @see readCapacity()
    */
   long readRowCount() const;
 
+  /**
+   * @brief Get the number of rows of the data unit, including the reserved ones.
+   * @see reserve()
+   */
+  long readCapacity() const;
+
   /**
    * @brief Get the number of rows in the internal buffer.
    * @details
@@ -306,6 +336,289 @@ public:
   template <typename T>
   void readSegmentTo(FileMemSegments rows, long index, Column<T>& column) const;
 
+  /// @}
+  /**
+   * @name Read elements of vector columns.
+   * @details
+   * A subset of the elements of each cell is read into a dense column,
+   * whose repeat count is the number of requested elements, without decoding the other elements.
+   * Elements are given as 0-based indices in the cell, in any order, possibly with duplicates,
+   * and consecutive indices are merged into runs.
+   * The list of elements must not be empty.
+   *
+   * If the runs span few FITS blocks compared to the row width,
+   * each run is read with a single call to CFitsIO per row, starting at the first element of the run.
+   * Otherwise, rows are read by raw blocks, and the runs are extracted and decoded in place,
+   * provided that the column can be decoded from raw bytes.
+   *
+   * Example usage:
+   * \code
+   * // Read bins 0, 10, 20... of a 1000-bin vector column
+   * std::vector<long> elements;
+   * for (long i = 0; i < 1000; i += 10) {
+   *   elements.push_back(i);
+   * }
+   * auto decimated = columns.readElements<float>("PDF", elements);
+   * \endcode
+   */
+  /// @{
+
+  /**
+   * @brief Read some elements of each cell of the vector column with given name.
+   * @param name The column name
+   * @param elements The 0-based indices of the elements to be read in each cell
+   */
+  template <typename T>
+  VecColumn<T> readElements(const std::string& name, const std::vector<long>& elements) const;
+
+  /**
+   * @brief Read some elements of each cell of the vector column with given index.
+   */
+  template <typename T>
+  VecColumn<T> readElements(long index, const std::vector<long>& elements) const;
+
+  /**
+   * @brief Read some elements of each cell of a segment of the vector column with given index.
+   * @param rows The included lower and upper bounds of the row indices to be read
+   */
+  template <typename T>
+  VecColumn<T> readSegmentElements(const Segment& rows, long index, const std::vector<long>& elements) const;
+
+  /// @}
+  /**
+   * @name Read and write fixed-width string columns.
+   * @details
+   * `FixedStringColumn`s store all the strings in a single arena,
+   * and are read and written with one call to CFitsIO per chunk of rows, without per-row allocation.
+   * They can be mixed with `Column`s in the methods which read or write sequences of columns.
+   */
+  /// @{
+
+  /**
+   * @brief Read the string column with given name as a `FixedStringColumn`.
+   */
+  FixedStringColumn readFixedString(const std::string& name) const;
+
+  /**
+   * @brief Read the string column with given index as a `FixedStringColumn`.
+   */
+  FixedStringColumn readFixedString(long index) const;
+
+  /**
+   * @brief Read a segment of the string column with given index into an existing `FixedStringColumn`.
+   */
+  void readSegmentTo(FileMemSegments rows, long index, FixedStringColumn& column) const;
+
+  /**
+   * @brief Write a `FixedStringColumn`.
+   */
+  void write(const FixedStringColumn& column) const;
+
+  /**
+   * @brief Write a segment of a `FixedStringColumn`.
+   */
+  void writeSegment(FileMemSegments rows, const FixedStringColumn& column) const;
+
+  /// @}
+  /**
+   * @name Read and write bit and logical columns.
+   * @details
+   * `BitColumn`s store boolean values as a packed bitset.
+   * They are read from and written to bit (`X`) and logical (`L`) columns by blocks of raw rows,
+   * with byte-wise copies and shifts for bit columns instead of per-value conversions.
+   * Bit columns are initialized with `init<bool>()`, and logical columns with `initLogical()`.
+   */
+  /// @{
+
+  /**
+   * @brief Append or insert a logical column, which was not previously initialized.
+   * @param info The column info
+   * @param index The 0-based column index, which may be >= 0 or -1 to append the column at the end
+   */
+  void initLogical(const ColumnInfo<bool>& info, long index = -1) const;
+
+  /**
+   * @brief Read the bit or logical column with given name as a `BitColumn`.
+   */
+  BitColumn readBits(const std::string& name) const;
+
+  /**
+   * @brief Read the bit or logical column with given index as a `BitColumn`.
+   */
+  BitColumn readBits(long index) const;
+
+  /**
+   * @brief Read a segment of the bit or logical column with given index into an existing `BitColumn`.
+   */
+  void readSegmentTo(FileMemSegments rows, long index, BitColumn& column) const;
+
+  /**
+   * @brief Write a `BitColumn`.
+   */
+  void write(const BitColumn& column) const;
+
+  /**
+   * @brief Write a segment of a `BitColumn`.
+   * @details
+   * Existing rows are read and rewritten as raw bytes, such that the other columns are preserved.
+   */
+  void writeSegment(FileMemSegments rows, const BitColumn& column) const;
+
+  /// @}
+  /**
+   * @name Read and write variable-length array columns.
+   * @details
+   * Variable-length array columns, i.e. columns of `P` or `Q` format, store their values in the heap,
+   * and each cell of the table is a descriptor of the position and size of an entry in the heap.
+   * `VlaColumn`s store all the entries in a single flat buffer.
+   * Reading walks the heap in offset order and merges nearby entries into large heap accesses,
+   * and writing lays out all the entries contiguously in the heap with one call to CFitsIO.
+   */
+  /// @{
+
+  /**
+   * @brief Append or insert a variable-length array column, which was not previously initialized.
+   * @param info The column info, whose repeat count is ignored
+   * @param index The 0-based column index, which may be >= 0 or -1 to append the column at the end
+   */
+  template <typename T>
+  void initVla(const ColumnInfo<T>& info, long index = -1) const;
+
+  /**
+   * @brief Read the variable-length array column with given name.
+   */
+  template <typename T>
+  VlaColumn<T> readVla(const std::string& name) const;
+
+  /**
+   * @brief Read the variable-length array column with given index.
+   */
+  template <typename T>
+  VlaColumn<T> readVla(long index) const;
+
+  /**
+   * @brief Read a segment of the variable-length array column with given index.
+   */
+  template <typename T>
+  VlaColumn<T> readVlaSegment(const Segment& rows, long index) const;
+
+  /**
+   * @brief Read a segment of the variable-length array column with given index, and append it to a `VlaColumn`.
+   */
+  template <typename T>
+  void readVlaSegmentTo(const Segment& rows, long index, VlaColumn<T>& column) const;
+
+  /**
+   * @brief Write a `VlaColumn`.
+   */
+  template <typename T>
+  void write(const VlaColumn<T>& column) const;
+
+  /**
+   * @brief Write a segment of a `VlaColumn`.
+   */
+  template <typename T>
+  void writeSegment(FileMemSegments rows, const VlaColumn<T>& column) const;
+
+  /// @}
+  /**
+   * @name Read and write nullable columns.
+   * @details
+   * Integer columns are null where the raw value equals `TNULLn`,
+   * and floating point columns are null where the value is NaN (or equals the scaled `TNULLn` if any).
+   * Columns are read as raw row blocks, and the validity bitmap is built afterwards in a single pass,
+   * instead of letting CFitsIO check each value.
+   * When writing, null values are replaced with the `TNULLn` value (or NaN) in a single copy.
+   */
+  /// @{
+
+  /**
+   * @brief Append or insert an integer column with a `TNULLn` value.
+   * @param info The column info
+   * @param null The physical null value, e.g. 65535 for a column of `std::uint16_t`
+   * @param index The 0-based column index, which may be >= 0 or -1 to append the column at the end
+   * @details
+   * Floating point columns do not need a `TNULLn` value, and should be initialized with `init()`.
+   */
+  template <typename T>
+  void initNullable(const ColumnInfo<T>& info, T null, long index = -1) const;
+
+  /**
+   * @brief Read the nullable column with given name.
+   */
+  template <typename T>
+  NullableColumn<T> readNullable(const std::string& name) const;
+
+  /**
+   * @brief Read the nullable column with given index.
+   */
+  template <typename T>
+  NullableColumn<T> readNullable(long index) const;
+
+  /**
+   * @brief Write a `NullableColumn`.
+   * @details
+   * Throw if some value is null while the column is neither floating point nor has a `TNULLn` value.
+   */
+  template <typename T>
+  void write(const NullableColumn<T>& column) const;
+
+  /**
+   * @brief Write a segment of a `NullableColumn`.
+   * @copydetails write(const NullableColumn<T>&) const
+   */
+  template <typename T>
+  void writeSegment(FileMemSegments rows, const NullableColumn<T>& column) const;
+
+  /// @}
+  /**
+   * @name Read and write with a table schema.
+   * @details
+   * Columns are looked up by the names of the schema, and may be in any order in the table.
+   * Structs are read and written by blocks of raw rows, and each row is decoded or encoded in a single pass,
+   * if all the columns can be decoded from raw bytes.
+   * Otherwise, each block is read or written as a sequence of columns, and copied from or to the structs.
+   */
+  /// @{
+
+  /**
+   * @brief Read the columns of a schema as a tuple of columns (SoA).
+   */
+  template <typename... TCols>
+  typename TableSchema<TCols...>::Columns readSeq(const TableSchema<TCols...>& schema) const;
+
+  /**
+   * @brief Read all the rows as a vector of structs (AoS).
+   */
+  template <typename TRow, typename TSchema, typename... TMembers>
+  std::vector<TRow> readStructs(const RowBinding<TRow, TSchema, TMembers...>& binding) const;
+
+  /**
+   * @brief Read a segment of rows as a vector of structs (AoS).
+   */
+  template <typename TRow, typename TSchema, typename... TMembers>
+  std::vector<TRow> readStructSegment(const Segment& rows, const RowBinding<TRow, TSchema, TMembers...>& binding) const;
+
+  /**
+   * @brief Write a vector of structs (AoS) from the first row.
+   */
+  template <typename TRow, typename TSchema, typename... TMembers>
+  void writeStructs(const RowBinding<TRow, TSchema, TMembers...>& binding, const std::vector<TRow>& rows) const;
+
+  /**
+   * @brief Write a vector of structs (AoS) from given row.
+   * @param firstRow The 0-based index of the first row to be written
+   * @details
+   * The table is extended if needed.
+   * If the columns of the schema do not cover whole rows, existing rows are read first,
+   * such that the other columns are preserved.
+   */
+  template <typename TRow, typename TSchema, typename... TMembers>
+  void writeStructSegment(
+      long firstRow,
+      const RowBinding<TRow, TSchema, TMembers...>& binding,
+      const std::vector<TRow>& rows) const;
+
   /// @}
   /**
    * @name Read a sequence of columns.
@@ -437,6 +750,213 @@ public:
   template <typename... Ts>
   void readSegmentSeqTo(FileMemSegments rows, const std::vector<long>& indices, Column<Ts>&... columns) const;
 
+  /// @}
+  /**
+   * @name Read a sequence of column segments as raw row blocks.
+   */
+  /// @{
+
+  /**
+   * @brief Read segments of columns into existing `Column`s, by blocks of raw rows.
+   * @details
+   * Instead of letting CFitsIO decode each column separately, contiguous blocks of rows are read as raw bytes
+   * (one read per buffer chunk, independently of the number of columns),
+   * and the fields are transposed and byteswapped into the columns by EleFits.
+   * This is much faster than `readSegmentSeqTo()` for wide tables.
+   * 
+   * Raw decoding is possible when, for each column, the value type matches the type in the file
+   * (e.g. no `float` to `double` conversion), the repeat count matches,
+   * and the column is neither scaled nor offset (except for the standard offsets of unsigned integers).
+   * Other columns, like strings, are read by CFitsIO with `readSegmentTo()`, chunk by chunk.
+   */
+  template <typename TSeq>
+  void readSegmentSeqRawTo(FileMemSegments rows, TSeq&& columns) const;
+
+  /**
+   * @copydoc readSegmentSeqRawTo()
+   */
+  template <typename... Ts>
+  void readSegmentSeqRawTo(FileMemSegments rows, Column<Ts>&... columns) const;
+
+  /**
+   * @brief Read segments of columns specified by their indices into existing `Column`s, by blocks of raw rows.
+   * @copydetails readSegmentSeqRawTo()
+   */
+  template <typename TSeq>
+  void readSegmentSeqRawTo(FileMemSegments rows, const std::vector<long>& indices, TSeq&& columns) const;
+
+  /// @}
+  /**
+   * @name Read a sequence of columns filtered by a predicate.
+   */
+  /// @{
+
+  /**
+   * @brief Read the rows of columns for which a predicate holds on a scalar column.
+   * @param predicateColumn The name of the column on which the predicate is evaluated
+   * @param predicate A function which takes a value of the predicate column and returns a `bool`
+   * @param names The names of the columns to be read
+   * @details
+   * The predicate column is first scanned by chunks of the buffer row count, in order to select rows.
+   * Only the selected rows of the other columns are then read:
+   * the sorted and disjoint segments of selected rows are read in turn,
+   * by blocks of raw rows whenever possible (see `readSegmentSeqRawTo()`),
+   * such that no list of row indices is built and memory usage is bounded by one buffer of rows
+   * in addition to the returned columns.
+   * The returned columns are compact, i.e. they contain only the selected rows, in the file order.
+   * \code
+   * auto res = columns.readWhere(Named<float>("PHZ_MEDIAN"), [](float z) { return z > 1.2; }, Named<long>("ID"));
+   * \endcode
+   * @see readWhereSegments()
+   */
+  template <typename T, typename TPredicate, typename... Ts>
+  std::tuple<VecColumn<Ts>...>
+  readWhere(const Named<T>& predicateColumn, TPredicate&& predicate, const Named<Ts>&... names) const;
+
+  /**
+   * @brief Read the rows of columns specified by their indices for which a predicate holds on a scalar column.
+   * @copydetails readWhere()
+   */
+  template <typename T, typename TPredicate, typename... Ts>
+  std::tuple<VecColumn<Ts>...>
+  readWhere(const Indexed<T>& predicateColumn, TPredicate&& predicate, const Indexed<Ts>&... indices) const;
+
+  /**
+   * @brief Get the ranges of contiguous rows for which a predicate holds on a scalar column.
+   * @details
+   * The column is read by chunks of the buffer row count, such that memory usage is bounded.
+   * The returned segments are sorted and disjoint.
+   * Vector columns are not supported.
+   */
+  template <typename T, typename TPredicate>
+  std::vector<Segment> readWhereSegments(const Indexed<T>& predicateColumn, TPredicate&& predicate) const;
+
+  /// @}
+  /**
+   * @name Read a sequence of columns at given rows.
+   */
+  /// @{
+
+  /**
+   * @brief Read the values of columns at given rows, in any order.
+   * @param rows The 0-based indices of the rows to be read, which may be unsorted and contain duplicates
+   * @param names The names of the columns to be read
+   * @details
+   * This is a gather operation, e.g. for fetching the results of a cross-match:
+   * the row indices are sorted and coalesced into ranges of near-contiguous rows,
+   * which are read by blocks of raw rows whenever possible (see `readSegmentSeqRawTo()`),
+   * and the values are scattered back into the order of the input indices.
+   * Ranges are read through holes of up to the buffer row count,
+   * such that several nearby rows are read with a single call to CFitsIO.
+   * Memory usage is bounded by one buffer of rows per column in addition to the returned columns.
+   */
+  template <typename... Ts>
+  std::tuple<VecColumn<Ts>...> readRows(const std::vector<long>& rows, const Named<Ts>&... names) const;
+
+  /**
+   * @brief Read the values of columns at given rows, with given gap threshold.
+   * @param maxGap The maximum number of unrequested rows read through between two requested rows
+   * @copydetails readRows()
+   */
+  template <typename... Ts>
+  std::tuple<VecColumn<Ts>...>
+  readRows(const std::vector<long>& rows, long maxGap, const Named<Ts>&... names) const;
+
+  /**
+   * @brief Read the values of columns specified by their indices at given rows, with given gap threshold.
+   * @copydetails readRows()
+   */
+  template <typename... Ts>
+  std::tuple<VecColumn<Ts>...>
+  readRows(const std::vector<long>& rows, long maxGap, const Indexed<Ts>&... indices) const;
+
+  /// @}
+  /**
+   * @name Stream a sequence of columns by batches of rows.
+   */
+  /// @{
+
+  /**
+   * @brief Get a range over batches of rows of given columns, aligned to the CFitsIO buffer.
+   * @details
+   * Batches are read with `readSegmentSeqRawTo()` into reusable buffers, such that memory usage is bounded.
+   * The range is compatible with range-based for loops:
+   * \code
+   * for (const auto& batch : columns.stream(Named<int>("ID"), Named<float>("FLUX"))) {
+   *   process(std::get<0>(batch), std::get<1>(batch));
+   * }
+   * \endcode
+   * @see BintableStreamReader
+   */
+  template <typename... Ts>
+  BintableStreamReader<Ts...> stream(const Named<Ts>&... names) const;
+
+  /**
+   * @brief Get a range over batches of rows of given columns, with given batch row count.
+   * @param batchRowCount The number of rows per batch, which is rounded up to a multiple of the buffer row count
+   * @copydetails stream()
+   */
+  template <typename... Ts>
+  BintableStreamReader<Ts...> stream(long batchRowCount, const Named<Ts>&... names) const;
+
+  /**
+   * @brief Get a range over batches of rows of columns specified by their indices, with given batch row count.
+   * @copydetails stream()
+   */
+  template <typename... Ts>
+  BintableStreamReader<Ts...> stream(long batchRowCount, const Indexed<Ts>&... indices) const;
+
+  /// @}
+  /**
+   * @name Insert and remove rows.
+   */
+  /// @{
+
+  /**
+   * @brief Insert zero-initialized rows.
+   * @param index The 0-based index of the first inserted row, or -1 to append rows at the end
+   * @param count The number of rows
+   * @details
+   * When rows are appended by small chunks, the data unit (and following HDUs) is shifted at each append.
+   * Inserting rows by larger chunks beforehand is much faster, which is best done with `reserve()`.
+   */
+  void insertRows(long index, long count) const;
+
+  /**
+   * @brief Remove contiguous rows.
+   * @param index The 0-based index of the first removed row
+   * @param count The number of rows
+   */
+  void removeRows(long index, long count) const;
+
+  /**
+   * @brief Preallocate rows at the end of the data unit, like `std::vector::reserve()`.
+   * @param capacity The minimum number of rows of the data unit
+   * @details
+   * Once this method was called, the row count returned by `readRowCount()` is tracked independently of `NAXIS2`,
+   * and the rows are appended to the reserved space instead of extending the data unit (and shifting following HDUs)
+   * at each write.
+   * When the capacity is exceeded, it is doubled (or increased to the required row count if more).
+   * The rows which are reserved but not written are removed by `shrinkToFit()`,
+   * which is called when the file is closed.
+   * 
+   * Example usage:
+   * \code
+   * columns.reserve(columns.readRowCount() + 1000);
+   * for (const auto& chunk : chunks) {
+   *   columns.writeSegmentSeq(-1, chunk.ids, chunk.fluxes); // Appended without shifting the data unit
+   * }
+   * columns.shrinkToFit(); // Optional
+   * \endcode
+   */
+  void reserve(long capacity) const;
+
+  /**
+   * @brief Remove the rows which were reserved but not written, and stop tracking the row count.
+   * @see reserve()
+   */
+  void shrinkToFit() const;
+
   /// @}
   /**
    * @name Write a single column.
@@ -487,6 +1007,36 @@ public:
   template <typename T>
   void writeSegment(FileMemSegments rows, const Column<T>& column) const;
 
+  /// @}
+  /**
+   * @name Write a single column at given rows.
+   */
+  /// @{
+
+  /**
+   * @brief Write the values of a column at given rows, in any order.
+   * @param rows The 0-based indices of the rows to be written, which may be unsorted
+   * @param column The values, such that the i-th row of the column is written at row `rows[i]` of the table
+   * @details
+   * This is a scatter operation, e.g. for updating a flag or weight column for an arbitrary set of rows:
+   * the row indices are sorted and coalesced into runs of contiguous rows,
+   * each of which is written with a single call to CFitsIO.
+   * Runs are merged through holes of up to the buffer row count,
+   * whose values are read beforehand and written back unchanged (read-modify-write).
+   * If a row index is duplicated, the last value is written.
+   * The rows must exist already (see `insertRows()`).
+   */
+  template <typename T>
+  void writeRows(const std::vector<long>& rows, const Column<T>& column) const;
+
+  /**
+   * @brief Write the values of a column at given rows, with given gap threshold.
+   * @param maxGap The maximum number of rows which are read and written back between two rows to be written
+   * @copydetails writeRows()
+   */
+  template <typename T>
+  void writeRows(const std::vector<long>& rows, long maxGap, const Column<T>& column) const;
+
   /// @}
   /**
    * @name Write a sequence of columns.
@@ -510,6 +1060,8 @@ public:
    * @brief Append or insert a sequence of columns, which were not previously initialized.
    * @param info The column infos
    * @param index The 0-based index of the first column to be added, which may be >= 0 or -1 to append the columns at the end
+   * @details
+   * The data unit is rewritten once, whatever the number of columns.
    */
   template <typename TSeq>
   void initSeq(TSeq&& infos, long index) const;
@@ -522,11 +1074,17 @@ public:
 
   /**
    * @brief Remove a sequence of columns specified by their names.
+   * @details
+   * The new row layout is computed once, and the data unit is rewritten in a single pass,
+   * by chunks of the buffer size, instead of once per column.
    */
   void removeSeq(const std::vector<std::string>& names) const;
 
   /**
    * @brief Remove a sequence of columns specified by their indices.
+   * @details
+   * Indices are those of the table before the removal, and may be given in any order.
+   * @copydetails removeSeq(const std::vector<std::string>&)
    */
   void removeSeq(const std::vector<long>& indices) const;
 
@@ -542,6 +1100,12 @@ public:
    * @param columns The columns to be written
    * Segments can be written in already initialized columns with `writeSegmentSeq()`
    * or in new columns with `appendSegmentSeq()`.
+   * 
+   * Columns which could be read with `readSegmentSeqRawTo()` are encoded by EleFits as blocks of raw rows,
+   * and each block is written with a single call to CFitsIO.
+   * Columns are encoded concurrently, by a pool of threads.
+   * Other columns (e.g. strings) are written by CFitsIO, column after column.
+   * If the columns do not cover the whole table, existing rows are read first, such that other fields are preserved.
    */
   template <typename TSeq>
   void writeSegmentSeq(FileMemSegments rows, TSeq&& columns) const;
@@ -554,6 +1118,159 @@ public:
 
   /// @}
 
+private:
+  /**
+   * @brief The cached table schema.
+   */
+  struct Schema {
+
+    /**
+     * @brief The column names.
+     */
+    std::vector<std::string> names;
+
+    /**
+     * @brief The column formats, as `TFORMn` values.
+     */
+    std::vector<std::string> tforms;
+
+    /**
+     * @brief The column repeat counts.
+     */
+    std::vector<long> repeatCounts;
+
+    /**
+     * @brief The column units.
+     */
+    std::vector<std::string> units;
+
+    /**
+     * @brief The column cell shapes, as `TDIMn` values, or empty for flat cells.
+     */
+    std::vector<Position<-1>> shapes;
+
+    /**
+     * @brief The column scalings, as `TSCALn` values.
+     */
+    std::vector<double> scales;
+
+    /**
+     * @brief The column offsets, as `TZEROn` values.
+     */
+    std::vector<double> zeros;
+
+    /**
+     * @brief The positions of the fields in a row, in bytes.
+     * @details
+     * A position is -1 if it follows a field of unknown `TFORMn`, in which case the column is not raw-decodable.
+     */
+    std::vector<long> byteOffsets;
+
+    /**
+     * @brief The number of bytes per row.
+     */
+    long rowWidth = 0;
+
+    /**
+     * @brief The number of rows, which may be less than `NAXIS2` if rows were reserved.
+     */
+    long rowCount = 0;
+
+    /**
+     * @brief The number of rows of the data unit, i.e. `NAXIS2`.
+     */
+    long capacity = 0;
+
+    /**
+     * @brief The number of rows in the CFitsIO buffer.
+     */
+    long bufferRowCount = 0;
+  };
+
+  /**
+   * @brief Touch the HDU and get the schema, which is read if not cached.
+   */
+  const Schema& schema() const;
+
+  /**
+   * @brief Invalidate the schema after a structural modification, or when the file pointer changes.
+   * @details
+   * The file pointer changes when the file is closed and reopened,
+   * or when the uncompressed buffer of a tile-compressed table is released.
+   */
+  void invalidateSchema() const;
+
+  /**
+   * @brief Update the cached row count after some rows were written.
+   * @param lastRow The 0-based index of the last written row
+   */
+  void updateRowCount(long lastRow) const;
+
+  /**
+   * @brief Grow the capacity geometrically if rows were reserved and given row is out of it.
+   * @param lastRow The 0-based index of the last row to be written
+   */
+  void growCapacity(long lastRow) const;
+
+  /**
+   * @brief Check whether a column can be decoded from or encoded to raw bytes as a given type.
+   * @details
+   * This is the case if the type matches the `TFORMn` letter, the repeat count matches,
+   * and the column is neither scaled nor offset, except for the standard offset of unsigned integers.
+   */
+  template <typename T>
+  bool isRawCodable(long index, long repeatCount) const;
+
+  /**
+   * @brief Read a list of file segments into consecutive rows of existing `Column`s, by blocks of raw rows.
+   * @param fileRows The in-file segments
+   * @param memoryIndex The in-memory index of the first row of the first segment
+   * @details
+   * Decodability is checked once, and the row block is allocated once, whatever the number of segments.
+   * Columns which cannot be decoded from raw bytes are read with `readSegmentTo()`, chunk by chunk.
+   * If no column can be decoded, the segments are read with `readSegmentSeqTo()`.
+   */
+  template <typename TSeq>
+  void readSegmentsRawTo(
+      const std::vector<Segment>& fileRows,
+      long memoryIndex,
+      const std::vector<long>& indices,
+      TSeq&& columns) const;
+
+  /**
+   * @brief Write a column segment to the column with given index.
+   */
+  template <typename T>
+  void writeSegmentImpl(FileMemSegments rows, long index, const Column<T>& column) const;
+
+  /**
+   * @brief Write a segment of a `FixedStringColumn` to the column with given index.
+   */
+  void writeSegmentImpl(FileMemSegments rows, long index, const FixedStringColumn& column) const;
+
+  /**
+   * @brief Get the `TFORMn` letter of a bit or logical column, and throw if the column is neither or the shapes differ.
+   */
+  char bitLetter(long index, long repeatCount) const;
+
+  /**
+   * @brief Read the physical `TNULLn` value of a column.
+   * @return `false` if there is no `TNULLn` record, in which case `null` is unchanged
+   */
+  template <typename T>
+  bool readNullValue(long index, T& null) const;
+
+  /**
+   * @brief Read the indices of the columns of a schema, and check whether they can all be decoded from raw bytes.
+   */
+  template <typename... TCols>
+  bool readSchemaIndices(const TableSchema<TCols...>& schema, std::vector<long>& indices) const;
+
+  /**
+   * @brief Insert a column with given format.
+   */
+  void initImpl(const std::string& name, const std::string& tform, const std::string& unit, long index) const;
+
 private:
   /**
    * @brief The fitsfile.
@@ -569,6 +1286,23 @@ private:
    * @brief The function to declare that the header was edited.
    */
   std::function<void(void)> m_edit;
+
+  /**
+   * @brief The cached schema.
+   */
+  mutable Schema m_schema;
+
+  /**
+   * @brief Whether the cached schema is up-to-date.
+   */
+  mutable bool m_schemaIsValid;
+
+  /**
+   * @brief The number of rows in use if rows were reserved, or -1.
+   * @details
+   * Unlike the schema, it is preserved when the schema is invalidated.
+   */
+  mutable long m_usedRowCount;
 };
 
 /**
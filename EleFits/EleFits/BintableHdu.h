@@ -23,6 +23,7 @@
 #include "EleCfitsioWrapper/BintableWrapper.h"
 #include "EleFits/BintableColumns.h"
 #include "EleFits/Hdu.h"
+#include "EleFitsData/TableCompression.h"
 
 #include <string>
 
@@ -32,6 +33,12 @@ namespace Fits {
 /**
  * @ingroup bintable_handlers
  * @brief Binary table HDU reader-writer.
+ * @details
+ * Tile-compressed binary tables are handled transparently:
+ * the data unit is uncompressed in memory at first access through `columns()`,
+ * and compressed back at `flush()` (which is called when the file is closed) if it was edited.
+ * The header unit is that of the compressed table.
+ * @see MefFile::initBintableExt(const std::string&, const TableCompression&, const ColumnInfo<Ts>&...)
  */
 class BintableHdu : public Hdu {
 
@@ -43,6 +50,19 @@ public:
    */
   BintableHdu(Token, fitsfile*& fptr, long index, HduCategory status = HduCategory::Untouched);
 
+  /**
+   * @brief Constructor for tile-compressed binary tables.
+   * @param compression The compression parameters, to be used by `flush()`
+   * @param buffer The uncompressed table in memory (owned by the HDU), or `nullptr` to uncompress at first access
+   */
+  BintableHdu(
+      Token,
+      fitsfile*& fptr,
+      long index,
+      HduCategory status,
+      TableCompression compression,
+      fitsfile* buffer = nullptr);
+
   /**
    * @see Hdu
    */
@@ -52,8 +72,40 @@ public:
 
   /**
    * @brief Destructor.
+   * @details
+   * The uncompressed table, if any, is discarded: `flush()` should have been called before.
+   */
+  virtual ~BintableHdu();
+
+  /**
+   * @brief Non-copyable, because the uncompressed table is owned.
+   */
+  BintableHdu(const BintableHdu&) = delete;
+
+  /**
+   * @brief Non-copyable, because the uncompressed table is owned.
+   */
+  BintableHdu& operator=(const BintableHdu&) = delete;
+
+  /**
+   * @brief Check whether the binary table is tile-compressed.
+   */
+  bool isCompressed() const;
+
+  /**
+   * @brief Get the compression parameters of a tile-compressed binary table.
+   */
+  const TableCompression& compression() const;
+
+  /**
+   * @brief Compress back the data unit of a tile-compressed binary table, if it was edited.
+   * @details
+   * This is a no-op for raw binary tables.
+   * The whole table is compressed again, which is expensive:
+   * this method is called by `MefFile::close()` and there is generally no need to call it explicitly.
+   * The uncompressed table is then released, and will be uncompressed again at next access, if any.
    */
-  virtual ~BintableHdu() = default;
+  void flush() const;
 
   /**
    * @brief Access the data unit column-wise.
@@ -95,8 +147,40 @@ public:
   void writeColumn(const Column<T>& column) const;
 
 private:
+  /**
+   * @brief Set the current HDU to this one, and uncompress the data unit if needed.
+   */
+  void touchBuffer() const;
+
+  /**
+   * @brief Set the current HDU to this one for writing, and uncompress the data unit if needed.
+   */
+  void editBuffer() const;
+
+  /**
+   * @brief Whether the binary table is tile-compressed.
+   */
+  bool m_compressed;
+
+  /**
+   * @brief The compression parameters.
+   */
+  TableCompression m_compression;
+
+  /**
+   * @brief The uncompressed table in memory, or `nullptr`.
+   */
+  mutable fitsfile* m_buffer;
+
+  /**
+   * @brief Whether the uncompressed table was edited since the last `flush()`.
+   */
+  mutable bool m_bufferEdited;
+
   /**
    * @brief The column-wise data unit handler.
+   * @details
+   * It operates on the uncompressed table if the binary table is tile-compressed.
    */
   BintableColumns m_columns;
 };
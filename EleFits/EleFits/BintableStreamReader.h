@@ -0,0 +1,228 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITS_BINTABLESTREAMREADER_H
+#define _ELEFITS_BINTABLESTREAMREADER_H
+
+#include "EleFits/BintableColumns.h"
+#include "EleFitsUtils/Prefetcher.h"
+
+#include <iterator>
+#include <tuple>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup bintable_handlers
+ * @brief Range of row batches of a binary table, read with bounded memory.
+ * @details
+ * Iterating over the range reads the table batch after batch into reusable buffers,
+ * with `BintableColumns::readSegmentSeqRawTo()`,
+ * and yields tuples of `PtrColumn`s which view the buffers.
+ * The data unit is therefore read in a single pass, and memory usage is independent of the table length.
+ * 
+ * The batch row count is a multiple of the number of rows in the CFitsIO buffer.
+ * All the batches are full, except maybe the last one.
+ * 
+ * Example usage:
+ * \code
+ * for (const auto& batch : columns.stream(Named<int>("ID"), Named<float>("FLUX"))) {
+ *   const auto& ids = std::get<0>(batch);
+ *   const auto& fluxes = std::get<1>(batch);
+ *   for (long i = 0; i < ids.rowCount(); ++i) {
+ *     process(ids.vector()[i], fluxes.vector()[i]);
+ *   }
+ * }
+ * \endcode
+ * 
+ * Optionally, `prefetch()` enables read-ahead:
+ * the next batches are read and decoded by a background thread while the current batch is processed.
+ * 
+ * @warning
+ * The views are invalidated when the iterator is incremented.
+ * @see BintableColumns::stream()
+ */
+template <typename... Ts>
+class BintableStreamReader {
+
+public:
+  /**
+   * @brief The type of the batches.
+   */
+  using Batch = std::tuple<PtrColumn<Ts>...>;
+
+  /**
+   * @brief The type of the buffers.
+   */
+  using Buffer = std::tuple<VecColumn<Ts>...>;
+
+  /**
+   * @brief Input iterator over the batches.
+   */
+  class Iterator : public std::iterator<std::input_iterator_tag, const Batch> {
+
+  public:
+    /**
+     * @brief Create an iterator to the batch which starts at given row.
+     */
+    Iterator(BintableStreamReader& reader, long front);
+
+    /**
+     * @brief Get the current batch.
+     */
+    const Batch& operator*() const;
+
+    /**
+     * @brief Access the current batch.
+     */
+    const Batch* operator->() const;
+
+    /**
+     * @brief Read the next batch.
+     */
+    Iterator& operator++();
+
+    /**
+     * @brief Check whether two iterators point to the same batch.
+     */
+    bool operator==(const Iterator& rhs) const;
+
+    /**
+     * @brief Check whether two iterators point to different batches.
+     */
+    bool operator!=(const Iterator& rhs) const;
+
+  private:
+    /**
+     * @brief The reader.
+     */
+    BintableStreamReader* m_reader;
+
+    /**
+     * @brief The index of the first row of the current batch.
+     */
+    long m_front;
+
+    /**
+     * @brief The current batch.
+     */
+    Batch m_batch;
+  };
+
+  /**
+   * @brief Create a range over given columns.
+   * @param columns The binary table data unit handler
+   * @param batchRowCount The number of rows per batch, which is rounded up to a multiple of the buffer row count
+   * @param indices The indices of the columns
+   */
+  BintableStreamReader(const BintableColumns& columns, long batchRowCount, const Indexed<Ts>&... indices);
+
+  /**
+   * @brief Get the number of rows per batch.
+   */
+  long batchRowCount() const;
+
+  /**
+   * @brief Get the number of rows of the table.
+   */
+  long rowCount() const;
+
+  /**
+   * @brief Enable read-ahead by a background thread.
+   * @param queueDepth The number of batches in memory, e.g. 2 for double buffering
+   * @return True if read-ahead is enabled
+   * @details
+   * The background thread reads the file through its own file stream,
+   * and decodes the raw rows as `BintableColumns::readSegmentSeqRawTo()` does.
+   * If the columns cannot be decoded from raw rows (e.g. string columns),
+   * or if the file is not a plain disk file (e.g. a gzipped file or a tile-compressed table),
+   * batches are read synchronously.
+   * This method must be called before iterating, and the range can then be iterated only once.
+   */
+  bool prefetch(long queueDepth = 2);
+
+  /**
+   * @brief Get the read-ahead metrics, e.g. the time spent waiting for the background thread.
+   */
+  PrefetchMetrics metrics() const;
+
+  /**
+   * @brief Read the first batch and get an iterator to it.
+   */
+  Iterator begin();
+
+  /**
+   * @brief Get the end iterator.
+   */
+  Iterator end();
+
+private:
+  /**
+   * @brief Round a batch row count up to a multiple of the buffer row count.
+   */
+  static long alignBatchRowCount(const BintableColumns& columns, long batchRowCount);
+
+  /**
+   * @brief Read the batch which starts at given row.
+   */
+  Batch read(long front);
+
+  /**
+   * @brief Create views of the first rows of a buffer.
+   */
+  template <std::size_t... Is>
+  Batch view(Buffer& buffer, long size, std::index_sequence<Is...>);
+
+  /**
+   * @brief The binary table data unit handler.
+   */
+  const BintableColumns& m_columns;
+
+  /**
+   * @brief The column indices.
+   */
+  std::vector<long> m_indices;
+
+  /**
+   * @brief The buffer.
+   */
+  Buffer m_buffer;
+
+  /**
+   * @brief The number of rows of the table.
+   */
+  long m_rowCount;
+
+  /**
+   * @brief The read-ahead engine, if enabled.
+   */
+  std::unique_ptr<Prefetcher<Buffer>> m_prefetcher;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITS_BINTABLESTREAMREADER_IMPL
+#include "EleFits/impl/BintableStreamReader.hpp"
+#undef _ELEFITS_BINTABLESTREAMREADER_IMPL
+/// @endcond
+
+#endif
@@ -0,0 +1,190 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITS_BINTABLESTREAMWRITER_H
+#define _ELEFITS_BINTABLESTREAMWRITER_H
+
+#include "EleFits/BintableColumns.h"
+
+#include <tuple>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup bintable_handlers
+ * @brief Writer which appends rows to a binary table with bounded memory.
+ * @details
+ * Rows are appended one by one or by batches, and buffered in columns of `batchRowCount()` rows,
+ * which are written with `BintableColumns::writeSegmentSeq()` when full.
+ * Batches larger than the buffer are written directly, without copy.
+ * Memory usage is therefore independent of the table length.
+ * 
+ * To avoid shifting the data unit (and following HDUs) at each write,
+ * rows are reserved with `BintableColumns::reserve()`, such that the capacity is doubled when needed,
+ * and the unused rows are removed by `close()`, which is called by the destructor.
+ * 
+ * Example usage:
+ * \code
+ * auto writer = f.initBintableStream("CATALOG", ColumnInfo<int> { "ID" }, ColumnInfo<float> { "FLUX", "erg" });
+ * for (const auto& source : sources) {
+ *   writer.appendRow(source.id, source.flux);
+ * }
+ * writer.close();
+ * \endcode
+ * 
+ * @warning
+ * The writer keeps a reference to the columns handler, which is owned by the file object:
+ * it must not outlive the file object, and must be closed or destroyed before the file is closed.
+ * Errors which occur when closing are logged by the destructor: call `close()` explicitly to handle them.
+ * @see MefFile::initBintableStream()
+ */
+template <typename... Ts>
+class BintableStreamWriter {
+
+public:
+  /**
+   * @brief Create a writer which appends rows to given columns of a binary table.
+   * @param columns The binary table data unit handler
+   * @param infos The infos of the columns to be written, which must exist in the table
+   * @details
+   * The batch row count is the number of rows in the CFitsIO buffer.
+   */
+  BintableStreamWriter(const BintableColumns& columns, const ColumnInfo<Ts>&... infos);
+
+  /**
+   * @brief Move constructor.
+   */
+  BintableStreamWriter(BintableStreamWriter&& other);
+
+  /**
+   * @brief Destructor, which closes the writer, and logs errors instead of throwing.
+   */
+  ~BintableStreamWriter();
+
+  /**
+   * @brief Get the number of rows of the buffer.
+   */
+  long batchRowCount() const;
+
+  /**
+   * @brief Get the number of rows of the table, including the buffered rows but not the preallocated ones.
+   */
+  long rowCount() const;
+
+  /**
+   * @brief Get the number of rows of the data unit, including the preallocated ones.
+   */
+  long capacity() const;
+
+  /**
+   * @brief Append a row of scalar values.
+   * @details
+   * The row is buffered, and the buffer is flushed when full.
+   * Throws if some column has a repeat count greater than one (except string columns),
+   * in which case `appendBatch()` should be used.
+   */
+  void appendRow(const Ts&... values);
+
+  /**
+   * @brief Append a batch of rows.
+   * @details
+   * Columns must have the same number of rows.
+   * If the batch does not fit into the buffer, the buffer is flushed,
+   * and batches which are larger than the buffer are written directly.
+   */
+  void appendBatch(const Column<Ts>&... columns);
+
+  /**
+   * @brief Write the buffered rows.
+   */
+  void flush();
+
+  /**
+   * @brief Flush the buffer and remove the preallocated rows.
+   * @details
+   * Once closed, the writer cannot be used anymore.
+   */
+  void close();
+
+private:
+  /**
+   * @brief Write rows at the end of the table.
+   */
+  template <typename TSeq>
+  void writeRows(TSeq&& columns, long count);
+
+  /**
+   * @brief Copy a batch into the buffer.
+   */
+  template <std::size_t... Is>
+  void bufferBatch(const std::tuple<const Column<Ts>&...>& columns, long count, std::index_sequence<Is...>);
+
+  /**
+   * @brief Copy a row into the buffer.
+   */
+  template <std::size_t... Is>
+  void bufferRow(const std::tuple<const Ts&...>& values, std::index_sequence<Is...>);
+
+  /**
+   * @brief Throw if the writer is closed.
+   */
+  void mayThrowClosed() const;
+
+  /**
+   * @brief The binary table data unit handler.
+   */
+  const BintableColumns& m_columns;
+
+  /**
+   * @brief The buffer.
+   */
+  std::tuple<VecColumn<Ts>...> m_buffer;
+
+  /**
+   * @brief The number of rows in the buffer.
+   */
+  long m_bufferedRowCount;
+
+  /**
+   * @brief The number of rows which were written to the data unit.
+   */
+  long m_writtenRowCount;
+
+  /**
+   * @brief Whether all the columns are scalar.
+   */
+  bool m_isScalar;
+
+  /**
+   * @brief Whether the writer is open.
+   */
+  bool m_isOpen;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITS_BINTABLESTREAMWRITER_IMPL
+#include "EleFits/impl/BintableStreamWriter.hpp"
+#undef _ELEFITS_BINTABLESTREAMWRITER_IMPL
+/// @endcond
+
+#endif
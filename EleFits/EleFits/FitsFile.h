@@ -136,7 +136,7 @@ public:
    * @details
    * Files opened with `FileMode::Temporary` are deleted after closing by this method.
    */
-  void close();
+  virtual void close();
 
   /**
    * @brief Close and delete the file.
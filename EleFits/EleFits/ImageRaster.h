@@ -22,6 +22,7 @@
 
 #include "EleFitsData/Raster.h"
 #include "EleFits/FileMemRegions.h"
+#include "EleFitsUtils/Prefetcher.h"
 
 #include <fitsio.h>
 #include <functional>
@@ -29,6 +30,10 @@
 namespace Euclid {
 namespace Fits {
 
+// Forward declaration for ImageRaster::tiles()
+template <typename T, long n>
+class ImageTiles;
+
 /**
  * @ingroup image_handlers
  * @brief Reader-writer for the image data unit.
@@ -46,6 +51,8 @@ namespace Fits {
 class ImageRaster {
 private:
   friend class ImageHdu;
+  template <typename T, long n>
+  friend class ImageTiles;
 
   /**
    * @brief Constructor.
@@ -167,6 +174,87 @@ public:
   template <typename T, long m, long n>
   void readRegionTo(FileMemRegions<n> regions, Raster<T, m>& raster) const;
 
+  /**
+   * @brief Read every `step[i]`-th pixel along each axis `i` of a region, e.g. for quick-look images.
+   * @param region The in-file region
+   * @param step The decimation step along each axis, which must be positive
+   * @details
+   * The shape of the returned raster is `(region.shape() + step - 1) / step`.
+   * The skipped pixels are not transferred to memory:
+   * \code
+   * const auto preview = image.readRegion<float, 2>(Region<2>::fromShape({ 0, 0 }, image.readShape<2>()), { 8, 8 });
+   * \endcode
+   */
+  template <typename T, long m = 2, long n>
+  VecRaster<T, m> readRegion(const Region<n>& region, const Position<n>& step) const;
+
+  /**
+   * @brief Read a region binned by blocks of pixels, e.g. to rebin a detector image.
+   * @param region The in-file region
+   * @tparam T The type of the binned pixels, which may differ from the image type
+   * @param binShape The shape of the blocks, which must be positive
+   * @param aggregation The operation which reduces each block to a pixel
+   * @details
+   * The shape of the returned raster is `(region.shape() + binShape - 1) / binShape`:
+   * blocks on the upper edges of the region may be smaller.
+   * Pixels are aggregated as `double`s, and the results are saturated to the range of `T`,
+   * such that `T` should be wide enough for the aggregation, e.g. to sum 8-bit pixels:
+   * \code
+   * const auto counts = image.readRegion<std::int64_t, 2>(region, { 8, 8 }, Aggregation::Sum);
+   * \endcode
+   * The lines are aggregated as they are read, such that the full-resolution region is never held in memory:
+   * \code
+   * const auto binned = image.readRegion<float, 2>(region, { 4, 4 }, Aggregation::Mean);
+   * \endcode
+   */
+  template <typename T, long m = 2, long n>
+  VecRaster<T, m> readRegion(const Region<n>& region, const Position<n>& binShape, Aggregation aggregation) const;
+
+  /**
+   * @brief Read a list of regions, e.g. postage stamps around sources, as new `VecRaster`s.
+   * @param regions The in-file regions, in any order, possibly overlapping
+   * @return The rasters, in the order of the regions
+   * @details
+   * Instead of reading each region independently, the lines of all the regions are sorted by position in the file,
+   * and nearby or overlapping lines are read once, with a single call to CFitsIO, and then distributed to the rasters.
+   * The file is therefore traversed once, mostly sequentially, whatever the number of regions:
+   * \code
+   * std::vector<Region<2>> stamps;
+   * for (const auto& source : sources) {
+   *   stamps.push_back(Region<2>::fromShape(source.position - 32, { 64, 64 }));
+   * }
+   * const auto rasters = image.readRegions<float, 2>(stamps);
+   * \endcode
+   */
+  template <typename T, long m = 2, long n>
+  std::vector<VecRaster<T, m>> readRegions(const std::vector<Region<n>>& regions) const;
+
+  /**
+   * @brief Read a sequence of regions with read-ahead.
+   * @param regions The in-file regions
+   * @param queueDepth The number of rasters in memory, e.g. 2 for double buffering
+   * @details
+   * The regions are read by a background thread, through its own file stream,
+   * while the caller processes the previous ones, which are retrieved in order with `Prefetcher::next()`:
+   * \code
+   * auto prefetcher = image.prefetchRegions<float, 2>(regions);
+   * for (std::size_t i = 0; i < regions.size(); ++i) {
+   *   const auto& raster = prefetcher.next();
+   *   process(raster);
+   * }
+   * \endcode
+   * 
+   * Like `BintableStreamReader::prefetch()`, read-ahead is possible only if the raw values can be decoded as `T`,
+   * i.e. if `BITPIX` matches `T` and the image is neither scaled nor offset
+   * (except for the standard offsets of unsigned integers).
+   * It also requires a plain disk file, e.g. not gzipped.
+   * Otherwise, the regions are read synchronously with `readRegion()`, by `Prefetcher::next()`.
+   * 
+   * The data unit should not be modified while the prefetcher is alive.
+   */
+  template <typename T, long m = -1, long n>
+  Prefetcher<VecRaster<T, m>> prefetchRegions(const std::vector<Region<n>>& regions, long queueDepth = 2) const;
+
   /// @}
   /**
    * @name Write the whole data unit.
@@ -212,6 +300,46 @@ public:
   void writeRegion(FileMemRegions<n> regions, const Raster<T, m>& raster) const; // TODO return bool = isContiguous()?
 
   /// @}
+  /**
+   * @name Process the data unit tile by tile.
+   */
+  /// @{
+
+  /**
+   * @brief Iterate over the tiles of the data unit, with bounded memory.
+   * @param tileShape The tile shape, without halo
+   * @param overlap The halo width along each axis, e.g. the kernel radius for convolutions
+   * @details
+   * Tiles are visited in file order, and read, halo included, into a single buffer.
+   * Tiles of the upper edges may be smaller, and halos are clipped to the image bounds.
+   * @see ImageTiles
+   */
+  template <typename T, long n>
+  ImageTiles<T, n> tiles(const Position<n>& tileShape, const Position<n>& overlap) const;
+
+  /**
+   * @brief Iterate over the tiles of the data unit without halo.
+   */
+  template <typename T, long n>
+  ImageTiles<T, n> tiles(const Position<n>& tileShape) const;
+
+  /**
+   * @brief Iterate over the tiles of the data unit, and write them back.
+   * @details
+   * Same as `tiles()`, except that the tiles (without halo) are written to the data unit
+   * when the iterator is incremented, or when the range is destroyed.
+   * @see ImageTiles
+   */
+  template <typename T, long n>
+  ImageTiles<T, n> editTiles(const Position<n>& tileShape, const Position<n>& overlap) const;
+
+  /**
+   * @brief Iterate over the tiles of the data unit without halo, and write them back.
+   */
+  template <typename T, long n>
+  ImageTiles<T, n> editTiles(const Position<n>& tileShape) const;
+
+  /// @}
 
 private:
   /**
@@ -0,0 +1,387 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITS_IMAGETILES_H
+#define _ELEFITS_IMAGETILES_H
+
+#include "EleFits/ImageRaster.h"
+
+#include <iterator>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup image_handlers
+ * @brief Range of tiles which cover an image data unit, for processing images larger than memory.
+ * @tparam T The pixel value type
+ * @tparam n The image dimension
+ * @details
+ * The image is split into tiles of given shape (tiles of the upper edges may be smaller),
+ * which are visited in file order, i.e. first along axis 0, then axis 1, and so on,
+ * such that I/Os are mostly sequential, and even contiguous when the tiles span whole lines.
+ * 
+ * Each tile can be extended with a halo of `overlap[i]` pixels on both sides of each axis `i`,
+ * e.g. for convolution-type kernels, which need neighboring pixels.
+ * The halo is clipped to the image bounds, and read along with the tile.
+ * 
+ * Tiles are read into a single buffer, which is allocated once for the largest tile and reused,
+ * such that memory usage is independent of the image size.
+ * In write-back mode, the pixels of the core of each tile (i.e. the tile without its halo) are written to the data unit
+ * once no later halo overlaps them, such that halos always contain input pixels, even with in-place kernels.
+ * When the iterator moves to the next tile, the interior of the core is written straight away.
+ * Only the margins which later halos overlap, i.e. the upper `overlap[i]` pixels along each axis `i`,
+ * are held back meanwhile, in a pool of strips which is allocated once by the constructor.
+ * The pool amounts to about `ceil(overlap[n - 1] / tileShape[n - 1])` layers of strips along the last axis,
+ * each of which is `overlap[n - 1]` pixels thick.
+ * The remaining strips are written by `flush()`, which is called by the destructor;
+ * call it explicitly to get the errors, which the destructor can only log.
+ * 
+ * The range is single-pass: tiles are loaded by the iterator, and the current tile is invalidated by increments.
+ * Example usages:
+ * \code
+ * // Apply a gain in place
+ * for (auto& tile : du.editTiles<float, 2>({ 2048, 64 })) {
+ *   for (const auto& p : tile.region()) {
+ *     tile[p] *= gain;
+ *   }
+ * }
+ * 
+ * // Smooth an image into another one, with a 3x3 kernel
+ * for (const auto& tile : input.tiles<float, 2>({ 2048, 64 }, { 1, 1 })) {
+ *   VecRaster<float, 2> smoothed(tile.region().shape());
+ *   for (const auto& p : tile.region()) {
+ *     smoothed[p - tile.region().front] = mean3x3(tile, p); // Reads tile[p + d] for d in [-1, 1]^2
+ *   }
+ *   output.writeRegion<float, 2, 2>(tile.region().front, smoothed);
+ * }
+ * \endcode
+ * 
+ * The data unit should not be resized while the range is alive.
+ * @see ImageRaster::tiles()
+ * @see ImageRaster::editTiles()
+ */
+template <typename T, long n = 2>
+class ImageTiles {
+
+public:
+  /**
+   * @brief A tile and its halo, loaded in memory.
+   */
+  class Tile {
+    friend class ImageTiles<T, n>;
+
+  public:
+    /**
+     * @brief Get the in-file region of the tile, without halo.
+     */
+    const Region<n>& region() const {
+      return m_region;
+    }
+
+    /**
+     * @brief Get the in-file region of the tile, including the halo.
+     */
+    const Region<n>& haloRegion() const {
+      return m_haloRegion;
+    }
+
+    /**
+     * @brief Get the pixels of the tile, including the halo.
+     * @details
+     * The raster is a view of the buffer: it is invalidated when the iterator is incremented.
+     */
+    const PtrRaster<T, n>& raster() const {
+      return m_raster;
+    }
+
+    /**
+     * @copydoc raster()
+     */
+    PtrRaster<T, n>& raster() {
+      return m_raster;
+    }
+
+    /**
+     * @brief Access the pixel at a given in-file position, which must belong to the halo region.
+     */
+    const T& operator[](const Position<n>& position) const {
+      return m_raster[position - m_haloRegion.front];
+    }
+
+    /**
+     * @copydoc operator[]()
+     */
+    T& operator[](const Position<n>& position) {
+      return m_raster[position - m_haloRegion.front];
+    }
+
+  private:
+    /**
+     * @brief Constructor.
+     */
+    Tile(const Position<n>& shape, T* data) : m_region(), m_haloRegion(), m_raster(shape, data) {}
+
+    /**
+     * @brief The in-file region without halo.
+     */
+    Region<n> m_region;
+
+    /**
+     * @brief The in-file region with halo.
+     */
+    Region<n> m_haloRegion;
+
+    /**
+     * @brief The view of the buffer.
+     */
+    PtrRaster<T, n> m_raster;
+  };
+
+  /**
+   * @brief Input iterator over the tiles.
+   */
+  class Iterator : public std::iterator<std::input_iterator_tag, Tile> {
+
+  public:
+    /**
+     * @brief Constructor.
+     */
+    Iterator(ImageTiles<T, n>& tiles, long index) : m_tiles(&tiles), m_index(index) {}
+
+    /**
+     * @brief Dereference operator.
+     */
+    Tile& operator*() const {
+      return m_tiles->m_tile;
+    }
+
+    /**
+     * @brief Arrow operator.
+     */
+    Tile* operator->() const {
+      return &m_tiles->m_tile;
+    }
+
+    /**
+     * @brief Increment operator, which writes back the current tile if needed, and loads the next one.
+     */
+    Iterator& operator++() {
+      ++m_index;
+      m_tiles->load(m_index);
+      return *this;
+    }
+
+    /**
+     * @brief Equality operator.
+     */
+    bool operator==(const Iterator& rhs) const {
+      return m_tiles == rhs.m_tiles && m_index == rhs.m_index;
+    }
+
+    /**
+     * @brief Non-equality operator.
+     */
+    bool operator!=(const Iterator& rhs) const {
+      return not(*this == rhs);
+    }
+
+  private:
+    /**
+     * @brief The range.
+     */
+    ImageTiles<T, n>* m_tiles;
+
+    /**
+     * @brief The current tile index.
+     */
+    long m_index;
+  };
+
+  /**
+   * @brief Constructor.
+   * @param raster The image data unit handler
+   * @param tileShape The tile shape, without halo
+   * @param overlap The halo width along each axis
+   * @param isWriteBack Whether the tiles are written back to the data unit
+   */
+  ImageTiles(const ImageRaster& raster, const Position<n>& tileShape, const Position<n>& overlap, bool isWriteBack);
+
+  /**
+   * @brief Move constructor.
+   */
+  ImageTiles(ImageTiles&& other);
+
+  /**
+   * @brief Destructor, which writes back the remaining tiles if needed.
+   * @details
+   * Errors are logged instead of thrown: call `flush()` explicitly to handle them.
+   */
+  ~ImageTiles();
+
+  /**
+   * @brief Get the number of tiles.
+   */
+  long size() const;
+
+  /**
+   * @brief Get the number of tiles along each axis.
+   */
+  const Position<n>& gridShape() const;
+
+  /**
+   * @brief Get the number of pixels of the buffer.
+   */
+  long capacity() const;
+
+  /**
+   * @brief Load the first tile and get an iterator to it.
+   */
+  Iterator begin();
+
+  /**
+   * @brief Get the past-the-last iterator.
+   */
+  Iterator end();
+
+  /**
+   * @brief Write back the current tile and the held-back strips if needed.
+   * @details
+   * This is done automatically at the end of the iteration, and by the destructor.
+   * If called before the end of the iteration, the next halos may contain processed pixels.
+   */
+  void flush();
+
+private:
+  /**
+   * @brief Write back the tiles which are not needed by the tiles from a given index, and load this tile.
+   * @details
+   * Nothing is loaded if the index is out of bounds.
+   */
+  void load(long index);
+
+  /**
+   * @brief A processed margin of a tile core, held back in a slot of the pool.
+   */
+  struct Strip {
+
+    /**
+     * @brief The in-file region.
+     */
+    Region<n> region;
+
+    /**
+     * @brief The axis along which the strip is a margin.
+     */
+    long axis;
+
+    /**
+     * @brief The slot.
+     */
+    T* data;
+  };
+
+  /**
+   * @brief Write back the interior of the current tile core, and its margins which are not needed
+   * by the tiles from a given index, and hold back the other margins.
+   */
+  void holdBack(long index);
+
+  /**
+   * @brief Write back the held-back strips which are not needed by the tiles from a given index.
+   */
+  void writeBack(long index);
+
+  /**
+   * @brief Get the index of the last tile whose halo overlaps a given region.
+   */
+  long lastReader(const Region<n>& region) const;
+
+  /**
+   * @brief The image data unit handler.
+   */
+  const ImageRaster& m_raster;
+
+  /**
+   * @brief The image shape.
+   */
+  Position<n> m_shape;
+
+  /**
+   * @brief The tile shape, without halo.
+   */
+  Position<n> m_tileShape;
+
+  /**
+   * @brief The halo width.
+   */
+  Position<n> m_overlap;
+
+  /**
+   * @brief The number of tiles along each axis.
+   */
+  Position<n> m_gridShape;
+
+  /**
+   * @brief Whether the tiles are written back.
+   */
+  bool m_isWriteBack;
+
+  /**
+   * @brief Whether the current tile was loaded and not yet written back.
+   */
+  bool m_isPending;
+
+  /**
+   * @brief The buffer.
+   */
+  std::vector<T> m_buffer;
+
+  /**
+   * @brief The current tile.
+   */
+  Tile m_tile;
+
+  /**
+   * @brief The pool of strips, which is allocated once.
+   */
+  std::vector<T> m_pool;
+
+  /**
+   * @brief The free slots of the pool, for each axis.
+   */
+  std::vector<std::vector<T*>> m_freeSlots;
+
+  /**
+   * @brief The processed strips which are not written back yet, because some later halos overlap them.
+   */
+  std::vector<Strip> m_heldBack;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITS_IMAGETILES_IMPL
+#include "EleFits/impl/ImageTiles.hpp"
+#undef _ELEFITS_IMAGETILES_IMPL
+/// @endcond
+
+#endif
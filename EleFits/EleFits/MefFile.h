@@ -21,6 +21,7 @@
 #define _ELEFITS_MEFFILE_H
 
 #include "EleFits/BintableHdu.h"
+#include "EleFits/BintableStreamWriter.h"
 #include "EleFits/FitsFile.h"
 #include "EleFits/Hdu.h"
 #include "EleFits/ImageHdu.h"
@@ -50,8 +51,11 @@ public:
 
   /**
    * @copydoc FitsFile::~FitsFile
+   * 
+   * Binary table HDUs are finalized as with `close()`, except that errors are logged instead of thrown:
+   * call `close()` explicitly to handle them.
    */
-  virtual ~MefFile() = default;
+  virtual ~MefFile();
 
   /**
    * @copydoc FitsFile::FitsFile
@@ -68,6 +72,14 @@ public:
    */
   long hduCount() const;
 
+  /**
+   * @brief Remove the rows which were reserved in the binary table HDUs, compress back the edited tile-compressed
+   * binary table HDUs, and close the file.
+   * @see BintableColumns::reserve()
+   * @see BintableHdu::flush()
+   */
+  virtual void close() override;
+
   /**
    * @brief Read the name of each HDU.
    * @details
@@ -181,6 +193,31 @@ public:
   template <typename T, long n>
   const ImageHdu& assignImageExt(const std::string& name, const Raster<T, n>& raster);
 
+  /**
+   * @brief Append a tile-compressed ImageHdu with given name, shape and compression parameters.
+   * @details
+   * The HDU is read and written through `ImageHdu::raster()` as a raw image,
+   * the tiles being compressed and uncompressed on the fly by CFitsIO.
+   * Regions should be written by whole tiles, in file order.
+   * @see ImageCompression
+   */
+  template <typename T, long n>
+  const ImageHdu&
+  initImageExt(const std::string& name, const Position<n>& shape, const ImageCompression& compression);
+
+  /**
+   * @brief Append a tile-compressed ImageHdu with given name, data and compression parameters.
+   * @details
+   * For example, to compress an image losslessly with Rice, with tiles of 100 rows:
+   * \code
+   * f.assignImageExt("SCI", raster, ImageCompression(ImageCompression::Algorithm::Rice, { raster.shape()[0], 100 }));
+   * \endcode
+   * @see ImageCompression
+   */
+  template <typename T, long n>
+  const ImageHdu&
+  assignImageExt(const std::string& name, const Raster<T, n>& raster, const ImageCompression& compression);
+
   /**
    * @brief Append a BintableHdu with given name and columns info.
    * @details
@@ -189,9 +226,40 @@ public:
   template <typename... Ts>
   const BintableHdu& initBintableExt(const std::string& name, const ColumnInfo<Ts>&... header);
 
+  /**
+   * @brief Append a BintableHdu with given name and schema.
+   * @details
+   * The column names, formats and units of the schema are used as is.
+   * @see TableSchema
+   */
+  template <typename... TCols>
+  const BintableHdu& initBintableExt(const std::string& name, const TableSchema<TCols...>& schema);
+
+  /**
+   * @brief Append a tile-compressed BintableHdu with given name, compression parameters and columns info.
+   * @details
+   * The table is written in memory, and compressed when the file is closed (see `BintableHdu::flush()`).
+   * It can be read and written through `BintableHdu::columns()` as a raw binary table.
+   * @see TableCompression
+   */
+  template <typename... Ts>
+  const BintableHdu&
+  initBintableExt(const std::string& name, const TableCompression& compression, const ColumnInfo<Ts>&... header);
+
+  /**
+   * @brief Append a BintableHdu with given name and columns info, and get a writer to fill it row-wise.
+   * @details
+   * Rows are appended with bounded memory, which suits tables which do not fit in memory.
+   * @see BintableStreamWriter
+   */
+  template <typename... Ts>
+  BintableStreamWriter<Ts...> initBintableStream(const std::string& name, const ColumnInfo<Ts>&... infos);
+
   /**
    * @brief Append a BintableHdu with given name and data.
    * @return A reference to the new BintableHdu.
+   * @details
+   * Columns are written by blocks of rows, as with `BintableColumns::writeSeq()`.
    * @warning
    * All columns should have the same number of rows.
    */
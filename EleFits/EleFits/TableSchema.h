@@ -0,0 +1,252 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+#ifndef _ELEFITS_TABLESCHEMA_H
+#define _ELEFITS_TABLESCHEMA_H
+
+#include "EleFitsData/Column.h"
+
+#include <array>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup bintable_handlers
+ * @brief A column of a `TableSchema`, whose value type and repeat count are known at compile time.
+ * @details
+ * Only the name and unit are given at run time, e.g.:
+ * \code
+ * SchemaColumn<float, 3> { "FLUX", "Jy" }
+ * \endcode
+ */
+template <typename T, long N = 1>
+struct SchemaColumn {
+
+  /**
+   * @brief The value type.
+   */
+  using Value = T;
+
+  /**
+   * @brief The repeat count.
+   */
+  static constexpr long repeatCount = N;
+
+  /**
+   * @brief The column name.
+   */
+  const char* name;
+
+  /**
+   * @brief The column unit.
+   */
+  const char* unit = "";
+
+  /**
+   * @brief Get the column info.
+   */
+  ColumnInfo<T> info() const {
+    return { name, unit, N };
+  }
+};
+
+template <typename TRow, typename TSchema, typename... TMembers>
+class RowBinding;
+
+/**
+ * @ingroup bintable_handlers
+ * @brief The schema of a binary table, declared once with compile-time types and repeat counts.
+ * @details
+ * The schema generates the `TTYPEn`, `TFORMn` and `TUNITn` values once, at construction,
+ * and is used to create binary table extensions (see `MefFile::initBintableExt()`).
+ * Data can then be read and written either as a tuple of columns (struct of arrays, SoA),
+ * or as a vector of user-defined structs (array of structs, AoS), whose members are bound to the columns:
+ *
+ * \code
+ * struct Source {
+ *   std::int64_t id;
+ *   std::array<float, 3> flux;
+ * };
+ *
+ * const auto schema = makeTableSchema(SchemaColumn<std::int64_t> { "ID" }, SchemaColumn<float, 3> { "FLUX", "Jy" });
+ * const auto binding = schema.bind(&Source::id, &Source::flux);
+ *
+ * const auto& columns = f.initBintableExt("SOURCES", schema).columns();
+ * columns.writeStructs(binding, sources);
+ * auto soa = columns.readSeq(schema);
+ * auto aos = columns.readStructs(binding);
+ * \endcode
+ *
+ * Vector members can be `std::array`s or C arrays, and string members are `std::string`s.
+ * @see BintableColumns::readSeq(const TableSchema<TCols...>&)
+ * @see BintableColumns::readStructs()
+ * @see BintableColumns::writeStructs()
+ */
+template <typename... TCols>
+class TableSchema {
+
+public:
+  /**
+   * @brief The number of columns.
+   */
+  static constexpr std::size_t columnCount = sizeof...(TCols);
+
+  /**
+   * @brief The tuple of column infos.
+   */
+  using Infos = std::tuple<ColumnInfo<typename TCols::Value>...>;
+
+  /**
+   * @brief The tuple of columns, for SoA I/Os.
+   */
+  using Columns = std::tuple<VecColumn<typename TCols::Value>...>;
+
+  /**
+   * @brief Constructor.
+   */
+  explicit TableSchema(TCols... columns);
+
+  /**
+   * @brief Get the column infos.
+   */
+  const Infos& infos() const;
+
+  /**
+   * @brief Get the column names, i.e. the `TTYPEn` values.
+   */
+  const std::vector<std::string>& names() const;
+
+  /**
+   * @brief Get the column formats, i.e. the `TFORMn` values.
+   */
+  const std::vector<std::string>& tforms() const;
+
+  /**
+   * @brief Get the column units, i.e. the `TUNITn` values.
+   */
+  const std::vector<std::string>& units() const;
+
+  /**
+   * @brief Create a tuple of columns with given number of rows.
+   */
+  Columns makeColumns(long rowCount) const;
+
+  /**
+   * @brief Bind the columns to the members of a user-defined struct, in the order of the schema.
+   * @details
+   * The member types are checked against the value types and repeat counts of the columns at compile time.
+   */
+  template <typename TRow, typename... TMembers>
+  RowBinding<TRow, TableSchema, TMembers...> bind(TMembers TRow::*... members) const;
+
+private:
+  /**
+   * @brief The column infos.
+   */
+  Infos m_infos;
+
+  /**
+   * @brief The `TTYPEn` values.
+   */
+  std::vector<std::string> m_names;
+
+  /**
+   * @brief The `TFORMn` values.
+   */
+  std::vector<std::string> m_tforms;
+
+  /**
+   * @brief The `TUNITn` values.
+   */
+  std::vector<std::string> m_units;
+};
+
+/**
+ * @ingroup bintable_handlers
+ * @brief Create a `TableSchema` with deduced column types.
+ */
+template <typename... TCols>
+TableSchema<TCols...> makeTableSchema(TCols... columns);
+
+/**
+ * @ingroup bintable_handlers
+ * @brief The binding of the columns of a `TableSchema` to the members of a user-defined struct.
+ * @see TableSchema::bind()
+ */
+template <typename TRow, typename... TCols, typename... TMembers>
+class RowBinding<TRow, TableSchema<TCols...>, TMembers...> {
+
+public:
+  /**
+   * @brief The row type.
+   */
+  using Row = TRow;
+
+  /**
+   * @brief The schema type.
+   */
+  using Schema = TableSchema<TCols...>;
+
+  /**
+   * @brief Constructor.
+   */
+  RowBinding(Schema schema, TMembers TRow::*... members);
+
+  /**
+   * @brief Get the schema.
+   */
+  const Schema& schema() const;
+
+  /**
+   * @brief Get a pointer to the first value of the member bound to the `i`-th column.
+   */
+  template <std::size_t i>
+  auto* data(TRow& row) const;
+
+  /**
+   * @copydoc data()
+   */
+  template <std::size_t i>
+  const auto* data(const TRow& row) const;
+
+private:
+  /**
+   * @brief The schema.
+   */
+  Schema m_schema;
+
+  /**
+   * @brief The member pointers.
+   */
+  std::tuple<TMembers TRow::*...> m_members;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITS_TABLESCHEMA_IMPL
+#include "EleFits/impl/TableSchema.hpp"
+#undef _ELEFITS_TABLESCHEMA_IMPL
+/// @endcond
+
+#endif
@@ -20,12 +20,107 @@
 #if defined(_ELEFITS_BINTABLECOLUMNS_IMPL) || defined(CHECK_QUALITY)
 
   #include "EleCfitsioWrapper/BintableWrapper.h"
+  #include "EleCfitsioWrapper/ByteSwap.h"
   #include "EleCfitsioWrapper/HeaderWrapper.h" // TODO rm when implementation of init(Seq) is in BintableWrapper
   #include "EleFits/BintableColumns.h"
+  #include "EleFits/BintableStreamReader.h"
+  #include "EleFitsUtils/ThreadPool.h"
+
+  #include <algorithm> // copy_n, stable_sort
+  #include <cmath> // floor
+  #include <limits> // quiet_NaN
+  #include <numeric> // iota
 
 namespace Euclid {
 namespace Fits {
 
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief Copy rows of a column to another column.
+ * @param mapping The pairs of source and destination row indices
+ */
+template <typename T>
+void copyRows(const Column<T>& source, const std::vector<std::pair<long, long>>& mapping, Column<T>& destination) {
+  const auto width = source.rowCount() > 0 ? source.elementCount() / source.rowCount() : 0;
+  const auto* in = source.data();
+  auto* out = destination.data();
+  for (const auto& m : mapping) {
+    std::copy_n(in + m.first * width, width, out + m.second * width);
+  }
+}
+
+/**
+ * @brief Copy rows of each column of a tuple to the corresponding column of another tuple.
+ */
+template <typename TTuple, std::size_t... Is>
+void copyRowsSeqImpl(
+    const TTuple& source,
+    const std::vector<std::pair<long, long>>& mapping,
+    TTuple& destination,
+    std::index_sequence<Is...>) {
+  using mockUnpack = int[];
+  (void)mockUnpack { 0, (copyRows(std::get<Is>(source), mapping, std::get<Is>(destination)), 0)... };
+}
+
+/**
+ * @brief Call a function with each index of an index sequence, as an `std::integral_constant`.
+ */
+template <typename TFunc, std::size_t... Is>
+void indexForeach(std::index_sequence<Is...>, TFunc&& func) {
+  using mockUnpack = int[];
+  (void)mockUnpack { 0, (func(std::integral_constant<std::size_t, Is>()), 0)... };
+}
+
+/**
+ * @brief Get the standard offset of an integer type as an unsigned integer, for modular arithmetics.
+ */
+template <typename U>
+U unsignedOffset(double zero) {
+  if (zero < 0) {
+    return static_cast<U>(static_cast<long long>(zero));
+  }
+  return static_cast<U>(static_cast<unsigned long long>(zero));
+}
+
+/**
+ * @brief Compute the physical null value of an integer column from its `TNULLn` value.
+ * @details
+ * Standard offsets (e.g. 32768 for `std::uint16_t`) are applied with modular arithmetics to avoid overflows.
+ */
+template <typename T>
+std::enable_if_t<std::is_integral<T>::value, T> physicalNull(long raw, double scale, double zero) {
+  if (scale != 1. || zero != std::floor(zero)) {
+    return static_cast<T>(raw * scale + zero);
+  }
+  using U = std::make_unsigned_t<T>;
+  return static_cast<T>(static_cast<U>(static_cast<U>(raw) + unsignedOffset<U>(zero)));
+}
+
+/**
+ * @brief Compute the physical null value of a floating point column from its `TNULLn` value.
+ */
+template <typename T>
+std::enable_if_t<not std::is_integral<T>::value, T> physicalNull(long raw, double scale, double zero) {
+  return static_cast<T>(raw * scale + zero);
+}
+
+/**
+ * @brief Compute the `TNULLn` value of an integer column from its physical null value and standard offset.
+ * @details
+ * Raw values are unsigned for 8-bit types (`B` format), and signed otherwise.
+ */
+template <typename T>
+long rawNull(T null, double zero) {
+  using U = std::make_unsigned_t<T>;
+  const U bits = static_cast<U>(static_cast<U>(null) - unsignedOffset<U>(zero));
+  return sizeof(T) == 1 ? static_cast<long>(bits) : static_cast<long>(static_cast<std::make_signed_t<T>>(bits));
+}
+
+} // namespace Internal
+/// @endcond
+
 // Implementation rules for overloads
 //
 // - Flow should go from names to indices: never call readName() internally, and call readIndex() once;
@@ -44,7 +139,9 @@ ColumnInfo<T> BintableColumns::readInfo(const std::string& name) const {
 
 template <typename T>
 ColumnInfo<T> BintableColumns::readInfo(long index) const {
-  return Cfitsio::BintableIo::readColumnInfo<T>(m_fptr, index + 1); // 1-based
+  const auto& s = schema();
+  OutOfBoundsError::mayThrow("Cannot read column info", index, { 0, static_cast<long>(s.names.size()) - 1 });
+  return { s.names[index], s.units[index], s.repeatCounts[index], s.shapes[index] };
 }
 
 // read
@@ -114,6 +211,81 @@ void BintableColumns::readSegmentTo(FileMemSegments rows, long index, Column<T>&
       slice);
 }
 
+// readElements
+
+template <typename T>
+VecColumn<T> BintableColumns::readElements(const std::string& name, const std::vector<long>& elements) const {
+  return readElements<T>(readIndex(name), elements);
+}
+
+template <typename T>
+VecColumn<T> BintableColumns::readElements(long index, const std::vector<long>& elements) const {
+  return readSegmentElements<T>({ 0, readRowCount() - 1 }, index, elements);
+}
+
+template <typename T>
+VecColumn<T>
+BintableColumns::readSegmentElements(const Segment& rows, long index, const std::vector<long>& elements) const {
+  if (elements.empty()) {
+    throw FitsError("Cannot read an empty element list");
+  }
+
+  /* Merge consecutive elements into runs */
+  auto info = readInfo<T>(index);
+  const auto repeatCount = info.repeatCount;
+  std::vector<Segment> runs;
+  for (auto e : elements) {
+    OutOfBoundsError::mayThrow("Cannot read element", e, { 0, repeatCount - 1 });
+    if (not runs.empty() && runs.back().back == e - 1) {
+      ++runs.back().back;
+    } else {
+      runs.push_back({ e, e });
+    }
+  }
+  info.repeatCount = elements.size();
+  info.shape = Position<-1>(); // Elements are flattened
+  VecColumn<T> column(info, std::max(rows.size(), 0L));
+  m_touch();
+  if (column.elementCount() == 0) {
+    return column;
+  }
+  OutOfBoundsError::mayThrow("Cannot read row", rows.front, { 0, readRowCount() - 1 });
+  OutOfBoundsError::mayThrow("Cannot read row", rows.back, { 0, readRowCount() - 1 });
+
+  /* Read each run with CFitsIO if the runs span few blocks compared to the row width */
+  const auto& s = schema();
+  constexpr long blockSize = 2880;
+  auto* destination = column.data();
+  if (static_cast<long>(runs.size()) * blockSize < s.rowWidth || not isRawCodable<T>(index, repeatCount)) {
+    for (long row = rows.front; row <= rows.back; ++row) {
+      for (const auto& run : runs) {
+        Cfitsio::BintableIo::readColumnElements(m_fptr, row + 1, index + 1, run.front + 1, run.size(), destination);
+        destination += run.size();
+      }
+    }
+    return column;
+  }
+
+  /* Otherwise, read raw row blocks and decode the runs only */
+  const auto bufferSize = s.bufferRowCount;
+  const long valueSize = sizeof(T);
+  std::vector<unsigned char> block(bufferSize * s.rowWidth);
+  for (Segment chunk = Segment::fromSize(rows.front, bufferSize); chunk.front <= rows.back;
+       chunk.front += bufferSize, chunk.back += bufferSize) {
+    const auto chunkSize = std::min(chunk.back, rows.back) - chunk.front + 1;
+    Cfitsio::BintableIo::readRowBytes(m_fptr, chunk.front + 1, chunkSize, s.rowWidth, block.data());
+    const auto* row = block.data();
+    for (long i = 0; i < chunkSize; ++i, row += s.rowWidth) {
+      for (const auto& run : runs) {
+        const auto byteOffset = s.byteOffsets[index] + run.front * valueSize;
+        Cfitsio::decodeField(row, 1, s.rowWidth, byteOffset, run.size(), destination);
+        destination += run.size();
+      }
+    }
+  }
+  return column;
+}
+
 // readSeq
 
 template <typename... Ts>
@@ -173,7 +345,7 @@ void BintableColumns::readSeqTo(const std::vector<long>& indices, Column<Ts>&...
 
 template <typename... Ts>
 std::tuple<VecColumn<Ts>...> BintableColumns::readSegmentSeq(const Segment& rows, const Named<Ts>&... names) const {
-  return readSegmentSeq(rows, Indexed<Ts>(readIndex(names))...);
+  return readSegmentSeq(rows, Indexed<Ts>(readIndex(names.name))...);
 }
 
 template <typename... Ts>
@@ -245,6 +417,230 @@ void BintableColumns::readSegmentSeqTo(FileMemSegments rows, const std::vector<l
   readSegmentSeqTo(rows, indices, std::forward_as_tuple(columns...)); // FIXME move rows?
 }
 
+// readSegmentSeqRawTo
+
+template <typename TSeq>
+void BintableColumns::readSegmentSeqRawTo(FileMemSegments rows, TSeq&& columns) const {
+  std::vector<long> indices;
+  seqForeach(std::forward<TSeq>(columns), [&](const auto& c) {
+    indices.push_back(readIndex(c.info().name));
+  });
+  readSegmentSeqRawTo(std::move(rows), indices, std::forward<TSeq>(columns));
+}
+
+template <typename... Ts>
+void BintableColumns::readSegmentSeqRawTo(FileMemSegments rows, Column<Ts>&... columns) const {
+  readSegmentSeqRawTo(std::move(rows), std::forward_as_tuple(columns...));
+}
+
+template <typename TSeq>
+void BintableColumns::readSegmentSeqRawTo(FileMemSegments rows, const std::vector<long>& indices, TSeq&& columns)
+    const {
+  const long rowCount = columnsRowCount(std::forward<TSeq>(columns));
+  rows.resolve(readRowCount() - 1, rowCount - 1);
+  readSegmentsRawTo({ rows.file() }, rows.memory().front, indices, std::forward<TSeq>(columns));
+}
+
+// readWhere
+
+template <typename T, typename TPredicate, typename... Ts>
+std::tuple<VecColumn<Ts>...>
+BintableColumns::readWhere(const Named<T>& predicateColumn, TPredicate&& predicate, const Named<Ts>&... names) const {
+  return readWhere(
+      Indexed<T>(readIndex(predicateColumn.name)),
+      std::forward<TPredicate>(predicate),
+      Indexed<Ts>(readIndex(names.name))...);
+}
+
+template <typename T, typename TPredicate, typename... Ts>
+std::tuple<VecColumn<Ts>...>
+BintableColumns::readWhere(const Indexed<T>& predicateColumn, TPredicate&& predicate, const Indexed<Ts>&... indices)
+    const {
+  const auto rows = readWhereSegments(predicateColumn, std::forward<TPredicate>(predicate));
+  long rowCount = 0;
+  for (const auto& r : rows) {
+    rowCount += r.size();
+  }
+  std::tuple<VecColumn<Ts>...> columns { { readInfo<Ts>(indices), rowCount }... };
+  if (rowCount > 0) { // Segments are sorted and disjoint, and are read in turn at a running memory index
+    readSegmentsRawTo(rows, 0, { indices.index... }, columns);
+  }
+  return columns;
+}
+
+template <typename T, typename TPredicate>
+std::vector<Segment> BintableColumns::readWhereSegments(const Indexed<T>& predicateColumn, TPredicate&& predicate)
+    const {
+  const auto info = readInfo<T>(predicateColumn.index);
+  if (info.repeatCount != 1 && not std::is_same<std::decay_t<T>, std::string>::value) {
+    throw FitsError("Cannot filter rows with vector column: " + info.name);
+  }
+  const auto rowCount = readRowCount();
+  const auto bufferSize = std::min(readBufferRowCount(), rowCount);
+  std::vector<Segment> rows;
+  if (bufferSize <= 0) {
+    return rows;
+  }
+  VecColumn<T> chunk(info, bufferSize);
+  const std::vector<long> indices { predicateColumn.index };
+  for (long front = 0; front < rowCount; front += bufferSize) {
+    const auto chunkSize = std::min(bufferSize, rowCount - front);
+    readSegmentSeqRawTo({ front, { 0, chunkSize - 1 } }, indices, std::forward_as_tuple(chunk));
+    for (long i = 0; i < chunkSize; ++i) {
+      if (not predicate(chunk(i))) {
+        continue;
+      }
+      const auto row = front + i;
+      if (not rows.empty() && rows.back().back == row - 1) {
+        ++rows.back().back;
+      } else {
+        rows.push_back({ row, row });
+      }
+    }
+  }
+  return rows;
+}
+
+// readRows
+
+template <typename... Ts>
+std::tuple<VecColumn<Ts>...> BintableColumns::readRows(const std::vector<long>& rows, const Named<Ts>&... names) const {
+  return readRows(rows, readBufferRowCount(), names...);
+}
+
+template <typename... Ts>
+std::tuple<VecColumn<Ts>...>
+BintableColumns::readRows(const std::vector<long>& rows, long maxGap, const Named<Ts>&... names) const {
+  return readRows(rows, maxGap, Indexed<Ts>(readIndex(names.name))...);
+}
+
+template <typename... Ts>
+std::tuple<VecColumn<Ts>...>
+BintableColumns::readRows(const std::vector<long>& rows, long maxGap, const Indexed<Ts>&... indices) const {
+  const long rowCount = rows.size();
+  std::tuple<VecColumn<Ts>...> columns { { readInfo<Ts>(indices), rowCount }... };
+  if (rowCount == 0) {
+    return columns;
+  }
+
+  /* Sort the requested rows, keeping track of their positions */
+  std::vector<long> order(rowCount);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](long lhs, long rhs) {
+    return rows[lhs] < rows[rhs];
+  });
+  const std::pair<long, long> bounds { 0, readRowCount() - 1 };
+  OutOfBoundsError::mayThrow("Cannot read row", rows[order.front()], bounds);
+  OutOfBoundsError::mayThrow("Cannot read row", rows[order.back()], bounds);
+
+  /* Coalesce the rows into batches of ranges, and read each batch into a buffer */
+  const auto batchSize = std::max(readBufferRowCount(), 1L);
+  std::tuple<VecColumn<Ts>...> batch { { readInfo<Ts>(indices), batchSize }... };
+  const std::vector<long> batchIndices { indices.index... };
+  std::vector<Segment> ranges;
+  std::vector<std::pair<long, long>> mapping; // Pairs of in-batch and output rows
+  long batchRowCount = 0;
+  const auto flush = [&]() {
+    readSegmentsRawTo(ranges, 0, batchIndices, batch);
+    Internal::copyRowsSeqImpl(batch, mapping, columns, std::index_sequence_for<Ts...>());
+    ranges.clear();
+    mapping.clear();
+    batchRowCount = 0;
+  };
+  for (auto position : order) {
+    const auto row = rows[position];
+    if (not ranges.empty() && row - ranges.back().back - 1 <= maxGap &&
+        batchRowCount + row - ranges.back().back <= batchSize) { // Read through the hole
+      batchRowCount += row - ranges.back().back;
+      ranges.back().back = row;
+    } else {
+      if (batchRowCount == batchSize) {
+        flush();
+      }
+      ranges.push_back({ row, row });
+      ++batchRowCount;
+    }
+    mapping.emplace_back(batchRowCount - 1, position);
+  }
+  flush();
+  return columns;
+}
+
+// readSegmentsRawTo
+
+template <typename TSeq>
+void BintableColumns::readSegmentsRawTo(
+    const std::vector<Segment>& fileRows,
+    long memoryIndex,
+    const std::vector<long>& indices,
+    TSeq&& columns) const {
+
+  /* Split raw-decodable columns from the others */
+  const auto& s = schema();
+  std::vector<bool> isDecodable(indices.size());
+  auto it = indices.begin();
+  auto decodable = isDecodable.begin();
+  seqForeach(std::forward<TSeq>(columns), [&](const auto& c) {
+    using Value = std::decay_t<typename std::decay_t<decltype(c)>::Value>;
+    *decodable = isRawCodable<Value>(*it, c.info().repeatCount);
+    ++it;
+    ++decodable;
+  });
+  if (std::find(isDecodable.begin(), isDecodable.end(), true) == isDecodable.end()) {
+    for (const auto& file : fileRows) {
+      readSegmentSeqTo({ file, memoryIndex }, indices, std::forward<TSeq>(columns));
+      memoryIndex += file.size();
+    }
+    return;
+  }
+
+  /* Read and decode by chunks, and read the other columns one by one */
+  const auto bufferSize = s.bufferRowCount;
+  std::vector<unsigned char> block(bufferSize * s.rowWidth);
+  m_touch();
+  for (const auto& file : fileRows) {
+    for (Segment chunk = Segment::fromSize(file.front, bufferSize); chunk.front <= file.back;
+         chunk.front += bufferSize, chunk.back += bufferSize) {
+      if (chunk.back > file.back) {
+        chunk.back = file.back;
+      }
+      const auto chunkSize = chunk.size();
+      Cfitsio::BintableIo::readRowBytes(m_fptr, chunk.front + 1, chunkSize, s.rowWidth, block.data());
+      it = indices.begin();
+      decodable = isDecodable.begin();
+      seqForeach(std::forward<TSeq>(columns), [&](auto& c) {
+        if (*decodable) {
+          const auto repeatCount = c.info().repeatCount;
+          auto* destination = c.data() + memoryIndex * repeatCount;
+          Cfitsio::decodeField(block.data(), chunkSize, s.rowWidth, s.byteOffsets[*it], repeatCount, destination);
+        } else {
+          readSegmentTo({ chunk.front, Segment::fromSize(memoryIndex, chunkSize) }, *it, c);
+        }
+        ++it;
+        ++decodable;
+      });
+      memoryIndex += chunkSize;
+    }
+  }
+}
+
+// stream
+
+template <typename... Ts>
+BintableStreamReader<Ts...> BintableColumns::stream(const Named<Ts>&... names) const {
+  return stream(readBufferRowCount(), names...);
+}
+
+template <typename... Ts>
+BintableStreamReader<Ts...> BintableColumns::stream(long batchRowCount, const Named<Ts>&... names) const {
+  return stream(batchRowCount, Indexed<Ts>(readIndex(names.name))...);
+}
+
+template <typename... Ts>
+BintableStreamReader<Ts...> BintableColumns::stream(long batchRowCount, const Indexed<Ts>&... indices) const {
+  return BintableStreamReader<Ts...>(*this, batchRowCount, indices...);
+}
+
 // write
 
 template <typename T>
@@ -256,29 +652,380 @@ void BintableColumns::write(const Column<T>& column) const {
 
 template <typename T>
 void BintableColumns::init(const ColumnInfo<T>& info, long index) const {
-  auto name = Cfitsio::toCharPtr(info.name);
-  auto tform = Cfitsio::toCharPtr(Cfitsio::TypeCode<T>::tform(info.repeatCount));
-  int status = 0;
-  int cfitsioIndex = index == -1 ? Cfitsio::BintableIo::columnCount(m_fptr) + 1 : index + 1;
-  fits_insert_col(m_fptr, cfitsioIndex, name.get(), tform.get(), &status);
-  Cfitsio::CfitsioError::mayThrow(status, m_fptr, "Cannot init new column: #" + std::to_string(index));
-  if (info.unit != "") {
-    const Record<std::string> record { "TUNIT" + std::to_string(cfitsioIndex),
-                                       info.unit,
-                                       "",
-                                       "physical unit of field" };
-    Cfitsio::HeaderIo::updateRecord(m_fptr, record);
-  }
-  // TODO to Cfitsio
+  initImpl(info.name, Cfitsio::TypeCode<T>::tform(info.repeatCount), info.unit, index);
+  const long cfitsioIndex = index == -1 ? Cfitsio::BintableIo::columnCount(m_fptr) : index + 1;
+  Cfitsio::BintableIo::updateColumnShape(m_fptr, cfitsioIndex, info.shape);
+}
+
+// initVla
+
+template <typename T>
+void BintableColumns::initVla(const ColumnInfo<T>& info, long index) const {
+  initImpl(info.name, Cfitsio::TypeCode<T>::tformVla(), info.unit, index);
+}
+
+// readVla
+
+template <typename T>
+VlaColumn<T> BintableColumns::readVla(const std::string& name) const {
+  return readVla<T>(readIndex(name));
+}
+
+template <typename T>
+VlaColumn<T> BintableColumns::readVla(long index) const {
+  return readVlaSegment<T>({ 0, readRowCount() - 1 }, index);
+}
+
+// readVlaSegment
+
+template <typename T>
+VlaColumn<T> BintableColumns::readVlaSegment(const Segment& rows, long index) const {
+  VlaColumn<T> column(readInfo<T>(index));
+  readVlaSegmentTo(rows, index, column);
+  return column;
+}
+
+template <typename T>
+void BintableColumns::readVlaSegmentTo(const Segment& rows, long index, VlaColumn<T>& column) const {
+  m_touch();
+  if (rows.size() <= 0) {
+    return;
+  }
+  OutOfBoundsError::mayThrow("Cannot read row", rows.front, { 0, readRowCount() - 1 });
+  OutOfBoundsError::mayThrow("Cannot read row", rows.back, { 0, readRowCount() - 1 });
+  Cfitsio::BintableIo::readColumnSegment(m_fptr, Segment { rows.front + 1, rows.back + 1 }, index + 1, column);
 }
 
 // writeSegment
 
 template <typename T>
 void BintableColumns::writeSegment(FileMemSegments rows, const Column<T>& column) const {
+  writeSegmentImpl(std::move(rows), readIndex(column.info().name), column);
+}
+
+template <typename T>
+void BintableColumns::write(const VlaColumn<T>& column) const {
+  writeSegment(0, column);
+}
+
+template <typename T>
+void BintableColumns::writeSegment(FileMemSegments rows, const VlaColumn<T>& column) const {
+  const auto index = readIndex(column.info().name);
+  m_edit();
+  rows.resolve(readRowCount() - 1, column.rowCount() - 1);
+  growCapacity(rows.file().back);
+  Cfitsio::BintableIo::writeColumnSegment(m_fptr, rows.file().front + 1, index + 1, column, rows.memory());
+  updateRowCount(rows.file().back);
+}
+
+// initNullable
+
+template <typename T>
+void BintableColumns::initNullable(const ColumnInfo<T>& info, T null, long index) const {
+  static_assert(std::is_integral<T>::value, "Null values of floating point columns are NaNs: use init() instead.");
+  init(info, index);
+  const long cfitsioIndex = index == -1 ? readColumnCount() : index + 1;
+  const Record<long> record {
+      "TNULL" + std::to_string(cfitsioIndex),
+      Internal::rawNull(null, Cfitsio::FitsEncoding<T>::zero()),
+      "",
+      "undefined value"};
+  Cfitsio::HeaderIo::updateRecord(m_fptr, record);
+}
+
+// readNullable
+
+template <typename T>
+NullableColumn<T> BintableColumns::readNullable(const std::string& name) const {
+  return readNullable<T>(readIndex(name));
+}
+
+template <typename T>
+NullableColumn<T> BintableColumns::readNullable(long index) const {
+  NullableColumn<T> column(readInfo<T>(index), readRowCount());
+  readSegmentSeqRawTo(0, std::vector<long> { index }, std::forward_as_tuple(column.values()));
+  T null {};
+  if (readNullValue(index, null)) {
+    column.updateValidity(null);
+  } else {
+    column.updateValidity();
+  }
+  return column;
+}
+
+// writeSegment(nullable)
+
+template <typename T>
+void BintableColumns::write(const NullableColumn<T>& column) const {
+  writeSegment(0, column);
+}
+
+template <typename T>
+void BintableColumns::writeSegment(FileMemSegments rows, const NullableColumn<T>& column) const {
+  const auto index = readIndex(column.info().name);
+  if (column.nullCount() == 0) {
+    writeSegmentImpl(rows, index, column.values());
+    return;
+  }
+  T null {};
+  if (not readNullValue(index, null)) {
+    if (not std::is_floating_point<T>::value) {
+      throw FitsError("Cannot write null values to column without TNULLn: " + column.info().name);
+    }
+    null = std::numeric_limits<T>::quiet_NaN();
+  }
+  writeSegmentImpl(rows, index, column.fill(null));
+}
+
+// readNullValue
+
+template <typename T>
+bool BintableColumns::readNullValue(long index, T& null) const {
+  const auto& s = schema();
+  const auto keyword = "TNULL" + std::to_string(index + 1);
+  m_touch();
+  if (not Cfitsio::HeaderIo::hasKeyword(m_fptr, keyword)) {
+    return false;
+  }
+  const auto raw = Cfitsio::HeaderIo::parseRecord<long>(m_fptr, keyword).value;
+  null = Internal::physicalNull<T>(raw, s.scales[index], s.zeros[index]);
+  return true;
+}
+
+// readSeq(schema)
+
+template <typename... TCols>
+typename TableSchema<TCols...>::Columns BintableColumns::readSeq(const TableSchema<TCols...>& schema) const {
+  auto columns = schema.makeColumns(readRowCount());
+  readSeqTo(schema.names(), columns);
+  return columns;
+}
+
+// readStructs
+
+template <typename TRow, typename TSchema, typename... TMembers>
+std::vector<TRow> BintableColumns::readStructs(const RowBinding<TRow, TSchema, TMembers...>& binding) const {
+  return readStructSegment({ 0, readRowCount() - 1 }, binding);
+}
+
+template <typename TRow, typename TSchema, typename... TMembers>
+std::vector<TRow>
+BintableColumns::readStructSegment(const Segment& rows, const RowBinding<TRow, TSchema, TMembers...>& binding) const {
+  m_touch();
+  std::vector<TRow> res(std::max(0L, rows.size()));
+  if (res.empty()) {
+    return res;
+  }
+  OutOfBoundsError::mayThrow("Cannot read row", rows.front, { 0, readRowCount() - 1 });
+  OutOfBoundsError::mayThrow("Cannot read row", rows.back, { 0, readRowCount() - 1 });
+  const auto& infos = binding.schema().infos();
+  std::vector<long> indices;
+  const bool raw = readSchemaIndices(binding.schema(), indices);
+  const auto& s = schema();
+  const long chunkSize = std::max(1L, readBufferRowCount());
+  std::vector<unsigned char> block;
+  for (long front = rows.front; front <= rows.back; front += chunkSize) {
+    const long size = std::min(chunkSize, rows.back - front + 1);
+    auto* row = &res[front - rows.front];
+
+    /* Decode each row of a raw block in a single pass */
+    if (raw) {
+      block.resize(size * s.rowWidth);
+      Cfitsio::BintableIo::readRowBytes(m_fptr, front + 1, size, s.rowWidth, block.data());
+      const auto* bytes = block.data();
+      for (long r = 0; r < size; ++r, ++row, bytes += s.rowWidth) {
+        Internal::indexForeach(std::make_index_sequence<TSchema::columnCount>(), [&](auto i) {
+          constexpr std::size_t j = decltype(i)::value;
+          const auto& info = std::get<j>(infos);
+          auto* destination = binding.template data<j>(*row);
+          Cfitsio::decodeField(bytes, 1, s.rowWidth, s.byteOffsets[indices[j]], info.repeatCount, destination);
+        });
+      }
+      continue;
+    }
+
+    /* Read the columns and copy them */
+    auto columns = binding.schema().makeColumns(size);
+    readSegmentSeqTo({ Segment { front, front + size - 1 }, 0 }, indices, columns);
+    for (long r = 0; r < size; ++r, ++row) {
+      Internal::indexForeach(std::make_index_sequence<TSchema::columnCount>(), [&](auto i) {
+        constexpr std::size_t j = decltype(i)::value;
+        const auto& column = std::get<j>(columns);
+        const long count = column.elementCount() / size;
+        std::copy_n(column.data() + r * count, count, binding.template data<j>(*row));
+      });
+    }
+  }
+  return res;
+}
+
+// writeStructs
+
+template <typename TRow, typename TSchema, typename... TMembers>
+void BintableColumns::writeStructs(const RowBinding<TRow, TSchema, TMembers...>& binding, const std::vector<TRow>& rows)
+    const {
+  writeStructSegment(0, binding, rows);
+}
+
+template <typename TRow, typename TSchema, typename... TMembers>
+void BintableColumns::writeStructSegment(
+    long firstRow,
+    const RowBinding<TRow, TSchema, TMembers...>& binding,
+    const std::vector<TRow>& rows) const {
+  m_edit();
+  const long rowCount = rows.size();
+  if (rowCount == 0) {
+    return;
+  }
+  growCapacity(firstRow + rowCount - 1);
+  const auto& infos = binding.schema().infos();
+  std::vector<long> indices;
+  const bool raw = readSchemaIndices(binding.schema(), indices);
+  const auto& s = schema();
+  long schemaWidth = 0;
+  for (auto i : indices) {
+    schemaWidth += raw ? Cfitsio::BintableIo::fieldByteCount(s.tforms[i]) : 0;
+  }
+  const long tableRowCount = s.rowCount;
+  const long chunkSize = std::max(1L, readBufferRowCount());
+  std::vector<unsigned char> block;
+  for (long offset = 0; offset < rowCount; offset += chunkSize) {
+    const long front = firstRow + offset;
+    const long size = std::min(chunkSize, rowCount - offset);
+    const auto* row = &rows[offset];
+
+    /* Encode each row in a single pass, and write the raw block */
+    if (raw) {
+      block.assign(size * s.rowWidth, 0);
+      const long existingSize = std::min(size, tableRowCount - front);
+      if (schemaWidth < s.rowWidth && existingSize > 0) {
+        Cfitsio::BintableIo::readRowBytes(m_fptr, front + 1, existingSize, s.rowWidth, block.data());
+      }
+      auto* bytes = block.data();
+      for (long r = 0; r < size; ++r, ++row, bytes += s.rowWidth) {
+        Internal::indexForeach(std::make_index_sequence<TSchema::columnCount>(), [&](auto i) {
+          constexpr std::size_t j = decltype(i)::value;
+          const auto& info = std::get<j>(infos);
+          const auto* source = binding.template data<j>(*row);
+          Cfitsio::encodeField(source, 1, s.rowWidth, s.byteOffsets[indices[j]], info.repeatCount, bytes);
+        });
+      }
+      Cfitsio::BintableIo::writeRowBytes(m_fptr, front + 1, size, s.rowWidth, block.data());
+      continue;
+    }
+
+    /* Copy the structs to columns, and write them */
+    auto columns = binding.schema().makeColumns(size);
+    for (long r = 0; r < size; ++r, ++row) {
+      Internal::indexForeach(std::make_index_sequence<TSchema::columnCount>(), [&](auto i) {
+        constexpr std::size_t j = decltype(i)::value;
+        auto& column = std::get<j>(columns);
+        const long count = column.elementCount() / size;
+        std::copy_n(binding.template data<j>(*row), count, column.data() + r * count);
+      });
+    }
+    writeSegmentSeq(front, columns);
+  }
+  updateRowCount(firstRow + rowCount - 1);
+}
+
+template <typename... TCols>
+bool BintableColumns::readSchemaIndices(const TableSchema<TCols...>& schema, std::vector<long>& indices) const {
+  indices.resize(sizeof...(TCols));
+  bool raw = true;
+  Internal::indexForeach(std::index_sequence_for<TCols...>(), [&](auto i) {
+    constexpr std::size_t j = decltype(i)::value;
+    const auto& info = std::get<j>(schema.infos());
+    using Value = typename std::decay_t<decltype(info)>::Value;
+    indices[j] = readIndex(info.name);
+    raw = raw && isRawCodable<Value>(indices[j], info.repeatCount);
+  });
+  return raw;
+}
+
+// writeRows
+
+template <typename T>
+void BintableColumns::writeRows(const std::vector<long>& rows, const Column<T>& column) const {
+  writeRows(rows, readBufferRowCount(), column);
+}
+
+template <typename T>
+void BintableColumns::writeRows(const std::vector<long>& rows, long maxGap, const Column<T>& column) const {
+  const long rowCount = rows.size();
+  if (column.rowCount() != rowCount) {
+    throw FitsError("Cannot write rows: numbers of row indices and of column rows differ.");
+  }
+  if (rowCount == 0) {
+    return;
+  }
+  const auto index = readIndex(column.info().name);
+
+  /* Sort the rows, keeping track of their positions */
+  std::vector<long> order(rowCount);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](long lhs, long rhs) {
+    return rows[lhs] < rows[rhs];
+  });
+  const std::pair<long, long> bounds { 0, readRowCount() - 1 };
+  OutOfBoundsError::mayThrow("Cannot write row", rows[order.front()], bounds);
+  OutOfBoundsError::mayThrow("Cannot write row", rows[order.back()], bounds);
+
+  /* Coalesce the rows into batches of runs, fill the holes, and write each run */
+  const auto batchSize = std::max(readBufferRowCount(), 1L);
+  VecColumn<T> batch(column.info(), batchSize);
+  std::vector<Segment> runs;
+  std::vector<bool> hasHoles;
+  std::vector<std::pair<long, long>> mapping; // Pairs of input and in-batch rows
+  long batchRowCount = 0;
+  const auto flush = [&]() {
+    long front = 0;
+    for (std::size_t i = 0; i < runs.size(); ++i) {
+      if (hasHoles[i]) {
+        readSegmentTo<T>({ runs[i].front, Segment::fromSize(front, runs[i].size()) }, index, batch);
+      }
+      front += runs[i].size();
+    }
+    Internal::copyRows(column, mapping, batch);
+    front = 0;
+    for (const auto& run : runs) {
+      writeSegmentImpl<T>({ run.front, Segment::fromSize(front, run.size()) }, index, batch);
+      front += run.size();
+    }
+    runs.clear();
+    hasHoles.clear();
+    mapping.clear();
+    batchRowCount = 0;
+  };
+  for (auto position : order) {
+    const auto row = rows[position];
+    if (not runs.empty() && row - runs.back().back - 1 <= maxGap &&
+        batchRowCount + row - runs.back().back <= batchSize) { // Read-modify-write the hole
+      batchRowCount += row - runs.back().back;
+      if (row - runs.back().back > 1) {
+        hasHoles.back() = true;
+      }
+      runs.back().back = row;
+    } else {
+      if (batchRowCount == batchSize) {
+        flush();
+      }
+      runs.push_back({ row, row });
+      hasHoles.push_back(false);
+      ++batchRowCount;
+    }
+    mapping.emplace_back(position, batchRowCount - 1);
+  }
+  flush();
+}
+
+template <typename T>
+void BintableColumns::writeSegmentImpl(FileMemSegments rows, long index, const Column<T>& column) const {
   m_edit();
   rows.resolve(readRowCount() - 1, column.rowCount() - 1);
-  Cfitsio::BintableIo::writeColumnSegment(m_fptr, rows.file().front + 1, column.slice(rows.memory()));
+  growCapacity(rows.file().back);
+  Cfitsio::BintableIo::writeColumnSegment(m_fptr, rows.file().front + 1, index + 1, column.slice(rows.memory()));
+  updateRowCount(rows.file().back);
 }
 
 // writeSeq
@@ -296,24 +1043,22 @@ void BintableColumns::writeSeq(const Column<Ts>&... columns) const {
 template <typename TSeq>
 void BintableColumns::initSeq(TSeq&& infos, long index) const {
   m_edit();
-  auto names = seqTransform<Cfitsio::CStrArray>(infos, [&](const auto& info) {
+  invalidateSchema();
+  const auto names = seqTransform<std::vector<std::string>>(infos, [&](const auto& info) {
     return info.name;
   });
-  auto tforms = seqTransform<Cfitsio::CStrArray>(infos, [&](const auto& info) {
-    return Cfitsio::TypeCode<typename decltype(info)::Value>::tform(info.repeatCount);
+  const auto tforms = seqTransform<std::vector<std::string>>(infos, [&](const auto& info) {
+    return Cfitsio::TypeCode<typename std::decay_t<decltype(info)>::Value>::tform(info.repeatCount);
   });
-  int status = 0;
-  int cfitsioIndex = index == -1 ? Cfitsio::BintableIo::columnCount(m_fptr) + 1 : index + 1;
-  fits_insert_cols(m_fptr, cfitsioIndex, names.size(), names.data(), tforms.data(), &status);
-  // TODO to Cfitsio
-  long i = cfitsioIndex;
-  seqForeach(infos, [&](const auto& info) {
-    if (info.unit != "") {
-      const Record<std::string> record { "TUNIT" + std::to_string(i), info.unit, "", "physical unit of field" };
-      Cfitsio::HeaderIo::updateRecord(m_fptr, record);
-    }
+  const auto units = seqTransform<std::vector<std::string>>(infos, [&](const auto& info) {
+    return info.unit;
+  });
+  const long cfitsioIndex = index == -1 ? Cfitsio::BintableIo::columnCount(m_fptr) + 1 : index + 1;
+  Cfitsio::BintableIo::initColumns(m_fptr, cfitsioIndex, names, tforms, units); // Single data unit shift
+  long shapeIndex = cfitsioIndex;
+  seqForeach(std::forward<TSeq>(infos), [&](const auto& info) {
+    Cfitsio::BintableIo::updateColumnShape(m_fptr, shapeIndex++, info.shape);
   });
-  // TODO to Cfitsio
 }
 
 template <typename... Ts>
@@ -325,10 +1070,36 @@ void BintableColumns::initSeq(const ColumnInfo<Ts>&... infos, long index) const
 
 template <typename TSeq>
 void BintableColumns::writeSegmentSeq(FileMemSegments rows, TSeq&& columns) const {
+  m_edit();
   const auto rowCount = columnsRowCount(std::forward<TSeq>(columns));
   rows.resolve(readRowCount() - 1, rowCount - 1);
+  growCapacity(rows.file().back);
   const long lastMemRow = rows.memory().back;
-  const auto bufferSize = readBufferRowCount();
+  const auto& s = schema();
+  const auto bufferSize = s.bufferRowCount;
+  const auto indices = seqTransform<std::vector<long>>(std::forward<TSeq>(columns), [&](const auto& c) {
+    return readIndex(c.info().name);
+  });
+
+  /* Split raw-encodable columns from the others */
+  std::vector<bool> isEncodable(indices.size());
+  std::vector<bool> isCovered(s.names.size(), false);
+  auto it = indices.begin();
+  auto encodable = isEncodable.begin();
+  seqForeach(std::forward<TSeq>(columns), [&](const auto& c) {
+    using Value = std::decay_t<typename std::decay_t<decltype(c)>::Value>;
+    *encodable = isRawCodable<Value>(*it, c.info().repeatCount);
+    if (*encodable) {
+      isCovered[*it] = true;
+    }
+    ++it;
+    ++encodable;
+  });
+  const bool hasEncodable = std::find(isEncodable.begin(), isEncodable.end(), true) != isEncodable.end();
+  const bool isComplete = std::find(isCovered.begin(), isCovered.end(), false) == isCovered.end();
+  std::vector<unsigned char> block(hasEncodable ? bufferSize * s.rowWidth : 0);
+  std::vector<std::function<void(void)>> tasks;
+
   for (auto mem = Segment::fromSize(rows.memory().front, bufferSize), // TODO use a FileMemSegments
        file = Segment::fromSize(rows.file().front, bufferSize);
        mem.front <= lastMemRow; // TODO mem += bufferSize, file += bufferSize) {
@@ -336,8 +1107,47 @@ void BintableColumns::writeSegmentSeq(FileMemSegments rows, TSeq&& columns) cons
     if (mem.back > lastMemRow) {
       mem.back = lastMemRow;
     }
+    const long chunkSize = mem.size();
+
+    /* Encode the raw-encodable columns as a block of rows, concurrently */
+    if (hasEncodable) {
+      long existingRowCount = 0;
+      if (not isComplete) { // Fields of other columns must be preserved
+        existingRowCount = std::max(0L, std::min(chunkSize, s.rowCount - file.front));
+        if (existingRowCount > 0) {
+          Cfitsio::BintableIo::readRowBytes(m_fptr, file.front + 1, existingRowCount, s.rowWidth, block.data());
+        }
+      }
+      std::fill(block.begin() + existingRowCount * s.rowWidth, block.begin() + chunkSize * s.rowWidth, 0);
+      tasks.clear();
+      it = indices.begin();
+      encodable = isEncodable.begin();
+      seqForeach(std::forward<TSeq>(columns), [&](const auto& c) {
+        if (*encodable) {
+          const auto repeatCount = c.info().repeatCount;
+          const auto* source = c.data() + mem.front * repeatCount;
+          const auto byteOffset = s.byteOffsets[*it];
+          tasks.push_back([&, source, repeatCount, byteOffset]() {
+            Cfitsio::encodeField(source, chunkSize, s.rowWidth, byteOffset, repeatCount, block.data());
+          });
+        }
+        ++it;
+        ++encodable;
+      });
+      ThreadPool::instance().run(tasks);
+      Cfitsio::BintableIo::writeRowBytes(m_fptr, file.front + 1, chunkSize, s.rowWidth, block.data());
+      updateRowCount(file.front + chunkSize - 1);
+    }
+
+    /* Write the other columns one by one */
+    it = indices.begin();
+    encodable = isEncodable.begin();
     seqForeach(std::forward<TSeq>(columns), [&](const auto& c) {
-      writeSegment({ file.front, mem }, c); // FIXME don't recalculate index
+      if (not *encodable) {
+        writeSegmentImpl({ file.front, mem }, *it, c);
+      }
+      ++it;
+      ++encodable;
     });
   }
 }
@@ -347,6 +1157,19 @@ void BintableColumns::writeSegmentSeq(FileMemSegments rows, const Column<Ts>&...
   writeSegmentSeq(rows, std::forward_as_tuple(columns...));
 }
 
+// isRawCodable
+
+template <typename T>
+bool BintableColumns::isRawCodable(long index, long repeatCount) const {
+  const auto& s = schema();
+  const auto& tform = s.tforms[index];
+  const auto letterPos = tform.find_first_not_of("0123456789");
+  const auto letter = Cfitsio::FitsEncoding<T>::letter();
+  return letter != 0 && letterPos != std::string::npos && tform[letterPos] == letter && s.byteOffsets[index] >= 0 &&
+      s.repeatCounts[index] == repeatCount && s.scales[index] == 1. &&
+      s.zeros[index] == Cfitsio::FitsEncoding<T>::zero();
+}
+
 template <typename TSeq>
 long columnsRowCount(TSeq&& columns) {
   long rows = -1;
@@ -0,0 +1,189 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#if defined(_ELEFITS_BINTABLESTREAMREADER_IMPL) || defined(CHECK_QUALITY)
+
+  #include "EleCfitsioWrapper/ByteSwap.h"
+  #include "EleCfitsioWrapper/FileWrapper.h"
+  #include "EleCfitsioWrapper/HduWrapper.h"
+  #include "EleFits/BintableStreamReader.h"
+
+  #include <algorithm>
+  #include <fstream>
+
+namespace Euclid {
+namespace Fits {
+
+template <typename... Ts>
+BintableStreamReader<Ts...>::Iterator::Iterator(BintableStreamReader& reader, long front) :
+    m_reader(&reader), m_front(front), m_batch(reader.view(reader.m_buffer, 0, std::index_sequence_for<Ts...>())) {
+  if (m_front < m_reader->m_rowCount) {
+    m_batch = m_reader->read(m_front);
+  }
+}
+
+template <typename... Ts>
+const typename BintableStreamReader<Ts...>::Batch& BintableStreamReader<Ts...>::Iterator::operator*() const {
+  return m_batch;
+}
+
+template <typename... Ts>
+const typename BintableStreamReader<Ts...>::Batch* BintableStreamReader<Ts...>::Iterator::operator->() const {
+  return &m_batch;
+}
+
+template <typename... Ts>
+typename BintableStreamReader<Ts...>::Iterator& BintableStreamReader<Ts...>::Iterator::operator++() {
+  m_front = std::min(m_front + m_reader->batchRowCount(), m_reader->m_rowCount);
+  if (m_front < m_reader->m_rowCount) {
+    m_batch = m_reader->read(m_front);
+  }
+  return *this;
+}
+
+template <typename... Ts>
+bool BintableStreamReader<Ts...>::Iterator::operator==(const Iterator& rhs) const {
+  return m_reader == rhs.m_reader && m_front == rhs.m_front;
+}
+
+template <typename... Ts>
+bool BintableStreamReader<Ts...>::Iterator::operator!=(const Iterator& rhs) const {
+  return not(*this == rhs);
+}
+
+template <typename... Ts>
+BintableStreamReader<Ts...>::BintableStreamReader(
+    const BintableColumns& columns,
+    long batchRowCount,
+    const Indexed<Ts>&... indices) :
+    m_columns(columns),
+    m_indices { indices.index... },
+    m_buffer { VecColumn<Ts>(columns.readInfo<Ts>(indices.index), alignBatchRowCount(columns, batchRowCount))... },
+    m_rowCount(columns.readRowCount()), m_prefetcher() {}
+
+template <typename... Ts>
+long BintableStreamReader<Ts...>::alignBatchRowCount(const BintableColumns& columns, long batchRowCount) {
+  const long bufferRowCount = std::max(1L, columns.readBufferRowCount());
+  const long bufferCount = (std::max(1L, batchRowCount) + bufferRowCount - 1) / bufferRowCount;
+  return bufferCount * bufferRowCount;
+}
+
+template <typename... Ts>
+long BintableStreamReader<Ts...>::batchRowCount() const {
+  return std::get<0>(m_buffer).rowCount();
+}
+
+template <typename... Ts>
+long BintableStreamReader<Ts...>::rowCount() const {
+  return m_rowCount;
+}
+
+template <typename... Ts>
+bool BintableStreamReader<Ts...>::prefetch(long queueDepth) {
+
+  /* Check whether raw decoding is possible */
+  bool isDecodable = queueDepth > 0 && Cfitsio::FileAccess::isDiskFile(m_columns.m_fptr);
+  auto it = m_indices.begin();
+  seqForeach(m_buffer, [&](const auto& c) {
+    using Value = std::decay_t<typename std::decay_t<decltype(c)>::Value>;
+    isDecodable &= m_columns.template isRawCodable<Value>(*it, c.info().repeatCount);
+    ++it;
+  });
+  if (not isDecodable) {
+    return false;
+  }
+
+  /* Open an independent stream */
+  const auto& schema = m_columns.schema();
+  m_columns.m_touch();
+  Cfitsio::FileAccess::flush(m_columns.m_fptr);
+  const auto filename = Cfitsio::FileAccess::name(m_columns.m_fptr);
+  const long dataOffset = Cfitsio::HduAccess::currentDataOffset(m_columns.m_fptr);
+  auto file = std::make_shared<std::ifstream>(filename, std::ios::binary);
+  if (not file->is_open()) {
+    throw FitsError("Cannot open file for prefetching: " + filename);
+  }
+
+  /* Read and decode by chunks */
+  const long rowWidth = schema.rowWidth;
+  const long batchSize = batchRowCount();
+  const long rowCount = m_rowCount;
+  std::vector<long> byteOffsets;
+  for (auto i : m_indices) {
+    byteOffsets.push_back(schema.byteOffsets[i]);
+  }
+  auto block = std::make_shared<std::vector<unsigned char>>(batchSize * rowWidth);
+  const auto reader = [=](long step, Buffer& buffer) {
+    const long front = step * batchSize;
+    const long size = std::min(batchSize, rowCount - front);
+    file->seekg(dataOffset + front * rowWidth);
+    file->read(reinterpret_cast<char*>(block->data()), size * rowWidth);
+    if (not *file) {
+      throw FitsError("Cannot prefetch rows from: " + filename);
+    }
+    auto offset = byteOffsets.begin();
+    seqForeach(buffer, [&](auto& c) {
+      Cfitsio::decodeField(block->data(), size, rowWidth, *offset, c.info().repeatCount, c.data());
+      ++offset;
+    });
+  };
+  const long batchCount = (rowCount + batchSize - 1) / batchSize;
+  m_prefetcher.reset(new Prefetcher<Buffer>(batchCount, queueDepth, m_buffer, reader));
+  return true;
+}
+
+template <typename... Ts>
+PrefetchMetrics BintableStreamReader<Ts...>::metrics() const {
+  return m_prefetcher ? m_prefetcher->metrics() : PrefetchMetrics();
+}
+
+template <typename... Ts>
+typename BintableStreamReader<Ts...>::Iterator BintableStreamReader<Ts...>::begin() {
+  return Iterator(*this, 0);
+}
+
+template <typename... Ts>
+typename BintableStreamReader<Ts...>::Iterator BintableStreamReader<Ts...>::end() {
+  return Iterator(*this, m_rowCount);
+}
+
+template <typename... Ts>
+typename BintableStreamReader<Ts...>::Batch BintableStreamReader<Ts...>::read(long front) {
+  const long size = std::min(batchRowCount(), m_rowCount - front);
+  if (m_prefetcher) {
+    return view(m_prefetcher->next(), size, std::index_sequence_for<Ts...>());
+  }
+  m_columns.readSegmentSeqRawTo({ front, Segment::fromSize(0, size) }, m_indices, m_buffer);
+  return view(m_buffer, size, std::index_sequence_for<Ts...>());
+}
+
+template <typename... Ts>
+template <std::size_t... Is>
+typename BintableStreamReader<Ts...>::Batch
+BintableStreamReader<Ts...>::view(Buffer& buffer, long size, std::index_sequence<Is...>) {
+  return Batch { PtrColumn<Ts>(
+      std::get<Is>(buffer).info(),
+      std::get<Is>(buffer).elementCount() / batchRowCount() * size,
+      std::get<Is>(buffer).data())... };
+}
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
@@ -0,0 +1,158 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#if defined(_ELEFITS_BINTABLESTREAMWRITER_IMPL) || defined(CHECK_QUALITY)
+
+  #include "EleFits/BintableStreamWriter.h"
+  #include "EleFitsData/FitsError.h"
+  #include "ElementsKernel/Logging.h"
+
+  #include <algorithm>
+
+namespace Euclid {
+namespace Fits {
+
+template <typename... Ts>
+BintableStreamWriter<Ts...>::BintableStreamWriter(const BintableColumns& columns, const ColumnInfo<Ts>&... infos) :
+    m_columns(columns), m_buffer { VecColumn<Ts>(infos, std::max(1L, columns.readBufferRowCount()))... },
+    m_bufferedRowCount(0), m_writtenRowCount(columns.readRowCount()), m_isScalar(true), m_isOpen(true) {
+  seqForeach(m_buffer, [&](const auto& c) {
+    m_isScalar &= c.elementCount() == c.rowCount();
+  });
+  m_columns.reserve(m_writtenRowCount + batchRowCount()); // Then grown geometrically by the handler
+}
+
+template <typename... Ts>
+BintableStreamWriter<Ts...>::BintableStreamWriter(BintableStreamWriter&& other) :
+    m_columns(other.m_columns), m_buffer(std::move(other.m_buffer)), m_bufferedRowCount(other.m_bufferedRowCount),
+    m_writtenRowCount(other.m_writtenRowCount), m_isScalar(other.m_isScalar), m_isOpen(other.m_isOpen) {
+  other.m_isOpen = false;
+}
+
+template <typename... Ts>
+BintableStreamWriter<Ts...>::~BintableStreamWriter() {
+  try {
+    close();
+  } catch (const std::exception& e) { // Destructors must not throw
+    Elements::Logging::getLogger("EleFits").error() << "Cannot close binary table writer: " << e.what();
+  }
+}
+
+template <typename... Ts>
+long BintableStreamWriter<Ts...>::batchRowCount() const {
+  return std::get<0>(m_buffer).rowCount();
+}
+
+template <typename... Ts>
+long BintableStreamWriter<Ts...>::rowCount() const {
+  return m_writtenRowCount + m_bufferedRowCount;
+}
+
+template <typename... Ts>
+long BintableStreamWriter<Ts...>::capacity() const {
+  return m_columns.readCapacity();
+}
+
+template <typename... Ts>
+void BintableStreamWriter<Ts...>::appendRow(const Ts&... values) {
+  mayThrowClosed();
+  if (not m_isScalar) {
+    throw FitsError("Cannot append a single row to vector columns: use appendBatch() instead.");
+  }
+  bufferRow(std::forward_as_tuple(values...), std::index_sequence_for<Ts...>());
+  ++m_bufferedRowCount;
+  if (m_bufferedRowCount == batchRowCount()) {
+    flush();
+  }
+}
+
+template <typename... Ts>
+void BintableStreamWriter<Ts...>::appendBatch(const Column<Ts>&... columns) {
+  mayThrowClosed();
+  const auto batch = std::forward_as_tuple(columns...);
+  const long count = columnsRowCount(batch);
+  if (m_bufferedRowCount + count > batchRowCount()) {
+    flush();
+  }
+  if (count >= batchRowCount()) { // No copy
+    writeRows(batch, count);
+    return;
+  }
+  bufferBatch(batch, count, std::index_sequence_for<Ts...>());
+  m_bufferedRowCount += count;
+}
+
+template <typename... Ts>
+void BintableStreamWriter<Ts...>::flush() {
+  if (m_bufferedRowCount == 0) {
+    return;
+  }
+  writeRows(m_buffer, m_bufferedRowCount);
+  m_bufferedRowCount = 0;
+}
+
+template <typename... Ts>
+void BintableStreamWriter<Ts...>::close() {
+  if (not m_isOpen) {
+    return;
+  }
+  flush();
+  m_columns.shrinkToFit();
+  m_isOpen = false;
+}
+
+template <typename... Ts>
+template <typename TSeq>
+void BintableStreamWriter<Ts...>::writeRows(TSeq&& columns, long count) {
+  m_columns.writeSegmentSeq({ m_writtenRowCount, Segment::fromSize(0, count) }, std::forward<TSeq>(columns));
+  m_writtenRowCount += count;
+}
+
+template <typename... Ts>
+template <std::size_t... Is>
+void BintableStreamWriter<Ts...>::bufferBatch(
+    const std::tuple<const Column<Ts>&...>& columns,
+    long count,
+    std::index_sequence<Is...>) {
+  const auto copy = [&](const auto& input, auto& output) {
+    const long entrySize = output.elementCount() / output.rowCount();
+    std::copy(input.data(), input.data() + count * entrySize, output.data() + m_bufferedRowCount * entrySize);
+  };
+  using mockUnpack = int[];
+  (void)mockUnpack { 0, (copy(std::get<Is>(columns), std::get<Is>(m_buffer)), 0)... };
+}
+
+template <typename... Ts>
+template <std::size_t... Is>
+void BintableStreamWriter<Ts...>::bufferRow(const std::tuple<const Ts&...>& values, std::index_sequence<Is...>) {
+  using mockUnpack = int[];
+  (void)mockUnpack { 0, (std::get<Is>(m_buffer).data()[m_bufferedRowCount] = std::get<Is>(values), 0)... };
+}
+
+template <typename... Ts>
+void BintableStreamWriter<Ts...>::mayThrowClosed() const {
+  if (not m_isOpen) {
+    throw FitsError("Cannot write to a closed stream writer.");
+  }
+}
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
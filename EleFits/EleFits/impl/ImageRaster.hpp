@@ -19,8 +19,14 @@
 
 #if defined(_ELEFITS_IMAGERASTER_IMPL) || defined(CHECK_QUALITY)
 
+  #include "EleCfitsioWrapper/ByteSwap.h"
+  #include "EleCfitsioWrapper/HduWrapper.h"
   #include "EleCfitsioWrapper/ImageWrapper.h"
   #include "EleFits/ImageRaster.h"
+  #include "EleFits/ImageTiles.h"
+
+  #include <fstream>
+  #include <memory>
 
 namespace Euclid {
 namespace Fits {
@@ -71,12 +77,91 @@ VecRaster<T, m> ImageRaster::readRegion(const Region<n>& region) const {
 
 template <typename T, long m, long n>
 void ImageRaster::readRegionTo(FileMemRegions<n> regions, Raster<T, m>& raster) const {
-  const auto& memRegion = regions.inMemory();
+  regions.resolve(readShape<n>() - 1, raster.shape() - 1);
+  const auto& memRegion = regions.memory();
   if (raster.isContiguous(memRegion)) {
-    readRegionToSlice(regions.inFile().front, raster.slice(memRegion));
+    auto slice = raster.slice(memRegion);
+    readRegionToSlice(regions.file().front, slice);
   } else {
-    readRegionToSubraster(regions.inFile().front, raster.subraster(memRegion));
+    auto subraster = raster.subraster(memRegion);
+    readRegionToSubraster(regions.file().front, subraster);
+  }
+}
+
+template <typename T, long m, long n>
+VecRaster<T, m> ImageRaster::readRegion(const Region<n>& region, const Position<n>& step) const {
+  m_touch();
+  return Cfitsio::ImageIo::readRegion<T, m, n>(m_fptr, region, step);
+}
+
+template <typename T, long m, long n>
+VecRaster<T, m>
+ImageRaster::readRegion(const Region<n>& region, const Position<n>& binShape, Aggregation aggregation) const {
+  m_touch();
+  return Cfitsio::ImageIo::readRegion<T, m, n>(m_fptr, region, binShape, aggregation);
+}
+
+template <typename T, long m, long n>
+std::vector<VecRaster<T, m>> ImageRaster::readRegions(const std::vector<Region<n>>& regions) const {
+  m_touch();
+  return Cfitsio::ImageIo::readRegions<T, m, n>(m_fptr, regions);
+}
+
+template <typename T, long m, long n>
+Prefetcher<VecRaster<T, m>> ImageRaster::prefetchRegions(const std::vector<Region<n>>& regions, long queueDepth) const {
+  const long regionCount = regions.size();
+  const VecRaster<T, m> prototype(
+      regions.empty() ? Position<m>::zero() : regions[0].shape().template slice<m>()); // Reshaped by the reader
+  m_touch();
+
+  /* Synchronous case */
+  if (queueDepth <= 0 || not Cfitsio::FileAccess::isDiskFile(m_fptr) ||
+      not Cfitsio::ImageIo::isRawDecodable<T>(m_fptr)) {
+    return Prefetcher<VecRaster<T, m>>(regionCount, 0, prototype, [this, regions](long step, VecRaster<T, m>& raster) {
+      m_touch();
+      raster = Cfitsio::ImageIo::readRegion<T, m, n>(m_fptr, regions[step]);
+    });
   }
+
+  /* Open an independent stream */
+  Cfitsio::FileAccess::flush(m_fptr);
+  const auto filename = Cfitsio::FileAccess::name(m_fptr);
+  const long dataOffset = Cfitsio::HduAccess::currentDataOffset(m_fptr);
+  const auto shape = Cfitsio::ImageIo::readShape<n>(m_fptr);
+  auto file = std::make_shared<std::ifstream>(filename, std::ios::binary);
+  if (not file->is_open()) {
+    throw FitsError("Cannot open file for prefetching: " + filename);
+  }
+
+  /* Read line by line and decode */
+  auto bytes = std::make_shared<std::vector<unsigned char>>();
+  const auto reader = [=](long step, VecRaster<T, m>& raster) {
+    const auto& region = regions[step];
+    const long size = region.size();
+    const long lineSize = region.shape()[0];
+    const long lineBytes = lineSize * sizeof(T);
+    raster = VecRaster<T, m>(region.shape().template slice<m>());
+    bytes->resize(size * sizeof(T));
+    auto lines = region;
+    lines.back[0] = lines.front[0];
+    auto* line = bytes->data();
+    for (const auto& front : lines) {
+      long index = 0;
+      long stride = 1;
+      for (long i = 0; i < shape.size(); ++i) {
+        index += front[i] * stride;
+        stride *= shape[i];
+      }
+      file->seekg(dataOffset + index * sizeof(T));
+      file->read(reinterpret_cast<char*>(line), lineBytes);
+      line += lineBytes;
+    }
+    if (not *file) {
+      throw FitsError("Cannot prefetch image region from: " + filename);
+    }
+    Cfitsio::decodeField(bytes->data(), 1, size * sizeof(T), 0, size, raster.data());
+  };
+  return Prefetcher<VecRaster<T, m>>(regionCount, queueDepth, prototype, reader);
 }
 
 template <typename T, long n>
@@ -84,6 +169,26 @@ void ImageRaster::readRegionTo(Subraster<T, n>& subraster) const {
   readRegionToSubraster(subraster.region().front, subraster);
 }
 
+template <typename T, long n>
+ImageTiles<T, n> ImageRaster::tiles(const Position<n>& tileShape, const Position<n>& overlap) const {
+  return ImageTiles<T, n>(*this, tileShape, overlap, false);
+}
+
+template <typename T, long n>
+ImageTiles<T, n> ImageRaster::tiles(const Position<n>& tileShape) const {
+  return tiles<T, n>(tileShape, tileShape - tileShape);
+}
+
+template <typename T, long n>
+ImageTiles<T, n> ImageRaster::editTiles(const Position<n>& tileShape, const Position<n>& overlap) const {
+  return ImageTiles<T, n>(*this, tileShape, overlap, true);
+}
+
+template <typename T, long n>
+ImageTiles<T, n> ImageRaster::editTiles(const Position<n>& tileShape) const {
+  return editTiles<T, n>(tileShape, tileShape - tileShape);
+}
+
 template <typename T, long m, long n>
 void ImageRaster::readRegionToSlice(const Position<n>& frontPosition, Raster<T, m>& raster) const {
   m_touch();
@@ -132,20 +237,7 @@ void ImageRaster::writeSlice(const Position<n>& frontPosition, const Raster<T, m
 template <typename T, long m, long n>
 void ImageRaster::writeSubraster(const Position<n>& frontPosition, const Subraster<T, m>& subraster) const {
   m_edit();
-  int status = 0;
-  auto locus = Region<m>::fromShape(Position<m>::zero(), subraster.shape());
-  locus.back[0] = locus.front[0];
-  const auto nelem = subraster.shape()[0];
-  const auto delta = frontPosition.template slice<m>();
-  auto target = frontPosition;
-  for (const auto& source : locus) {
-    target = (source + delta).extend(frontPosition) + 1; // 1-based
-    const auto begin = &subraster[source];
-    const auto end = begin + nelem;
-    std::vector<std::decay_t<T>> nonconstData(begin, end);
-    fits_write_pix(m_fptr, Cfitsio::TypeCode<T>::forImage(), target.data(), nelem, nonconstData.data(), &status);
-    // TODO to ImageWrapper
-  }
+  Cfitsio::ImageIo::writeRegion(m_fptr, subraster, frontPosition);
 }
 
 } // namespace Fits
@@ -0,0 +1,263 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+#if defined(_ELEFITS_IMAGETILES_IMPL) || defined(CHECK_QUALITY)
+
+  #include "EleFits/ImageTiles.h"
+  #include "EleFitsData/FitsError.h"
+  #include "ElementsKernel/Logging.h"
+
+  #include <algorithm> // max, min
+
+namespace Euclid {
+namespace Fits {
+
+template <typename T, long n>
+ImageTiles<T, n>::ImageTiles(
+    const ImageRaster& raster,
+    const Position<n>& tileShape,
+    const Position<n>& overlap,
+    bool isWriteBack) :
+    m_raster(raster),
+    m_shape(raster.readShape<n>()), m_tileShape(tileShape), m_overlap(overlap), m_gridShape(m_shape),
+    m_isWriteBack(isWriteBack), m_isPending(false), m_buffer(),
+    m_tile(m_shape, nullptr), m_pool(), m_freeSlots(m_shape.size()), m_heldBack() {
+  if (m_tileShape.size() != m_shape.size() || m_overlap.size() != m_shape.size()) {
+    throw FitsError("Tile shape and overlap dimensions must match the image dimension.");
+  }
+  auto bufferShape = m_shape;
+  for (long i = 0; i < m_shape.size(); ++i) {
+    if (m_tileShape[i] <= 0 || m_overlap[i] < 0) {
+      throw FitsError("Tile shape must be positive, and overlap non-negative.");
+    }
+    m_gridShape[i] = (m_shape[i] + m_tileShape[i] - 1) / m_tileShape[i];
+    bufferShape[i] = std::min(m_tileShape[i] + 2 * m_overlap[i], m_shape[i]);
+  }
+  m_buffer.resize(shapeSize(bufferShape));
+  if (not m_isWriteBack) {
+    return;
+  }
+
+  /* Size the pool for the strips along each axis, which live at most until the last tile which reads them */
+  std::vector<long> slotCounts(m_shape.size(), 0);
+  std::vector<long> slotSizes(m_shape.size(), 0);
+  long lifetime = 0;
+  long stride = 1;
+  for (long i = 0; i < m_shape.size(); ++i) {
+    const long reach = (m_overlap[i] + m_tileShape[i] - 1) / m_tileShape[i]; // Number of neighbor tiles in the halo
+    lifetime += std::min(reach, m_gridShape[i] - 1) * stride;
+    stride *= m_gridShape[i];
+    if (m_overlap[i] == 0 || m_gridShape[i] == 1) {
+      continue;
+    }
+    slotCounts[i] = std::min(lifetime + 1, size());
+    slotSizes[i] = std::min(m_overlap[i], m_tileShape[i]);
+    for (long j = 0; j < m_shape.size(); ++j) {
+      slotSizes[i] *= j == i ? 1 : std::min(m_tileShape[j], m_shape[j]);
+    }
+  }
+  long poolSize = 0;
+  long slotCount = 0;
+  for (long i = 0; i < m_shape.size(); ++i) {
+    poolSize += slotCounts[i] * slotSizes[i];
+    slotCount += slotCounts[i];
+  }
+  m_pool.resize(poolSize);
+  m_heldBack.reserve(slotCount);
+  auto* slot = m_pool.data();
+  for (long i = 0; i < m_shape.size(); ++i) {
+    m_freeSlots[i].reserve(slotCounts[i]);
+    for (long s = 0; s < slotCounts[i]; ++s, slot += slotSizes[i]) {
+      m_freeSlots[i].push_back(slot);
+    }
+  }
+}
+
+template <typename T, long n>
+ImageTiles<T, n>::ImageTiles(ImageTiles&& other) :
+    m_raster(other.m_raster), m_shape(std::move(other.m_shape)), m_tileShape(std::move(other.m_tileShape)),
+    m_overlap(std::move(other.m_overlap)), m_gridShape(std::move(other.m_gridShape)),
+    m_isWriteBack(other.m_isWriteBack), m_isPending(other.m_isPending), m_buffer(std::move(other.m_buffer)),
+    m_tile(std::move(other.m_tile)), // The buffer data is not reallocated, such that the tile view remains valid
+    m_pool(std::move(other.m_pool)), m_freeSlots(std::move(other.m_freeSlots)),
+    m_heldBack(std::move(other.m_heldBack)) { // Idem for the pool and the strips
+  other.m_isPending = false;
+}
+
+template <typename T, long n>
+ImageTiles<T, n>::~ImageTiles() {
+  try {
+    flush();
+  } catch (const std::exception& e) { // Destructors must not throw
+    Elements::Logging::getLogger("EleFits").error() << "Cannot write back image tiles: " << e.what();
+  }
+}
+
+template <typename T, long n>
+long ImageTiles<T, n>::size() const {
+  return shapeSize(m_gridShape);
+}
+
+template <typename T, long n>
+const Position<n>& ImageTiles<T, n>::gridShape() const {
+  return m_gridShape;
+}
+
+template <typename T, long n>
+long ImageTiles<T, n>::capacity() const {
+  return m_buffer.size();
+}
+
+template <typename T, long n>
+typename ImageTiles<T, n>::Iterator ImageTiles<T, n>::begin() {
+  load(0);
+  return Iterator(*this, 0);
+}
+
+template <typename T, long n>
+typename ImageTiles<T, n>::Iterator ImageTiles<T, n>::end() {
+  return Iterator(*this, size());
+}
+
+template <typename T, long n>
+void ImageTiles<T, n>::flush() {
+  holdBack(size());
+  writeBack(size());
+}
+
+template <typename T, long n>
+void ImageTiles<T, n>::load(long index) {
+  holdBack(index);
+  writeBack(index);
+  if (index < 0 || index >= size()) {
+    return;
+  }
+
+  /* Tile position in the grid, in file order */
+  auto& region = m_tile.m_region;
+  auto& halo = m_tile.m_haloRegion;
+  region = Region<n> { m_shape, m_shape }; // Resized for n = -1
+  halo = region;
+  long remainder = index;
+  for (long i = 0; i < m_shape.size(); ++i) {
+    const long front = remainder % m_gridShape[i] * m_tileShape[i];
+    remainder /= m_gridShape[i];
+    region.front[i] = front;
+    region.back[i] = std::min(front + m_tileShape[i], m_shape[i]) - 1;
+    halo.front[i] = std::max(region.front[i] - m_overlap[i], 0L);
+    halo.back[i] = std::min(region.back[i] + m_overlap[i], m_shape[i] - 1);
+  }
+
+  /* Read into the buffer */
+  m_tile.m_raster = PtrRaster<T, n>(halo.shape(), m_buffer.data());
+  m_raster.readRegionToSlice(halo.front, m_tile.m_raster);
+  m_isPending = true;
+}
+
+template <typename T, long n>
+void ImageTiles<T, n>::holdBack(long index) {
+  if (not m_isPending) {
+    return;
+  }
+  m_isPending = false;
+  if (not m_isWriteBack) {
+    return;
+  }
+
+  /* Split the core into the interior and the upper margins which the halos of the next tiles overlap */
+  const auto& core = m_tile.m_region;
+  const auto& front = m_tile.m_haloRegion.front;
+  auto interior = core;
+  for (long i = 0; i < m_shape.size(); ++i) {
+    if (core.back[i] < m_shape[i] - 1) {
+      interior.back[i] = std::max(core.back[i] - m_overlap[i], core.front[i] - 1);
+    }
+  }
+
+  /* Write the interior straight away */
+  const auto write = [&](const Region<n>& region) {
+    const Subraster<T, n> pixels(m_tile.m_raster, { region.front - front, region.back - front });
+    m_raster.writeSubraster(region.front, pixels);
+  };
+  if (interior.size() > 0) {
+    write(interior);
+  }
+
+  /* Along each axis, the strip spans the core along the lower axes, and the interior along the upper axes */
+  for (long i = 0; i < m_shape.size(); ++i) {
+    if (interior.back[i] == core.back[i]) {
+      continue;
+    }
+    Region<n> strip = core;
+    strip.front[i] = interior.back[i] + 1;
+    for (long j = i + 1; j < m_shape.size(); ++j) {
+      strip.back[j] = interior.back[j];
+    }
+    if (strip.size() <= 0) {
+      continue;
+    }
+    if (lastReader(strip) < index) {
+      write(strip);
+      continue;
+    }
+    auto& slots = m_freeSlots[i];
+    if (slots.empty()) {
+      throw FitsError("Tile strip pool is exhausted."); // Should not happen, as the pool is sized for the worst case
+    }
+    PtrRaster<T, n> copy(strip.shape(), slots.back());
+    slots.pop_back();
+    for (const auto& p : strip) {
+      copy[p - strip.front] = m_tile[p];
+    }
+    m_heldBack.push_back({ strip, i, copy.data() });
+  }
+}
+
+template <typename T, long n>
+void ImageTiles<T, n>::writeBack(long index) {
+  auto it = m_heldBack.begin();
+  while (it != m_heldBack.end()) {
+    const auto& region = it->region;
+    if (lastReader(region) < index) { // Not monotonous because of the clipping at the upper edges
+      PtrRaster<T, n> strip(region.shape(), it->data);
+      const Subraster<T, n> pixels(strip, { region.front - region.front, region.back - region.front });
+      m_raster.writeSubraster(region.front, pixels);
+      m_freeSlots[it->axis].push_back(it->data);
+      it = m_heldBack.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+template <typename T, long n>
+long ImageTiles<T, n>::lastReader(const Region<n>& region) const {
+  long index = 0;
+  long stride = 1;
+  for (long i = 0; i < m_shape.size(); ++i) {
+    const long last = (region.back[i] + m_overlap[i]) / m_tileShape[i]; // Last tile whose halo front is in the region
+    index += std::min(last, m_gridShape[i] - 1) * stride;
+    stride *= m_gridShape[i];
+  }
+  return index;
+}
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
@@ -19,8 +19,12 @@
 
 #if defined(_ELEFITS_MEFFILE_IMPL) || defined(CHECK_QUALITY)
 
+  #include "EleCfitsioWrapper/FileWrapper.h"
   #include "EleFits/MefFile.h"
 
+  #include <algorithm>
+  #include <functional>
+
 namespace Euclid {
 namespace Fits {
 
@@ -32,6 +36,9 @@ const T& MefFile::access(long index) {
   if (ptr == nullptr) {
     if (hduType == HduCategory::Image) {
       ptr.reset(new ImageHdu(Hdu::Token {}, m_fptr, index));
+    } else if (hduType == HduCategory::Bintable && Cfitsio::BintableIo::isCompressed(m_fptr)) {
+      const auto compression = Cfitsio::BintableIo::readCompression(m_fptr);
+      ptr.reset(new BintableHdu(Hdu::Token {}, m_fptr, index, HduCategory::Untouched, compression));
     } else if (hduType == HduCategory::Bintable) {
       ptr.reset(new BintableHdu(Hdu::Token {}, m_fptr, index));
     } else {
@@ -96,6 +103,24 @@ const ImageHdu& MefFile::assignImageExt(const std::string& name, const Raster<T,
   return m_hdus[size]->as<ImageHdu>();
 }
 
+template <typename T, long n>
+const ImageHdu&
+MefFile::initImageExt(const std::string& name, const Position<n>& shape, const ImageCompression& compression) {
+  Cfitsio::HduAccess::createImageExtension<T, n>(m_fptr, name, shape, compression);
+  const auto size = m_hdus.size();
+  m_hdus.push_back(std::make_unique<ImageHdu>(Hdu::Token {}, m_fptr, size, HduCategory::Created));
+  return m_hdus[size]->as<ImageHdu>();
+}
+
+template <typename T, long n>
+const ImageHdu&
+MefFile::assignImageExt(const std::string& name, const Raster<T, n>& raster, const ImageCompression& compression) {
+  Cfitsio::HduAccess::createImageExtension(m_fptr, name, raster, compression);
+  const auto size = m_hdus.size();
+  m_hdus.push_back(std::make_unique<ImageHdu>(Hdu::Token {}, m_fptr, size, HduCategory::Created));
+  return m_hdus[size]->as<ImageHdu>();
+}
+
 template <typename... Ts>
 const BintableHdu& MefFile::initBintableExt(const std::string& name, const ColumnInfo<Ts>&... header) {
   Cfitsio::HduAccess::createBintableExtension(m_fptr, name, header...);
@@ -104,22 +129,64 @@ const BintableHdu& MefFile::initBintableExt(const std::string& name, const Colum
   return m_hdus[size]->as<BintableHdu>();
 }
 
-template <typename... Ts>
-const BintableHdu& MefFile::assignBintableExt(const std::string& name, const Column<Ts>&... columns) {
-  Cfitsio::HduAccess::createBintableExtension(m_fptr, name, columns...);
+template <typename... TCols>
+const BintableHdu& MefFile::initBintableExt(const std::string& name, const TableSchema<TCols...>& schema) {
+  Cfitsio::HduAccess::createBintableExtension(m_fptr, name, schema.names(), schema.tforms(), schema.units());
   const auto size = m_hdus.size();
   m_hdus.push_back(std::make_unique<BintableHdu>(Hdu::Token {}, m_fptr, size, HduCategory::Created));
   return m_hdus[size]->as<BintableHdu>();
 }
 
-template <typename Tuple, std::size_t count>
-const BintableHdu& MefFile::assignBintableExt(const std::string& name, const Tuple& columns) {
-  Cfitsio::HduAccess::createBintableExtension<Tuple, count>(m_fptr, name, columns);
+template <typename... Ts>
+const BintableHdu& MefFile::initBintableExt(
+    const std::string& name,
+    const TableCompression& compression,
+    const ColumnInfo<Ts>&... header) {
+  auto buffer = Cfitsio::FileAccess::createAndOpen("mem://", Cfitsio::FileAccess::CreatePolicy::CreateOnly);
+  try {
+    Cfitsio::HduAccess::createBintableExtension(buffer, name, header...);
+    Cfitsio::BintableIo::compress(buffer, compression, m_fptr); // Empty table, such that the HDU exists
+  } catch (...) {
+    Cfitsio::FileAccess::close(buffer);
+    throw;
+  }
   const auto size = m_hdus.size();
-  m_hdus.push_back(std::make_unique<BintableHdu>(Hdu::Token {}, m_fptr, size, HduCategory::Created));
+  m_hdus.push_back(
+      std::make_unique<BintableHdu>(Hdu::Token {}, m_fptr, size, HduCategory::Created, compression, buffer));
   return m_hdus[size]->as<BintableHdu>();
 }
 
+template <typename... Ts>
+BintableStreamWriter<Ts...> MefFile::initBintableStream(const std::string& name, const ColumnInfo<Ts>&... infos) {
+  const auto& ext = initBintableExt(name, infos...);
+  return BintableStreamWriter<Ts...>(ext.columns(), infos...);
+}
+
+template <typename... Ts>
+const BintableHdu& MefFile::assignBintableExt(const std::string& name, const Column<Ts>&... columns) {
+  const std::vector<long> rowCounts { columns.rowCount()... };
+  if (rowCounts.empty() ||
+      std::adjacent_find(rowCounts.begin(), rowCounts.end(), std::not_equal_to<long>()) != rowCounts.end()) {
+    Cfitsio::HduAccess::createBintableExtension(m_fptr, name, columns...); // Pads shorter columns
+    const auto size = m_hdus.size();
+    m_hdus.push_back(std::make_unique<BintableHdu>(Hdu::Token {}, m_fptr, size, HduCategory::Created));
+    return m_hdus[size]->as<BintableHdu>();
+  }
+  const auto& ext = initBintableExt(name, columns.info()...);
+  ext.columns().writeSeq(std::forward_as_tuple(columns...)); // Row-major encoding
+  return ext;
+}
+
+template <typename Tuple, std::size_t count>
+const BintableHdu& MefFile::assignBintableExt(const std::string& name, const Tuple& columns) {
+  return Internal::applyImpl(
+      columns,
+      [&](const auto&... cs) -> const BintableHdu& {
+        return assignBintableExt(name, cs...);
+      },
+      std::make_index_sequence<count>());
+}
+
   #ifndef DECLARE_ASSIGN_IMAGE_EXT
     #define DECLARE_ASSIGN_IMAGE_EXT(type, unused) \
       extern template const ImageHdu& MefFile::assignImageExt(const std::string&, const Raster<type, -1>&); \
@@ -0,0 +1,180 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+#if defined(_ELEFITS_TABLESCHEMA_IMPL) || defined(CHECK_QUALITY)
+
+  #include "EleCfitsioWrapper/TypeWrapper.h"
+  #include "EleFits/TableSchema.h"
+  #include "EleFitsData/DataUtils.h"
+
+  #include <type_traits>
+
+namespace Euclid {
+namespace Fits {
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief The value type and number of values of a struct member.
+ */
+template <typename TMember>
+struct MemberTraits {
+  using Value = TMember;
+  static constexpr long count = 1;
+  static Value* data(TMember& member) {
+    return &member;
+  }
+  static const Value* data(const TMember& member) {
+    return &member;
+  }
+};
+
+/**
+ * @brief `std::array` specialization.
+ */
+template <typename T, std::size_t N>
+struct MemberTraits<std::array<T, N>> {
+  using Value = T;
+  static constexpr long count = N;
+  static Value* data(std::array<T, N>& member) {
+    return member.data();
+  }
+  static const Value* data(const std::array<T, N>& member) {
+    return member.data();
+  }
+};
+
+/**
+ * @brief C array specialization.
+ */
+template <typename T, std::size_t N>
+struct MemberTraits<T[N]> {
+  using Value = T;
+  static constexpr long count = N;
+  static Value* data(T (&member)[N]) {
+    return member;
+  }
+  static const Value* data(const T (&member)[N]) {
+    return member;
+  }
+};
+
+/**
+ * @brief Check whether a struct member can be bound to a schema column.
+ * @details
+ * Strings are stored as single `std::string`s, whatever the repeat count.
+ */
+template <typename TCol, typename TMember>
+constexpr bool isBindable() {
+  using Value = typename MemberTraits<TMember>::Value;
+  return std::is_same<Value, typename TCol::Value>::value &&
+      (MemberTraits<TMember>::count == TCol::repeatCount || std::is_same<Value, std::string>::value);
+}
+
+/**
+ * @brief Compile-time conjunction.
+ */
+template <bool... Bs>
+constexpr bool allOf() {
+  return std::is_same<std::integer_sequence<bool, Bs..., true>, std::integer_sequence<bool, true, Bs...>>::value;
+}
+
+} // namespace Internal
+/// @endcond
+
+template <typename T, long N>
+constexpr long SchemaColumn<T, N>::repeatCount;
+
+template <typename... TCols>
+constexpr std::size_t TableSchema<TCols...>::columnCount;
+
+template <typename... TCols>
+TableSchema<TCols...>::TableSchema(TCols... columns) :
+    m_infos(columns.info()...), m_names { columns.name... },
+    m_tforms { Cfitsio::TypeCode<typename TCols::Value>::tform(TCols::repeatCount)... }, m_units { columns.unit... } {}
+
+template <typename... TCols>
+const typename TableSchema<TCols...>::Infos& TableSchema<TCols...>::infos() const {
+  return m_infos;
+}
+
+template <typename... TCols>
+const std::vector<std::string>& TableSchema<TCols...>::names() const {
+  return m_names;
+}
+
+template <typename... TCols>
+const std::vector<std::string>& TableSchema<TCols...>::tforms() const {
+  return m_tforms;
+}
+
+template <typename... TCols>
+const std::vector<std::string>& TableSchema<TCols...>::units() const {
+  return m_units;
+}
+
+template <typename... TCols>
+typename TableSchema<TCols...>::Columns TableSchema<TCols...>::makeColumns(long rowCount) const {
+  return seqTransform<Columns>(m_infos, [&](const auto& info) {
+    return VecColumn<typename std::decay_t<decltype(info)>::Value>(info, rowCount);
+  });
+}
+
+template <typename... TCols>
+template <typename TRow, typename... TMembers>
+RowBinding<TRow, TableSchema<TCols...>, TMembers...> TableSchema<TCols...>::bind(TMembers TRow::*... members) const {
+  static_assert(sizeof...(TMembers) == sizeof...(TCols), "Each column must be bound to exactly one member.");
+  static_assert(
+      Internal::allOf<Internal::isBindable<TCols, TMembers>()...>(),
+      "Member types must match column types and repeat counts.");
+  return { *this, members... };
+}
+
+template <typename... TCols>
+TableSchema<TCols...> makeTableSchema(TCols... columns) {
+  return TableSchema<TCols...>(columns...);
+}
+
+template <typename TRow, typename... TCols, typename... TMembers>
+RowBinding<TRow, TableSchema<TCols...>, TMembers...>::RowBinding(Schema schema, TMembers TRow::*... members) :
+    m_schema(std::move(schema)), m_members(members...) {}
+
+template <typename TRow, typename... TCols, typename... TMembers>
+const TableSchema<TCols...>& RowBinding<TRow, TableSchema<TCols...>, TMembers...>::schema() const {
+  return m_schema;
+}
+
+template <typename TRow, typename... TCols, typename... TMembers>
+template <std::size_t i>
+auto* RowBinding<TRow, TableSchema<TCols...>, TMembers...>::data(TRow& row) const {
+  using Member = std::tuple_element_t<i, std::tuple<TMembers...>>;
+  return Internal::MemberTraits<Member>::data(row.*std::get<i>(m_members));
+}
+
+template <typename TRow, typename... TCols, typename... TMembers>
+template <std::size_t i>
+const auto* RowBinding<TRow, TableSchema<TCols...>, TMembers...>::data(const TRow& row) const {
+  using Member = std::tuple_element_t<i, std::tuple<TMembers...>>;
+  return Internal::MemberTraits<Member>::data(row.*std::get<i>(m_members));
+}
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
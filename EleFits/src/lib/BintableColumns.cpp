@@ -19,6 +19,8 @@
 
 #include "EleFits/BintableColumns.h"
 
+#include <algorithm>
+
 namespace Euclid {
 namespace Fits {
 
@@ -27,57 +29,59 @@ BintableColumns::BintableColumns(
     std::function<void(void)> touchFunc,
     std::function<void(void)> editFunc) :
     m_fptr(fptr),
-    m_touch(touchFunc), m_edit(editFunc) {}
+    m_touch(touchFunc), m_edit(editFunc), m_schema(), m_schemaIsValid(false), m_usedRowCount(-1) {}
 
 long BintableColumns::readColumnCount() const {
-  m_touch();
-  return Cfitsio::BintableIo::columnCount(m_fptr);
+  return schema().names.size();
 }
 
 long BintableColumns::readRowCount() const {
-  m_touch();
-  return Cfitsio::BintableIo::rowCount(m_fptr);
+  return schema().rowCount;
+}
+
+long BintableColumns::readCapacity() const {
+  return schema().capacity;
 }
 
 long BintableColumns::readBufferRowCount() const {
-  long size = 0;
-  int status = 0;
-  fits_get_rowsize(m_fptr, &size, &status);
-  Cfitsio::CfitsioError::mayThrow(status, m_fptr, "Cannot compute buffer row count.");
-  return size;
+  return schema().bufferRowCount;
 }
 
 bool BintableColumns::has(const std::string& name) const {
+  const auto& names = schema().names;
+  if (std::find(names.begin(), names.end(), name) != names.end()) {
+    return true;
+  }
   m_touch();
-  return Cfitsio::BintableIo::hasColumn(m_fptr, name);
+  return Cfitsio::BintableIo::hasColumn(m_fptr, name); // Handle templates
 }
 
 long BintableColumns::readIndex(const std::string& name) const {
+  const auto& names = schema().names;
+  const auto it = std::find(names.begin(), names.end(), name);
+  if (it != names.end()) {
+    return std::distance(names.begin(), it);
+  }
   m_touch();
-  return Cfitsio::BintableIo::columnIndex(m_fptr, name) - 1;
+  return Cfitsio::BintableIo::columnIndex(m_fptr, name) - 1; // Handle templates or throw
 }
 
 std::vector<long> BintableColumns::readIndices(const std::vector<std::string>& names) const {
-  m_touch();
   std::vector<long> indices(names.size());
   std::transform(names.begin(), names.end(), indices.begin(), [&](const std::string& n) {
-    return Cfitsio::BintableIo::columnIndex(m_fptr, n);
+    return readIndex(n);
   });
   return indices;
 }
 
 std::string BintableColumns::readName(long index) const {
-  m_touch();
-  return Cfitsio::BintableIo::columnName(m_fptr, index + 1);
+  const auto& names = schema().names;
+  OutOfBoundsError::mayThrow("Cannot read column name", index, { 0, static_cast<long>(names.size()) - 1 });
+  return names[index];
 }
 
 std::vector<std::string> BintableColumns::readAllNames() const {
-  const auto size = readColumnCount();
-  std::vector<std::string> names(size);
-  for (long i = 0; i < size; ++i) {
-    names[i] = readName(i);
-  }
-  return names;
+  return schema().names;
 }
 
 void BintableColumns::rename(const std::string& name, const std::string& newName) const {
@@ -86,15 +90,139 @@ void BintableColumns::rename(const std::string& name, const std::string& newName
 
 void BintableColumns::rename(long index, const std::string& newName) const {
   m_edit();
+  invalidateSchema();
   Cfitsio::BintableIo::updateColumnName(m_fptr, index + 1, newName);
 }
 
+FixedStringColumn BintableColumns::readFixedString(const std::string& name) const {
+  return readFixedString(readIndex(name));
+}
+
+FixedStringColumn BintableColumns::readFixedString(long index) const {
+  FixedStringColumn column(readInfo<std::string>(index), readRowCount());
+  readSegmentSeqTo(0, std::vector<long> { index }, std::forward_as_tuple(column)); // By chunks
+  return column;
+}
+
+void BintableColumns::readSegmentTo(FileMemSegments rows, long index, FixedStringColumn& column) const {
+  m_touch();
+  rows.resolve(readRowCount() - 1, column.rowCount() - 1);
+  Cfitsio::BintableIo::readColumnSegment(
+      m_fptr,
+      Segment { rows.file().front + 1, rows.file().back + 1 }, // TODO operator+
+      index + 1,
+      column,
+      rows.memory().front);
+}
+
+void BintableColumns::write(const FixedStringColumn& column) const {
+  writeSegmentSeq(0, std::forward_as_tuple(column)); // By chunks
+}
+
+void BintableColumns::writeSegment(FileMemSegments rows, const FixedStringColumn& column) const {
+  writeSegmentImpl(rows, readIndex(column.info().name), column);
+}
+
+void BintableColumns::writeSegmentImpl(FileMemSegments rows, long index, const FixedStringColumn& column) const {
+  m_edit();
+  rows.resolve(readRowCount() - 1, column.rowCount() - 1);
+  growCapacity(rows.file().back);
+  Cfitsio::BintableIo::writeColumnSegment(m_fptr, rows.file().front + 1, index + 1, column, rows.memory());
+  updateRowCount(rows.file().back);
+}
+
+void BintableColumns::initImpl(const std::string& name, const std::string& tform, const std::string& unit, long index)
+    const {
+  m_edit();
+  invalidateSchema();
+  const long cfitsioIndex = index == -1 ? Cfitsio::BintableIo::columnCount(m_fptr) + 1 : index + 1;
+  Cfitsio::BintableIo::initColumns(m_fptr, cfitsioIndex, { name }, { tform }, { unit });
+}
+
+void BintableColumns::initLogical(const ColumnInfo<bool>& info, long index) const {
+  initImpl(info.name, std::to_string(info.repeatCount) + 'L', info.unit, index);
+}
+
+BitColumn BintableColumns::readBits(const std::string& name) const {
+  return readBits(readIndex(name));
+}
+
+BitColumn BintableColumns::readBits(long index) const {
+  BitColumn column(readInfo<bool>(index), readRowCount());
+  readSegmentTo({ Segment { 0, column.rowCount() - 1 }, 0 }, index, column);
+  return column;
+}
+
+void BintableColumns::readSegmentTo(FileMemSegments rows, long index, BitColumn& column) const {
+  m_touch();
+  rows.resolve(readRowCount() - 1, column.rowCount() - 1);
+  const auto& s = schema();
+  const auto letter = bitLetter(index, column.info().repeatCount);
+  const auto repeatCount = column.info().repeatCount;
+  const auto& file = rows.file();
+  const long chunkSize = std::max(1L, readBufferRowCount());
+  std::vector<unsigned char> block;
+  for (long front = file.front; front <= file.back; front += chunkSize) {
+    const long size = std::min(chunkSize, file.back - front + 1);
+    const long firstBit = (rows.memory().front + front - file.front) * repeatCount;
+    block.resize(size * s.rowWidth);
+    Cfitsio::BintableIo::readRowBytes(m_fptr, front + 1, size, s.rowWidth, block.data());
+    const auto decode = letter == 'X' ? Cfitsio::decodeBitField : Cfitsio::decodeLogicalField;
+    decode(block.data(), size, s.rowWidth, s.byteOffsets[index], repeatCount, column.bytes(), firstBit);
+  }
+}
+
+void BintableColumns::write(const BitColumn& column) const {
+  writeSegment(0, column);
+}
+
+void BintableColumns::writeSegment(FileMemSegments rows, const BitColumn& column) const {
+  const auto index = readIndex(column.info().name);
+  m_edit();
+  rows.resolve(readRowCount() - 1, column.rowCount() - 1);
+  growCapacity(rows.file().back);
+  const auto& s = schema();
+  const auto letter = bitLetter(index, column.info().repeatCount);
+  const auto repeatCount = column.info().repeatCount;
+  const auto rowWidth = s.rowWidth;
+  const auto byteOffset = s.byteOffsets[index];
+  const auto rowCount = s.rowCount;
+  const auto& file = rows.file();
+  const long chunkSize = std::max(1L, readBufferRowCount());
+  std::vector<unsigned char> block;
+  for (long front = file.front; front <= file.back; front += chunkSize) {
+    const long size = std::min(chunkSize, file.back - front + 1);
+    const long existingSize = std::min(size, rowCount - front);
+    const long firstBit = (rows.memory().front + front - file.front) * repeatCount;
+    block.assign(size * rowWidth, 0);
+    if (existingSize > 0) {
+      Cfitsio::BintableIo::readRowBytes(m_fptr, front + 1, existingSize, rowWidth, block.data());
+    }
+    const auto encode = letter == 'X' ? Cfitsio::encodeBitField : Cfitsio::encodeLogicalField;
+    encode(column.bytes(), firstBit, size, rowWidth, byteOffset, repeatCount, block.data());
+    Cfitsio::BintableIo::writeRowBytes(m_fptr, front + 1, size, rowWidth, block.data());
+  }
+  updateRowCount(file.back);
+}
+
+char BintableColumns::bitLetter(long index, long repeatCount) const {
+  const auto& s = schema();
+  const auto& tform = s.tforms[index];
+  const auto letterPos = tform.find_first_not_of("0123456789");
+  const auto letter = letterPos == std::string::npos ? '\0' : tform[letterPos];
+  if ((letter != 'X' && letter != 'L') || s.repeatCounts[index] != repeatCount || s.byteOffsets[index] < 0) {
+    throw FitsError("Cannot read or write column #" + std::to_string(index) + " (" + tform + ") as bits");
+  }
+  return letter;
+}
+
 void BintableColumns::remove(const std::string& name) const {
   remove(readIndex(name));
 }
 
 void BintableColumns::remove(long index) const {
   m_edit();
+  invalidateSchema();
   int status = 0;
   fits_delete_col(m_fptr, index + 1, &status);
   Cfitsio::CfitsioError::mayThrow(status, m_fptr, "Cannot remove column #" + std::to_string(index));
@@ -102,14 +230,151 @@ void BintableColumns::remove(long index) const {
 }
 
 void BintableColumns::removeSeq(const std::vector<std::string>& names) const {
-  for (const auto& n : names) {
-    remove(n);
-  }
+  removeSeq(readIndices(names));
 }
 
 void BintableColumns::removeSeq(const std::vector<long>& indices) const {
-  for (const auto& i : indices) {
-    remove(i);
+  std::vector<long> cfitsioIndices(indices.size());
+  std::transform(indices.begin(), indices.end(), cfitsioIndices.begin(), [](long i) {
+    return i + 1;
+  });
+  m_edit();
+  invalidateSchema();
+  Cfitsio::BintableIo::deleteColumns(m_fptr, cfitsioIndices); // Single data unit pass
+}
+
+void BintableColumns::insertRows(long index, long count) const {
+  const auto rowCount = readRowCount();
+  const auto front = index == -1 ? rowCount : index;
+  if (front == rowCount && m_usedRowCount >= 0) { // Reserved rows are zero-initialized
+    growCapacity(rowCount + count - 1);
+    updateRowCount(rowCount + count - 1);
+    return;
+  }
+  m_edit();
+  Cfitsio::BintableIo::insertRows(m_fptr, front + 1, count);
+  if (m_usedRowCount >= 0) {
+    m_usedRowCount += count;
+  }
+  if (m_schemaIsValid) {
+    m_schema.rowCount += count;
+    m_schema.capacity += count;
+  }
+}
+
+void BintableColumns::removeRows(long index, long count) const {
+  m_edit();
+  Cfitsio::BintableIo::deleteRows(m_fptr, index + 1, count);
+  if (m_usedRowCount >= 0) {
+    m_usedRowCount -= count;
+  }
+  if (m_schemaIsValid) {
+    m_schema.rowCount -= count;
+    m_schema.capacity -= count;
+  }
+}
+
+void BintableColumns::reserve(long capacity) const {
+  const auto& s = schema();
+  m_usedRowCount = s.rowCount; // Track the row count from now on
+  if (capacity <= s.capacity) {
+    return;
+  }
+  m_edit();
+  Cfitsio::BintableIo::insertRows(m_fptr, s.capacity + 1, capacity - s.capacity);
+  m_schema.capacity = capacity;
+}
+
+void BintableColumns::shrinkToFit() const {
+  if (m_usedRowCount < 0) {
+    return;
+  }
+  const auto& s = schema();
+  if (s.capacity > s.rowCount) {
+    m_edit();
+    Cfitsio::BintableIo::deleteRows(m_fptr, s.rowCount + 1, s.capacity - s.rowCount);
+    m_schema.capacity = s.rowCount;
+  }
+  m_usedRowCount = -1;
+}
+
+const BintableColumns::Schema& BintableColumns::schema() const {
+  m_touch();
+  if (m_schemaIsValid) {
+    return m_schema;
+  }
+  const long columnCount = Cfitsio::BintableIo::columnCount(m_fptr);
+  m_schema.names.resize(columnCount);
+  m_schema.tforms.resize(columnCount);
+  m_schema.repeatCounts.resize(columnCount);
+  m_schema.units.resize(columnCount);
+  m_schema.shapes.resize(columnCount);
+  m_schema.scales.resize(columnCount);
+  m_schema.zeros.resize(columnCount);
+  m_schema.byteOffsets.resize(columnCount);
+  m_schema.rowWidth = 0;
+  long offset = 0; // -1 after a field of unknown width
+  int status = 0;
+  char ttype[FLEN_VALUE];
+  char tunit[FLEN_VALUE];
+  char tform[FLEN_VALUE];
+  for (long i = 0; i < columnCount; ++i) {
+    fits_get_bcolparms(
+        m_fptr,
+        i + 1,
+        ttype,
+        tunit,
+        nullptr, // dtype
+        &m_schema.repeatCounts[i],
+        &m_schema.scales[i],
+        &m_schema.zeros[i],
+        nullptr, // tnull
+        nullptr, // tdisp
+        &status);
+    const auto keyword = "TFORM" + std::to_string(i + 1);
+    fits_read_key(m_fptr, TSTRING, keyword.c_str(), tform, nullptr, &status);
+    Cfitsio::CfitsioError::mayThrow(status, m_fptr, "Cannot read info of column #" + std::to_string(i));
+    m_schema.names[i] = ttype;
+    m_schema.units[i] = tunit;
+    m_schema.tforms[i] = tform;
+    m_schema.shapes[i] = Cfitsio::BintableIo::readColumnShape(m_fptr, i + 1);
+    m_schema.byteOffsets[i] = offset;
+    const auto width = Cfitsio::BintableIo::fieldByteCount(tform);
+    offset = offset < 0 || width < 0 ? -1 : offset + width;
+  }
+  m_schema.rowWidth = offset;
+  if (offset < 0) {
+    fits_read_key(m_fptr, TLONG, "NAXIS1", &m_schema.rowWidth, nullptr, &status);
+  }
+  m_schema.capacity = Cfitsio::BintableIo::rowCount(m_fptr);
+  m_schema.rowCount = m_usedRowCount >= 0 ? m_usedRowCount : m_schema.capacity;
+  fits_get_rowsize(m_fptr, &m_schema.bufferRowCount, &status);
+  Cfitsio::CfitsioError::mayThrow(status, m_fptr, "Cannot compute buffer row count.");
+  m_schemaIsValid = true;
+  return m_schema;
+}
+
+void BintableColumns::invalidateSchema() const {
+  m_schemaIsValid = false;
+}
+
+void BintableColumns::updateRowCount(long lastRow) const {
+  if (m_usedRowCount >= 0 && lastRow >= m_usedRowCount) {
+    m_usedRowCount = lastRow + 1;
+  }
+  if (m_schemaIsValid && lastRow >= m_schema.rowCount) {
+    m_schema.rowCount = lastRow + 1;
+    m_schema.capacity = std::max(m_schema.capacity, m_schema.rowCount);
+  }
+}
+
+void BintableColumns::growCapacity(long lastRow) const {
+  if (m_usedRowCount < 0) {
+    return;
+  }
+  const auto capacity = readCapacity();
+  if (lastRow >= capacity) {
+    reserve(std::max(lastRow + 1, 2 * capacity)); // Geometric growth
   }
 }
 
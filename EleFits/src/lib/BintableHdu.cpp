@@ -19,41 +19,98 @@
 
 #include "EleFits/BintableHdu.h"
 
+#include "EleCfitsioWrapper/FileWrapper.h"
+#include "EleCfitsioWrapper/HeaderWrapper.h"
+
 namespace Euclid {
 namespace Fits {
 
 BintableHdu::BintableHdu(Token token, fitsfile*& fptr, long index, HduCategory status) :
-    Hdu(token, fptr, index, HduCategory::Bintable, status), m_columns(
-                                                                m_fptr,
-                                                                [&]() {
-                                                                  touchThisHdu();
-                                                                },
-                                                                [&]() {
-                                                                  editThisHdu();
-                                                                }) {}
+    Hdu(token, fptr, index, HduCategory::Bintable, status), m_compressed(false), m_compression(), m_buffer(nullptr),
+    m_bufferEdited(false), m_columns(
+                               m_fptr,
+                               [&]() {
+                                 touchThisHdu();
+                               },
+                               [&]() {
+                                 editThisHdu();
+                               }) {}
+
+BintableHdu::BintableHdu(
+    Token token,
+    fitsfile*& fptr,
+    long index,
+    HduCategory status,
+    TableCompression compression,
+    fitsfile* buffer) :
+    Hdu(token, fptr, index, HduCategory::Bintable, status),
+    m_compressed(true), m_compression(std::move(compression)), m_buffer(buffer), m_bufferEdited(false),
+    m_columns(
+        m_buffer,
+        [&]() {
+          touchBuffer();
+        },
+        [&]() {
+          editBuffer();
+        }) {}
 
 BintableHdu::BintableHdu() :
-    Hdu(), m_columns(
-               m_fptr,
-               [&]() {
-                 touchThisHdu();
-               },
-               [&]() {
-                 editThisHdu();
-               }) {}
+    Hdu(), m_compressed(false), m_compression(), m_buffer(nullptr), m_bufferEdited(false),
+    m_columns(
+        m_fptr,
+        [&]() {
+          touchThisHdu();
+        },
+        [&]() {
+          editThisHdu();
+        }) {}
+
+BintableHdu::~BintableHdu() {
+  if (m_buffer) {
+    int status = 0;
+    fits_close_file(m_buffer, &status); // Memory file: nothing is saved
+  }
+}
+
+bool BintableHdu::isCompressed() const {
+  return m_compressed;
+}
+
+const TableCompression& BintableHdu::compression() const {
+  return m_compression;
+}
+
+void BintableHdu::flush() const {
+  if (not m_buffer) {
+    return;
+  }
+  if (m_bufferEdited) {
+    editThisHdu();
+    Cfitsio::BintableIo::updateCompressed(m_buffer, m_compression, m_fptr);
+    m_bufferEdited = false;
+  }
+  Cfitsio::FileAccess::close(m_buffer); // Sets m_buffer to nullptr
+  m_columns.invalidateSchema(); // Another buffer will be uncompressed at next access
+}
 
 const BintableColumns& BintableHdu::columns() const {
   return m_columns;
 }
 
 long BintableHdu::readColumnCount() const {
-  touchThisHdu();
-  return Cfitsio::BintableIo::columnCount(m_fptr);
+  if (m_compressed && not m_buffer) { // Avoid uncompressing
+    touchThisHdu();
+    return Cfitsio::BintableIo::columnCount(m_fptr);
+  }
+  return m_columns.readColumnCount();
 }
 
 long BintableHdu::readRowCount() const {
-  touchThisHdu();
-  return Cfitsio::BintableIo::rowCount(m_fptr);
+  if (m_compressed && not m_buffer) { // Avoid uncompressing
+    touchThisHdu();
+    return Cfitsio::HeaderIo::parseRecord<long>(m_fptr, "ZNAXIS2");
+  }
+  return m_columns.readRowCount(); // Excludes reserved rows
 }
 
 HduCategory BintableHdu::readCategory() const {
@@ -63,9 +120,24 @@ HduCategory BintableHdu::readCategory() const {
   } else {
     cat &= HduCategory::Data;
   }
+  cat &= m_compressed ? HduCategory::CompressedBintable : HduCategory::RawBintable;
   return cat;
 }
 
+void BintableHdu::touchBuffer() const {
+  touchThisHdu();
+  if (not m_buffer) {
+    m_buffer = Cfitsio::BintableIo::uncompress(m_fptr);
+  }
+}
+
+void BintableHdu::editBuffer() const {
+  Cfitsio::mayThrowReadonlyError(m_fptr);
+  editThisHdu();
+  touchBuffer();
+  m_bufferEdited = true;
+}
+
 #ifndef COMPILE_READ_COLUMN
   #define COMPILE_READ_COLUMN(type, unused) template VecColumn<type> BintableHdu::readColumn(const std::string&) const;
 ELEFITS_FOREACH_COLUMN_TYPE(COMPILE_READ_COLUMN)
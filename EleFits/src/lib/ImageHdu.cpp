@@ -70,7 +70,7 @@ HduCategory ImageHdu::readCategory() const {
   } else {
     cat &= HduCategory::IntImage;
   }
-  cat &= HduCategory::RawImage; // TODO check compression when implemented
+  cat &= Cfitsio::ImageIo::isCompressed(m_fptr) ? HduCategory::CompressedImageExt : HduCategory::RawImage;
   return cat;
 }
 
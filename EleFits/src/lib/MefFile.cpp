@@ -20,6 +20,7 @@
 #include "EleFits/MefFile.h"
 
 #include "EleCfitsioWrapper/HduWrapper.h"
+#include "ElementsKernel/Logging.h"
 
 namespace Euclid {
 namespace Fits {
@@ -28,10 +29,36 @@ MefFile::MefFile(const std::string& filename, FileMode permission) :
     FitsFile(filename, permission), m_hdus(std::max(1L, Cfitsio::HduAccess::count(m_fptr))) {
 } // 1 for create, count() for open
 
+MefFile::~MefFile() {
+  try {
+    close(); // Before FitsFile::~FitsFile(), which cannot call the override
+  } catch (const std::exception& e) { // Destructors must not throw; the file is closed by FitsFile::~FitsFile()
+    Elements::Logging::getLogger("EleFits").error() << "Cannot finalize file " << m_filename << ": " << e.what();
+  }
+}
+
 long MefFile::hduCount() const {
   return m_hdus.size();
 }
 
+void MefFile::close() {
+  if (m_open && m_permission != FileMode::Read && m_permission != FileMode::Temporary) {
+    for (const auto& hdu : m_hdus) {
+      if (hdu && hdu->type() == HduCategory::Bintable) {
+        const auto& ext = hdu->as<BintableHdu>();
+        ext.columns().shrinkToFit(); // No-op if no rows were reserved
+        ext.flush(); // No-op if not compressed or not edited
+      }
+    }
+  }
+  FitsFile::close();
+  for (const auto& hdu : m_hdus) {
+    if (hdu && hdu->type() == HduCategory::Bintable) {
+      hdu->as<BintableHdu>().columns().invalidateSchema(); // The file pointer will change at reopening
+    }
+  }
+}
+
 std::vector<std::string> MefFile::readHduNames() {
   const long count = hduCount();
   std::vector<std::string> names(count);
@@ -44,15 +44,25 @@ using namespace Euclid::Fits;
 // 			readSegmentSeqTo (rows, columns...) => TEST
 // 	readSegmentSeqTo (rows, indices, columns...) => TEST
 //
-// writeSegmentSeq (long firstRow, TSeq &&columns) -> loop on writeSegment (row, column)
+// writeSegmentSeq (long firstRow, TSeq &&columns) -> raw row blocks, and loop on writeSegment (row, column) for others
 //   writeSeq (TSeq &&columns)
 //     writeSeq (const Column< Ts > &... columns) => TEST
 //   writeSegmentSeq (long firstRow, Column< Ts > &... columns) => TEST
 //
+// writeRows (rows, maxGap, column) -> read holes with readSegmentTo, and write runs with writeSegment
+//   writeRows (rows, column) => TEST
+//
 // initSeq (TSeq &&infos, long index)
 //   initSeq (const ColumnInfo< Ts > &... infos, long index) => TEST
 //
-// removeSeq (const std::vector< long > &indices)
+// readWhere (predicateIndex, predicate, indices...) -> readWhereSegments, then readSegmentsRawTo or readRows
+//   readWhere (predicateName, predicate, names...) => TEST
+//
+// readRows (rows, maxGap, indices...) -> readSegmentsRawTo, by batches of coalesced ranges
+//   readRows (rows, maxGap, names...) => TEST
+//     readRows (rows, names...) => TEST
+//
+// removeSeq (const std::vector< long > &indices) -> single pass on the data unit
 //   removeSeq (const std::vector< std::string > &names) => TEST
 
 //-----------------------------------------------------------------------------
@@ -78,6 +88,392 @@ BOOST_FIXTURE_TEST_CASE(append_rows_test, Test::TemporaryMefFile) {
   BOOST_TEST(columns.readRowCount() == initSize * 2);
 }
 
+BOOST_FIXTURE_TEST_CASE(schema_update_test, Test::TemporaryMefFile) {
+  const Test::SmallTable table;
+  const auto& ext = assignBintableExt("TABLE", table.nameCol, table.radecCol);
+  const auto& columns = ext.columns();
+  const auto& name = table.nameCol.info().name;
+  const auto& radec = table.radecCol.info().name;
+  BOOST_TEST(columns.readColumnCount() == 2);
+  BOOST_TEST(columns.readIndex(radec) == 1);
+  columns.rename(name, "RENAMED");
+  BOOST_TEST(columns.readName(0) == "RENAMED");
+  BOOST_TEST(not columns.has(name));
+  columns.init(table.numCol.info(), 1);
+  BOOST_TEST(columns.readColumnCount() == 3);
+  BOOST_TEST(columns.readIndex(radec) == 2);
+  const auto info = columns.readInfo<Test::SmallTable::Num>(1);
+  BOOST_TEST(info.name == table.numCol.info().name);
+  BOOST_TEST(info.unit == table.numCol.info().unit);
+  BOOST_TEST(info.repeatCount == table.numCol.info().repeatCount);
+  columns.remove("RENAMED");
+  BOOST_TEST(columns.readColumnCount() == 2);
+  BOOST_TEST(columns.readIndex(radec) == 1);
+  BOOST_TEST(columns.readAllNames() == std::vector<std::string>({ table.numCol.info().name, radec }));
+}
+
+BOOST_FIXTURE_TEST_CASE(schema_is_read_again_after_reopening_test, Test::NewMefFile) {
+  const Test::SmallTable table;
+  const auto& columns = assignBintableExt("TABLE", table.nameCol, table.radecCol).columns();
+  BOOST_TEST(columns.readColumnCount() == 2); // Cached
+  close();
+  {
+    MefFile other(filename(), FileMode::Edit);
+    other.access<BintableHdu>("TABLE").columns().remove(table.nameCol.info().name);
+  }
+  open(filename(), FileMode::Read);
+  BOOST_TEST(columns.readColumnCount() == 1);
+  BOOST_TEST(columns.readName(0) == table.radecCol.info().name);
+  close();
+  remove(filename().c_str());
+}
+
+BOOST_FIXTURE_TEST_CASE(read_raw_segment_seq_test, Test::TemporaryMefFile) {
+  const Test::RandomTable table(3, 100);
+  const auto& chars = table.getColumn<char>();
+  const auto& shorts = table.getColumn<std::int16_t>();
+  const auto& doubles = table.getColumn<double>();
+  const auto& complexes = table.getColumn<std::complex<float>>();
+  const auto& uints = table.getColumn<std::uint32_t>();
+  const auto& ulongs = table.getColumn<std::uint64_t>();
+  const auto& columns = assignBintableExt("TABLE", chars, shorts, doubles, complexes, uints, ulongs).columns();
+  const Segment rows { 10, 89 };
+  auto output = std::make_tuple(
+      VecColumn<char>(chars.info(), rows.size()),
+      VecColumn<std::int16_t>(shorts.info(), rows.size()),
+      VecColumn<double>(doubles.info(), rows.size()),
+      VecColumn<std::complex<float>>(complexes.info(), rows.size()),
+      VecColumn<std::uint32_t>(uints.info(), rows.size()),
+      VecColumn<std::uint64_t>(ulongs.info(), rows.size()));
+  columns.readSegmentSeqRawTo(rows, output);
+  seqForeach(output, [&](const auto& c) {
+    const auto& input = table.getColumn<typename std::decay_t<decltype(c)>::Value>();
+    for (long i = 0; i < c.elementCount(); ++i) {
+      BOOST_TEST(c.vector()[i] == input.vector()[rows.front * c.info().repeatCount + i]);
+    }
+  });
+}
+
+BOOST_FIXTURE_TEST_CASE(write_raw_segment_seq_test, Test::TemporaryMefFile) {
+  const Test::RandomTable table(3, 100);
+  const auto& strings = table.getColumn<std::string>();
+  const auto& shorts = table.getColumn<std::int16_t>();
+  const auto& complexes = table.getColumn<std::complex<float>>();
+  const auto& uints = table.getColumn<std::uint32_t>();
+  const auto& columns = initBintableExt("TABLE", strings.info(), shorts.info(), complexes.info(), uints.info()).columns();
+  columns.writeSeq(strings, shorts, uints); // Partial coverage
+  BOOST_TEST(columns.readRowCount() == 100);
+  columns.writeSegmentSeq(0, std::forward_as_tuple(complexes)); // Other fields should be preserved
+  BOOST_TEST(columns.readRowCount() == 100);
+  const auto output = columns.readSeq(
+      Named<std::string>(strings.info().name),
+      Named<std::int16_t>(shorts.info().name),
+      Named<std::complex<float>>(complexes.info().name),
+      Named<std::uint32_t>(uints.info().name));
+  BOOST_TEST(std::get<0>(output).vector() == strings.vector());
+  BOOST_TEST(std::get<1>(output).vector() == shorts.vector());
+  BOOST_TEST(std::get<2>(output).vector() == complexes.vector());
+  BOOST_TEST(std::get<3>(output).vector() == uints.vector());
+}
+
+BOOST_FIXTURE_TEST_CASE(read_where_test, Test::TemporaryMefFile) {
+  const Test::RandomTable table(3, 100);
+  const auto& shorts = table.getColumn<std::int16_t>();
+  const auto& strings = table.getColumn<std::string>();
+  const auto& doubles = table.getColumn<double>();
+  const auto& columns = assignBintableExt("TABLE", shorts, strings, doubles).columns();
+  const auto predicate = [](std::int16_t v) {
+    return v % 2 == 0;
+  };
+  std::vector<std::string> expectedStrings;
+  std::vector<double> expectedDoubles;
+  for (long i = 0; i < shorts.rowCount(); ++i) {
+    if (predicate(shorts(i))) {
+      expectedStrings.push_back(strings(i));
+      for (long j = 0; j < doubles.info().repeatCount; ++j) {
+        expectedDoubles.push_back(doubles(i, j));
+      }
+    }
+  }
+  const auto segments = columns.readWhereSegments(Indexed<std::int16_t>(0), predicate);
+  for (std::size_t i = 1; i < segments.size(); ++i) {
+    BOOST_TEST(segments[i].front > segments[i - 1].back + 1);
+  }
+  const auto output = columns.readWhere(
+      Named<std::int16_t>(shorts.info().name),
+      predicate,
+      Named<std::string>(strings.info().name),
+      Named<double>(doubles.info().name));
+  BOOST_TEST(std::get<0>(output).vector() == expectedStrings);
+  BOOST_TEST(std::get<1>(output).vector() == expectedDoubles);
+}
+
+BOOST_FIXTURE_TEST_CASE(read_rows_test, Test::TemporaryMefFile) {
+  const Test::RandomTable table(3, 100);
+  const auto& shorts = table.getColumn<std::int16_t>();
+  const auto& strings = table.getColumn<std::string>();
+  const auto& doubles = table.getColumn<double>();
+  const auto& columns = assignBintableExt("TABLE", shorts, strings, doubles).columns();
+  const std::vector<long> rows { 42, 3, 99, 4, 42, 0, 50, 7, 98, 5 }; // Unsorted, with duplicates and holes
+  for (long maxGap : { 0L, 2L, 100L }) {
+    const auto output =
+        columns.readRows(rows, maxGap, Named<std::string>(strings.info().name), Named<double>(doubles.info().name));
+    const auto& outputStrings = std::get<0>(output);
+    const auto& outputDoubles = std::get<1>(output);
+    BOOST_TEST(outputStrings.rowCount() == static_cast<long>(rows.size()));
+    BOOST_TEST(outputDoubles.rowCount() == static_cast<long>(rows.size()));
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+      BOOST_TEST(outputStrings(i) == strings(rows[i]));
+      for (long j = 0; j < doubles.info().repeatCount; ++j) {
+        BOOST_TEST(outputDoubles(i, j) == doubles(rows[i], j));
+      }
+    }
+  }
+  BOOST_CHECK_THROW(columns.readRows({ 100 }, Named<std::int16_t>(shorts.info().name)), FitsError);
+}
+
+BOOST_FIXTURE_TEST_CASE(write_rows_test, Test::TemporaryMefFile) {
+  const Test::RandomTable table(3, 100);
+  const auto& shorts = table.getColumn<std::int16_t>();
+  const auto& doubles = table.getColumn<double>();
+  const auto& columns = assignBintableExt("TABLE", shorts, doubles).columns();
+  const std::vector<long> rows { 42, 3, 99, 4, 42, 0, 50, 7, 98, 5 }; // Unsorted, with duplicates and holes
+  for (long maxGap : { 0L, 2L, 100L }) {
+    auto expected = doubles.vector();
+    VecColumn<double> values(doubles.info(), rows.size());
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+      for (long j = 0; j < doubles.info().repeatCount; ++j) {
+        values(i, j) = maxGap + i + j * 0.5;
+        expected[rows[i] * doubles.info().repeatCount + j] = values(i, j); // Last duplicate wins
+      }
+    }
+    columns.writeRows(rows, maxGap, values);
+    BOOST_TEST(columns.readRowCount() == 100);
+    BOOST_TEST(columns.read<double>(doubles.info().name).vector() == expected);
+    BOOST_TEST(columns.read<std::int16_t>(shorts.info().name).vector() == shorts.vector());
+  }
+  VecColumn<double> tooFar(doubles.info(), 1);
+  BOOST_CHECK_THROW(columns.writeRows({ 100 }, tooFar), FitsError);
+}
+
+BOOST_FIXTURE_TEST_CASE(fixed_string_column_test, Test::TemporaryMefFile) {
+  const Test::RandomTable table(3, 100);
+  const auto& strings = table.getColumn<std::string>();
+  const auto& shorts = table.getColumn<std::int16_t>();
+  const FixedStringColumn fixed(strings.info(), strings.vector());
+  const auto& columns = initBintableExt("TABLE", fixed.info(), shorts.info()).columns();
+  columns.writeSeq(std::forward_as_tuple(fixed, shorts)); // Mixed sequence
+  BOOST_TEST(columns.readRowCount() == 100);
+  BOOST_TEST(columns.read<std::string>(strings.info().name).vector() == strings.vector());
+  const auto whole = columns.readFixedString(strings.info().name);
+  BOOST_TEST(whole.strings() == strings.vector());
+  const Segment rows { 10, 89 };
+  auto output = std::make_tuple(
+      FixedStringColumn(strings.info(), rows.size()),
+      VecColumn<std::int16_t>(shorts.info(), rows.size()));
+  columns.readSegmentSeqRawTo(rows, output); // Strings by CFitsIO, others raw
+  for (long i = 0; i < rows.size(); ++i) {
+    BOOST_TEST(std::get<0>(output)(i) == strings(rows.front + i));
+    BOOST_TEST(std::get<1>(output)(i) == shorts(rows.front + i));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(bit_column_test, Test::TemporaryMefFile) {
+  const long rowCount = 50;
+  const Test::RandomTable table(1, rowCount);
+  const auto& shorts = table.getColumn<std::int16_t>();
+  BitColumn flags({ "FLAGS", "", 11 }, rowCount);
+  BitColumn logicals({ "LOGICALS", "", 2 }, rowCount);
+  for (long row = 0; row < rowCount; ++row) {
+    flags.assign(row, row % 11, true);
+    logicals.assign(row, row % 2, row % 3 == 0);
+  }
+  const auto& columns = assignBintableExt("TABLE", shorts).columns();
+  columns.init(flags.info());
+  columns.initLogical(logicals.info(), 0);
+  columns.write(flags);
+  columns.write(logicals);
+  BOOST_TEST(columns.readRowCount() == rowCount);
+  BOOST_TEST(columns.read<std::int16_t>(shorts.info().name).vector() == shorts.vector()); // Preserved
+  BOOST_TEST(columns.readBits("FLAGS").values() == flags.values());
+  BOOST_TEST(columns.readBits(0).values() == logicals.values());
+  BitColumn segment({ "FLAGS", "", 11 }, 10);
+  segment.flip();
+  columns.writeSegment({ Segment { 45, 54 }, 0 }, segment); // Overwrite and append
+  BOOST_TEST(columns.readRowCount() == 55);
+  BitColumn output({ "FLAGS", "", 11 }, 20);
+  columns.readSegmentTo({ Segment { 40, 54 }, 5 }, 2, output);
+  for (long row = 5; row < 10; ++row) {
+    BOOST_TEST(output(row, (row + 35) % 11));
+  }
+  BOOST_TEST(output.count() == 5 + 10 * 11);
+  BOOST_CHECK_THROW(columns.readBits(1), FitsError);
+}
+
+BOOST_FIXTURE_TEST_CASE(vla_column_test, Test::TemporaryMefFile) {
+  const std::vector<std::vector<float>> spectra { { 1, 2, 3 }, {}, { 4 }, { 5, 6, 7, 8 }, { 9, 10 }, { 11 } };
+  const VlaColumn<float> column({ "SPEC", "Jy", 1 }, spectra);
+  const auto& columns = initBintableExt("TABLE", ColumnInfo<std::int16_t> { "ID", "", 1 }).columns();
+  columns.initVla(column.info());
+  columns.write(column);
+  BOOST_TEST(columns.readRowCount() == column.rowCount());
+  const auto whole = columns.readVla<float>("SPEC");
+  BOOST_TEST(whole.info().unit == "Jy");
+  BOOST_TEST(whole.entries() == spectra);
+  const auto segment = columns.readVlaSegment<float>({ 2, 4 }, 1);
+  BOOST_TEST(segment.rowCount() == 3);
+  BOOST_TEST(segment.entries() == std::vector<std::vector<float>>(spectra.begin() + 2, spectra.begin() + 5));
+  BOOST_CHECK_THROW(columns.readVlaSegment<float>({ -1, 2 }, 1), OutOfBoundsError);
+  BOOST_CHECK_THROW(columns.readVlaSegment<float>({ 4, 6 }, 1), OutOfBoundsError);
+  const VlaColumn<float> update({ "SPEC", "Jy", 1 }, { { 12, 13 }, { 14, 15, 16, 17, 18 } });
+  columns.writeSegment({ Segment { 1, 2 }, 0 }, update); // Heap is no more in row order
+  auto expected = spectra;
+  expected[1] = update.entries()[0];
+  expected[2] = update.entries()[1];
+  BOOST_TEST(columns.readVla<float>(1).entries() == expected);
+  const auto integers = columns.readVla<std::int64_t>(1); // Converted by CFitsIO
+  BOOST_TEST(integers(2, 4) == 18);
+}
+
+BOOST_FIXTURE_TEST_CASE(nullable_column_test, Test::TemporaryMefFile) {
+  const auto& columns = initBintableExt("TABLE", ColumnInfo<std::int16_t> { "ID", "", 1 }).columns();
+  NullableColumn<std::uint16_t> counts({ "COUNT", "", 2 }, 10);
+  NullableColumn<float> fluxes({ "FLUX", "Jy", 1 }, 10);
+  for (long i = 0; i < 10; i += 3) {
+    counts.assign(i, 1, static_cast<std::uint16_t>(60000 + i));
+    fluxes.assign(i, 0, i * .5F);
+  }
+  columns.initNullable(counts.info(), std::uint16_t(65535));
+  columns.init(fluxes.info());
+  columns.write(counts);
+  columns.write(fluxes);
+  const auto countsOut = columns.readNullable<std::uint16_t>("COUNT");
+  BOOST_TEST(countsOut.nullCount() == counts.nullCount());
+  const auto fluxesOut = columns.readNullable<float>(2);
+  BOOST_TEST(fluxesOut.info().unit == "Jy");
+  BOOST_TEST(fluxesOut.nullCount() == fluxes.nullCount());
+  for (long i = 0; i < 10; ++i) {
+    BOOST_TEST(countsOut.isValid(i, 0) == false);
+    BOOST_TEST(countsOut.isValid(i, 1) == (i % 3 == 0));
+    BOOST_TEST(fluxesOut.isValid(i) == (i % 3 == 0));
+    if (i % 3 == 0) {
+      BOOST_TEST(countsOut(i, 1) == 60000 + i);
+      BOOST_TEST(fluxesOut(i) == i * .5F);
+    }
+  }
+  const NullableColumn<std::int16_t> ids({ "ID", "", 1 }, 10);
+  BOOST_CHECK_THROW(columns.write(ids), FitsError); // No TNULL
+}
+
+BOOST_FIXTURE_TEST_CASE(read_elements_test, Test::TemporaryMefFile) {
+  const long rowCount = 5;
+  VecColumn<std::int32_t> narrow({ "NARROW", "", 10 }, rowCount);
+  VecColumn<float> wide({ "WIDE", "", 2000 }, rowCount);
+  for (long i = 0; i < rowCount; ++i) {
+    for (long j = 0; j < narrow.info().repeatCount; ++j) {
+      narrow(i, j) = i * 100 + j;
+    }
+    for (long j = 0; j < wide.info().repeatCount; ++j) {
+      wide(i, j) = i + j * .5F;
+    }
+  }
+  const auto& columns = initBintableExt("TABLE", narrow.info(), wide.info()).columns();
+  columns.writeSeq(narrow, wide);
+  const std::vector<long> elements { 7, 1, 2, 3, 7 };
+  const auto narrowOut = columns.readElements<std::int32_t>("NARROW", elements); // Raw row blocks
+  const auto wideOut = columns.readElements<float>(1, elements); // Raw row blocks
+  const auto segmentOut = columns.readSegmentElements<float>({ 1, 3 }, 1, { 1999 }); // Element-wise reads
+  const auto lastOut = columns.readElements<float>("WIDE", { 1999 }); // Element-wise reads
+  BOOST_TEST(narrowOut.info().repeatCount == 5);
+  BOOST_TEST(narrowOut.rowCount() == rowCount);
+  BOOST_TEST(wideOut.rowCount() == rowCount);
+  BOOST_TEST(segmentOut.rowCount() == 3);
+  BOOST_TEST(lastOut.rowCount() == rowCount);
+  for (long i = 0; i < rowCount; ++i) {
+    for (std::size_t j = 0; j < elements.size(); ++j) {
+      BOOST_TEST(narrowOut(i, j) == narrow(i, elements[j]));
+      BOOST_TEST(wideOut(i, j) == wide(i, elements[j]));
+    }
+    BOOST_TEST(lastOut(i) == wide(i, 1999));
+  }
+  for (long i = 0; i < 3; ++i) {
+    BOOST_TEST(segmentOut(i) == wide(i + 1, 1999));
+  }
+  BOOST_CHECK_THROW(columns.readElements<float>(1, { 2000 }), OutOfBoundsError);
+  BOOST_CHECK_THROW(columns.readElements<float>(1, {}), FitsError);
+  BOOST_CHECK_THROW(columns.readSegmentElements<float>({ -1, 2 }, 1, { 0 }), OutOfBoundsError);
+  BOOST_CHECK_THROW(columns.readSegmentElements<float>({ 2, rowCount }, 1, { 0 }), OutOfBoundsError);
+}
+
+BOOST_FIXTURE_TEST_CASE(multidimensional_column_test, Test::TemporaryMefFile) {
+  VecColumn<float> cutouts({ "CUTOUT", "", 12, { 4, 3 } }, 2);
+  VecColumn<std::int16_t> flags({ "FLAGS", "", 6, { 3, 2 } }, 2);
+  std::iota(cutouts.data(), cutouts.data() + cutouts.elementCount(), 0.F);
+  const auto& columns = initBintableExt("TABLE", cutouts.info()).columns();
+  columns.write(cutouts);
+  columns.init(flags.info());
+  BOOST_TEST((columns.readInfo<std::int16_t>("FLAGS").shape == Position<-1> { 3, 2 }));
+  const auto output = columns.read<float>("CUTOUT");
+  BOOST_TEST((output.info().shape == cutouts.info().shape));
+  for (long row = 0; row < 2; ++row) {
+    const auto entry = output.entry<2>(row);
+    BOOST_TEST(entry.data() == &output(row));
+    BOOST_TEST((entry[{ 3, 2 }] == cutouts(row, 11)));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(reserve_and_append_test, Test::TemporaryMefFile) {
+  const Test::RandomTable table(1, 10);
+  const auto& ints = table.getColumn<std::int32_t>();
+  const auto& columns = initBintableExt("TABLE", ints.info()).columns();
+  columns.reserve(4);
+  BOOST_TEST(columns.readRowCount() == 0);
+  BOOST_TEST(columns.readCapacity() == 4);
+  for (long front = 0; front < 10; front += 3) {
+    columns.writeSegment({ -1, Segment { front, std::min(front + 2, 9L) } }, ints);
+  }
+  BOOST_TEST(columns.readRowCount() == 10);
+  BOOST_TEST(columns.readCapacity() == 16); // 4, 8, 16
+  columns.insertRows(-1, 2); // Within capacity
+  BOOST_TEST(columns.readRowCount() == 12);
+  BOOST_TEST(columns.readCapacity() == 16);
+  columns.shrinkToFit();
+  BOOST_TEST(columns.readCapacity() == 12);
+  const auto output = columns.read<std::int32_t>(0);
+  BOOST_TEST(output.rowCount() == 12);
+  for (long i = 0; i < 10; ++i) {
+    BOOST_TEST(output(i) == ints(i));
+  }
+  BOOST_TEST(output(11) == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(batch_init_and_remove_test, Test::TemporaryMefFile) {
+  const Test::RandomTable table(2, 30);
+  const auto& chars = table.getColumn<char>();
+  const auto& shorts = table.getColumn<std::int16_t>();
+  const auto& doubles = table.getColumn<double>();
+  const auto& uints = table.getColumn<std::uint32_t>();
+  const std::vector<std::vector<float>> spectra(30, { 1, 2, 3 });
+  const VlaColumn<float> vla({ "SPEC", "Jy", 1 }, spectra);
+  const auto& columns = assignBintableExt("TABLE", chars, doubles).columns();
+  columns.initSeq(std::make_tuple(shorts.info(), uints.info()), 1);
+  BOOST_TEST(columns.readAllNames() ==
+      std::vector<std::string>({ chars.info().name, shorts.info().name, uints.info().name, doubles.info().name }));
+  BOOST_TEST(columns.readInfo<std::uint32_t>(2).unit == uints.info().unit);
+  columns.writeSeq(shorts, uints);
+  columns.initVla(vla.info());
+  columns.write(vla);
+  columns.removeSeq(std::vector<long> { 2, 0 }); // Non-contiguous, unordered
+  BOOST_TEST(columns.readAllNames() == std::vector<std::string>({ shorts.info().name, doubles.info().name, "SPEC" }));
+  BOOST_TEST(columns.read<std::int16_t>(0).vector() == shorts.vector());
+  BOOST_TEST(columns.read<double>(1).vector() == doubles.vector());
+  BOOST_TEST(columns.readVla<float>(2).entries() == spectra); // Heap was shifted
+  BOOST_TEST(columns.readInfo<double>(1).unit == doubles.info().unit); // Keywords were renumbered
+  columns.removeSeq({ shorts.info().name, "SPEC" });
+  BOOST_TEST(columns.readColumnCount() == 1);
+  BOOST_TEST(columns.read<double>(doubles.info().name).vector() == doubles.vector());
+}
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE_END()
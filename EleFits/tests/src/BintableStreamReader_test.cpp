@@ -0,0 +1,134 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsData/TestColumn.h"
+#include "EleFits/BintableStreamReader.h"
+#include "EleFits/FitsFileFixture.h"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(BintableStreamReader_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(stream_batches_test, Test::TemporaryMefFile) {
+  const Test::RandomTable table(3, 1000);
+  const auto& shorts = table.getColumn<std::int16_t>();
+  const auto& strings = table.getColumn<std::string>();
+  const auto& doubles = table.getColumn<double>();
+  const auto& columns = assignBintableExt("TABLE", shorts, strings, doubles).columns();
+  auto range = columns.stream(
+      1,
+      Named<std::int16_t>(shorts.info().name),
+      Named<std::string>(strings.info().name),
+      Named<double>(doubles.info().name));
+  const auto bufferRowCount = columns.readBufferRowCount();
+  BOOST_TEST(range.batchRowCount() == bufferRowCount);
+  BOOST_TEST(range.rowCount() == 1000);
+  long front = 0;
+  for (const auto& batch : range) {
+    const auto& s = std::get<0>(batch);
+    const auto& t = std::get<1>(batch);
+    const auto& d = std::get<2>(batch);
+    const long size = std::min(bufferRowCount, 1000 - front);
+    BOOST_TEST(s.rowCount() == size);
+    BOOST_TEST(t.rowCount() == size);
+    BOOST_TEST(d.rowCount() == size);
+    for (long i = 0; i < s.elementCount(); ++i) {
+      BOOST_TEST(s.data()[i] == shorts.vector()[front * shorts.info().repeatCount + i]);
+    }
+    for (long i = 0; i < size; ++i) {
+      BOOST_TEST(t.data()[i] == strings.vector()[front + i]);
+    }
+    for (long i = 0; i < d.elementCount(); ++i) {
+      BOOST_TEST(d.data()[i] == doubles.vector()[front * doubles.info().repeatCount + i]);
+    }
+    front += size;
+  }
+  BOOST_TEST(front == 1000);
+}
+
+BOOST_FIXTURE_TEST_CASE(prefetch_test, Test::TemporaryMefFile) {
+  const Test::RandomTable table(3, 1000);
+  const auto& shorts = table.getColumn<std::int16_t>();
+  const auto& uints = table.getColumn<std::uint32_t>();
+  const auto& strings = table.getColumn<std::string>();
+  const auto& columns = assignBintableExt("TABLE", shorts, uints, strings).columns();
+  auto range = columns.stream(1, Named<std::int16_t>(shorts.info().name), Named<std::uint32_t>(uints.info().name));
+  BOOST_TEST(range.prefetch(3));
+  long front = 0;
+  long batchCount = 0;
+  for (const auto& batch : range) {
+    const auto& s = std::get<0>(batch);
+    const auto& u = std::get<1>(batch);
+    for (long i = 0; i < s.elementCount(); ++i) {
+      BOOST_TEST(s.data()[i] == shorts.vector()[front * shorts.info().repeatCount + i]);
+    }
+    for (long i = 0; i < u.elementCount(); ++i) {
+      BOOST_TEST(u.data()[i] == uints.vector()[front * uints.info().repeatCount + i]);
+    }
+    front += s.rowCount();
+    ++batchCount;
+  }
+  BOOST_TEST(front == 1000);
+  BOOST_TEST(range.metrics().batchCount == batchCount);
+  auto stringRange = columns.stream(Named<std::string>(strings.info().name));
+  BOOST_TEST(not stringRange.prefetch());
+}
+
+BOOST_AUTO_TEST_CASE(prefetch_gzipped_file_test) {
+  const Test::RandomTable table(3, 100);
+  const auto& shorts = table.getColumn<std::int16_t>();
+  const auto filename = Test::temporaryFilename() + ".gz"; // Compressed by CFitsIO at closing
+  {
+    MefFile f(filename, FileMode::Create);
+    f.assignBintableExt("TABLE", shorts);
+  }
+  {
+    MefFile f(filename, FileMode::Read); // Decompressed by CFitsIO in memory
+    const auto& columns = f.access<BintableHdu>("TABLE").columns();
+    auto range = columns.stream(7, Named<std::int16_t>(shorts.info().name));
+    BOOST_TEST(not range.prefetch());
+    std::vector<std::int16_t> values;
+    for (const auto& batch : range) {
+      const auto& s = std::get<0>(batch);
+      values.insert(values.end(), s.data(), s.data() + s.elementCount());
+    }
+    BOOST_TEST(values == shorts.vector());
+  }
+  remove(filename.c_str());
+}
+
+BOOST_FIXTURE_TEST_CASE(stream_empty_table_test, Test::TemporaryMefFile) {
+  const auto& columns = initBintableExt("TABLE", ColumnInfo<float> { "FLOAT" }).columns();
+  long count = 0;
+  for (const auto& batch : columns.stream(Named<float>("FLOAT"))) {
+    BOOST_TEST(std::get<0>(batch).rowCount() >= 0);
+    ++count;
+  }
+  BOOST_TEST(count == 0);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,91 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/BintableStreamWriter.h"
+#include "EleFits/FitsFileFixture.h"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(BintableStreamWriter_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(append_rows_test, Test::TemporaryMefFile) {
+  const ColumnInfo<int> intInfo { "INT" };
+  const ColumnInfo<std::string> stringInfo { "STRING", "", 8 };
+  const long rowCount = 1000;
+  {
+    auto writer = initBintableStream("TABLE", intInfo, stringInfo);
+    BOOST_TEST(writer.batchRowCount() > 0);
+    for (long i = 0; i < rowCount; ++i) {
+      writer.appendRow(i, std::to_string(i));
+      BOOST_TEST(writer.rowCount() == i + 1);
+    }
+  } // Closed
+  const auto& columns = access<BintableHdu>(1).columns();
+  BOOST_TEST(columns.readRowCount() == rowCount);
+  const auto ints = columns.read<int>(intInfo.name);
+  const auto strings = columns.read<std::string>(stringInfo.name);
+  for (long i = 0; i < rowCount; ++i) {
+    BOOST_TEST(ints.vector()[i] == i);
+    BOOST_TEST(strings.vector()[i] == std::to_string(i));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(append_batches_test, Test::TemporaryMefFile) {
+  const ColumnInfo<float> vectorInfo { "VECTOR", "", 3 };
+  auto writer = initBintableStream("TABLE", vectorInfo);
+  BOOST_CHECK_THROW(writer.appendRow(1.F), FitsError);
+  const long smallCount = 2;
+  const long largeCount = writer.batchRowCount() * 2 + 1;
+  VecColumn<float> small(vectorInfo, smallCount);
+  VecColumn<float> large(vectorInfo, largeCount);
+  for (long i = 0; i < small.elementCount(); ++i) {
+    small.data()[i] = i;
+  }
+  for (long i = 0; i < large.elementCount(); ++i) {
+    large.data()[i] = -i;
+  }
+  writer.appendBatch(small);
+  writer.appendBatch(large);
+  writer.appendBatch(small);
+  BOOST_TEST(writer.rowCount() == smallCount * 2 + largeCount);
+  writer.close();
+  BOOST_CHECK_THROW(writer.appendBatch(small), FitsError);
+  const auto& columns = access<BintableHdu>(1).columns();
+  BOOST_TEST(columns.readRowCount() == smallCount * 2 + largeCount);
+  const auto output = columns.read<float>(vectorInfo.name);
+  const long largeOffset = small.elementCount();
+  const long secondSmallOffset = largeOffset + large.elementCount();
+  for (long i = 0; i < small.elementCount(); ++i) {
+    BOOST_TEST(output.vector()[i] == small.vector()[i]);
+    BOOST_TEST(output.vector()[secondSmallOffset + i] == small.vector()[i]);
+  }
+  for (long i = 0; i < large.elementCount(); ++i) {
+    BOOST_TEST(output.vector()[largeOffset + i] == large.vector()[i]);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -22,6 +22,8 @@
 #include "EleFits/ImageRaster.h"
 
 #include <boost/test/unit_test.hpp>
+#include <algorithm> // fill
+#include <limits>
 
 using namespace Euclid::Fits;
 
@@ -182,6 +184,111 @@ BOOST_FIXTURE_TEST_CASE(const_data_raster_is_read_back_test, Test::TemporarySifF
   BOOST_TEST(vec == cData);
 }
 
+BOOST_FIXTURE_TEST_CASE(prefetch_regions_test, Test::TemporarySifFile) {
+  VecRaster<std::uint16_t, 3> input({ 5, 6, 7 });
+  for (auto p : input.domain()) {
+    input[p] = 100 * p[2] + 10 * p[1] + p[0];
+  }
+  const auto& du = raster();
+  du.reinit<std::uint16_t>(input.shape());
+  du.write(input);
+  const std::vector<Region<3>> regions { { { 1, 2, 3 }, { 3, 4, 5 } }, { { 0, 0, 0 }, { 4, 5, 0 } } };
+  auto prefetcher = du.prefetchRegions<std::uint16_t, 3>(regions, 2);
+  auto converter = du.prefetchRegions<double, 3>(regions, 2); // Synchronous
+  BOOST_TEST(prefetcher.queueDepth() == 2);
+  BOOST_TEST(converter.queueDepth() == 0);
+  for (const auto& region : regions) {
+    const auto& output = prefetcher.next();
+    const auto& converted = converter.next();
+    BOOST_TEST(output.shape() == region.shape());
+    for (auto p : output.domain()) {
+      BOOST_TEST(output[p] == input[p + region.front]);
+      BOOST_TEST(converted[p] == input[p + region.front]);
+    }
+  }
+  BOOST_TEST(prefetcher.metrics().batchCount == 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(read_regions_test, Test::TemporarySifFile) {
+  VecRaster<std::int32_t, 2> input({ 40, 30 });
+  for (auto p : input.domain()) {
+    input[p] = 100 * p[1] + p[0];
+  }
+  const auto& du = raster();
+  du.reinit<std::int32_t>(input.shape());
+  du.write(input);
+  const std::vector<Region<2>> regions {
+      Region<2>::fromShape({ 20, 20 }, { 8, 8 }),
+      Region<2>::fromShape({ 0, 0 }, { 4, 4 }),
+      Region<2>::fromShape({ 22, 18 }, { 8, 8 }), // Overlaps the first one
+      Region<2>::fromShape({ 0, 29 }, { 40, 1 }) };
+  const auto outputs = du.readRegions<std::int32_t, 2>(regions);
+  BOOST_TEST(outputs.size() == regions.size());
+  for (std::size_t i = 0; i < regions.size(); ++i) {
+    BOOST_TEST(outputs[i].shape() == regions[i].shape());
+    for (auto p : outputs[i].domain()) {
+      BOOST_TEST(outputs[i][p] == input[p + regions[i].front]);
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(read_decimated_and_binned_region_test, Test::TemporarySifFile) {
+  VecRaster<std::int32_t, 2> input({ 40, 30 });
+  for (auto p : input.domain()) {
+    input[p] = 100 * p[1] + p[0];
+  }
+  const auto& du = raster();
+  du.reinit<std::int32_t>(input.shape());
+  du.write(input);
+  const auto region = Region<2>::fromShape({ 1, 2 }, { 38, 27 });
+
+  const auto decimated = du.readRegion<std::int32_t, 2>(region, { 4, 3 });
+  BOOST_TEST((decimated.shape() == Position<2> { 10, 9 }));
+  for (auto p : decimated.domain()) {
+    BOOST_TEST((decimated[p] == input[{ region.front[0] + 4 * p[0], region.front[1] + 3 * p[1] }]));
+  }
+
+  const Position<2> bin { 4, 3 };
+  const auto sum = du.readRegion<std::int32_t, 2>(region, bin, Aggregation::Sum);
+  const auto mean = du.readRegion<std::int32_t, 2>(region, bin, Aggregation::Mean);
+  const auto max = du.readRegion<std::int32_t, 2>(region, bin, Aggregation::Max);
+  BOOST_TEST(sum.shape() == decimated.shape());
+  for (auto p : sum.domain()) {
+    const auto block = Region<2>::fromShape({ region.front[0] + p[0] * bin[0], region.front[1] + p[1] * bin[1] }, bin);
+    std::int32_t expectedSum = 0;
+    std::int32_t count = 0;
+    for (auto q : block) {
+      if (q[0] <= region.back[0] && q[1] <= region.back[1]) { // Blocks are truncated at the edges
+        expectedSum += input[q];
+        ++count;
+      }
+    }
+    BOOST_TEST(sum[p] == expectedSum);
+    BOOST_TEST(mean[p] == expectedSum / count);
+    const Position<2> last { std::min(block.back[0], region.back[0]), std::min(block.back[1], region.back[1]) };
+    BOOST_TEST(max[p] == input[last]);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(binned_region_output_type_test, Test::TemporarySifFile) {
+  VecRaster<std::uint8_t, 2> input({ 16, 16 });
+  std::fill(input.data(), input.data() + input.size(), 200);
+  const auto& du = raster();
+  du.reinit<std::uint8_t>(input.shape());
+  du.write(input);
+  const auto region = Region<2>::fromShape({ 0, 0 }, input.shape());
+
+  const auto wide = du.readRegion<std::int64_t, 2>(region, { 8, 8 }, Aggregation::Sum);
+  const auto narrow = du.readRegion<std::uint8_t, 2>(region, { 8, 8 }, Aggregation::Sum);
+  for (auto p : wide.domain()) {
+    BOOST_TEST(wide[p] == 200 * 8 * 8);
+    BOOST_TEST(narrow[p] == std::numeric_limits<std::uint8_t>::max()); // Saturated
+  }
+
+  BOOST_CHECK_THROW((du.readRegion<std::uint8_t, 2>(region, { 0, 1 })), FitsError);
+  BOOST_CHECK_THROW((du.readRegion<std::uint8_t, 2>(region, { 1, -2 }, Aggregation::Mean)), FitsError);
+}
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE_END()
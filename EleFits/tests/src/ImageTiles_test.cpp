@@ -0,0 +1,125 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFits/FitsFileFixture.h"
+#include "EleFits/ImageTiles.h"
+
+#include <boost/test/unit_test.hpp>
+#include <functional>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(ImageTiles_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(tiles_cover_the_image_in_file_order_test, Test::TemporarySifFile) {
+  VecRaster<std::int32_t, 2> input({ 40, 30 });
+  for (auto p : input.domain()) {
+    input[p] = 100 * p[1] + p[0];
+  }
+  const auto& du = raster();
+  du.reinit<std::int32_t>(input.shape());
+  du.write(input);
+  auto tiles = du.tiles<std::int32_t, 2>({ 16, 8 }, { 2, 1 });
+  BOOST_TEST((tiles.gridShape() == Position<2> { 3, 4 }));
+  BOOST_TEST(tiles.size() == 12);
+  BOOST_TEST(tiles.capacity() == 20 * 10);
+  VecRaster<std::int32_t, 2> visits(input.shape());
+  long previous = -1;
+  for (const auto& tile : tiles) {
+    const auto& region = tile.region();
+    const auto& halo = tile.haloRegion();
+    const long index = region.front[1] * input.shape()[0] + region.front[0];
+    BOOST_TEST(index > previous);
+    previous = index;
+    BOOST_TEST(halo.front[0] == std::max(region.front[0] - 2, 0L));
+    BOOST_TEST(halo.back[1] == std::min(region.back[1] + 1, 29L));
+    for (auto p : halo) {
+      BOOST_TEST(tile[p] == input[p]);
+    }
+    for (auto p : region) {
+      ++visits[p];
+    }
+  }
+  for (auto p : visits.domain()) {
+    BOOST_TEST(visits[p] == 1);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(edited_tiles_are_written_back_test, Test::TemporarySifFile) {
+  VecRaster<std::int32_t, 2> input({ 40, 30 });
+  for (auto p : input.domain()) {
+    input[p] = 100 * p[1] + p[0];
+  }
+  const auto& du = raster();
+  du.reinit<std::int32_t>(input.shape());
+  du.write(input);
+  for (auto& tile : du.editTiles<std::int32_t, 2>({ 12, 7 }, { 1, 1 })) {
+    for (auto p : tile.haloRegion()) {
+      tile[p] = -tile[p]; // Only the tile core is written back
+    }
+  }
+  const auto output = du.read<std::int32_t, 2>();
+  for (auto p : output.domain()) {
+    BOOST_TEST(output[p] == -input[p]);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(in_place_kernel_reads_input_halos_test, Test::TemporarySifFile) {
+  VecRaster<std::int32_t, 2> input({ 40, 30 });
+  for (auto p : input.domain()) {
+    input[p] = (p[0] * 7 + p[1] * 13) % 17;
+  }
+  const auto& du = raster();
+  du.reinit<std::int32_t>(input.shape());
+  du.write(input);
+  const auto sum3x3 = [](const Region<2>& domain, const Position<2>& p, std::function<std::int32_t(Position<2>)> at) {
+    std::int32_t sum = 0;
+    for (auto q : Region<2> { p - 1, p + 1 }) {
+      if (q[0] >= domain.front[0] && q[1] >= domain.front[1] && q[0] <= domain.back[0] && q[1] <= domain.back[1]) {
+        sum += at(q);
+      }
+    }
+    return sum;
+  };
+  for (auto& tile : du.editTiles<std::int32_t, 2>({ 12, 7 }, { 1, 1 })) {
+    VecRaster<std::int32_t, 2> smoothed(tile.region().shape());
+    for (auto p : tile.region()) {
+      smoothed[p - tile.region().front] = sum3x3(tile.haloRegion(), p, [&](Position<2> q) {
+        return tile[q];
+      });
+    }
+    for (auto p : tile.region()) {
+      tile[p] = smoothed[p - tile.region().front]; // Must not be seen by the next halos
+    }
+  }
+  const auto output = du.read<std::int32_t, 2>();
+  for (auto p : output.domain()) {
+    BOOST_TEST(output[p] == sum3x3(input.domain(), p, [&](Position<2> q) {
+      return input[q];
+    }));
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
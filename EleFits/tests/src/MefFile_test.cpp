@@ -17,6 +17,7 @@
  *
  */
 
+#include "EleFitsData/TestColumn.h"
 #include "EleFitsData/TestRaster.h"
 #include "EleFits/FitsFileFixture.h"
 #include "EleFits/MefFile.h"
@@ -80,6 +81,89 @@ BOOST_FIXTURE_TEST_CASE(append_test, Test::NewMefFile) {
   remove(this->filename().c_str());
 }
 
+BOOST_FIXTURE_TEST_CASE(reserved_rows_are_removed_at_close_test, Test::NewMefFile) {
+  const Test::SmallTable table;
+  const auto rowCount = table.numCol.rowCount();
+  const auto& columns = this->initBintableExt("TABLE", table.numCol.info()).columns();
+  this->initRecordExt("NEXT"); // Following HDU would be shifted at each append without reservation
+  columns.reserve(100);
+  columns.write(table.numCol);
+  BOOST_TEST(columns.readRowCount() == rowCount);
+  BOOST_TEST(columns.readCapacity() == 100);
+  this->close();
+  MefFile reopened(this->filename(), FileMode::Read); // Independent from the handlers of this file
+  const auto& ext = reopened.access<BintableHdu>("TABLE");
+  BOOST_TEST(ext.header().parse<long>("NAXIS2").value == rowCount);
+  BOOST_TEST(ext.readRowCount() == rowCount);
+  BOOST_TEST(ext.columns().readCapacity() == rowCount);
+  BOOST_TEST(ext.columns().read<Test::SmallTable::Num>(0).vector() == table.nums);
+  BOOST_TEST(reopened.readHduNames() == std::vector<std::string>({ "", "TABLE", "NEXT" }));
+  reopened.close();
+  remove(this->filename().c_str());
+}
+
+BOOST_FIXTURE_TEST_CASE(compressed_bintable_test, Test::NewMefFile) {
+  const long rowCount = 1000;
+  VecColumn<std::int32_t> ids({ "ID", "", 1 }, rowCount);
+  VecColumn<float> fluxes({ "FLUX", "Jy", 1 }, rowCount);
+  for (long i = 0; i < rowCount; ++i) {
+    ids(i) = static_cast<std::int32_t>(i / 10);
+    fluxes(i) = static_cast<float>(i % 10);
+  }
+  TableCompression compression(100);
+  compression.assign("ID", TableCompression::Algorithm::Rice);
+  const auto& ext = this->initBintableExt("TABLE", compression, ids.info(), fluxes.info());
+  this->initRecordExt("NEXT");
+  BOOST_TEST(ext.isCompressed());
+  ext.columns().write(ids);
+  ext.columns().write(fluxes);
+  BOOST_TEST(ext.readRowCount() == rowCount);
+  ext.header().write("USER", 1); // Kept when compressed back
+  ext.header().write("ZOOM", 2); // Not reserved although prefixed with Z
+  ext.header().write("TEMP1", 3); // Not reserved although prefixed with T and indexed
+  this->close();
+  this->open(this->filename(), FileMode::Read);
+  const auto& output = this->access<BintableHdu>("TABLE");
+  BOOST_TEST(output.matches(HduCategory::CompressedBintable));
+  BOOST_TEST(output.compression().tileRowCount == 100);
+  BOOST_TEST((output.compression().algorithm("ID") == TableCompression::Algorithm::Rice));
+  BOOST_TEST((output.compression().algorithm("FLUX") == TableCompression::Algorithm::ShuffledGzip));
+  BOOST_TEST(output.header().parse<int>("USER").value == 1);
+  BOOST_TEST(output.header().parse<int>("ZOOM").value == 2);
+  BOOST_TEST(output.header().parse<int>("TEMP1").value == 3);
+  BOOST_TEST(output.readRowCount() == rowCount);
+  BOOST_TEST(output.columns().read<std::int32_t>("ID").vector() == ids.vector());
+  BOOST_TEST(output.columns().read<float>(1).vector() == fluxes.vector());
+  BOOST_TEST(this->readHduNames() == std::vector<std::string>({ "", "TABLE", "NEXT" }));
+  remove(this->filename().c_str());
+}
+
+BOOST_FIXTURE_TEST_CASE(compressed_image_test, Test::NewMefFile) {
+  VecRaster<std::int32_t, 2> counts({ 64, 48 });
+  VecRaster<float, 2> fluxes(counts.shape());
+  for (long i = 0; i < counts.size(); ++i) {
+    counts.data()[i] = static_cast<std::int32_t>(i % 100);
+    fluxes.data()[i] = static_cast<float>(i % 7) / 2;
+  }
+  this->assignImageExt("COUNTS", counts, ImageCompression(ImageCompression::Algorithm::Rice, { 64, 8 }));
+  this->assignImageExt("FLUXES", fluxes, ImageCompression(ImageCompression::Algorithm::ShuffledGzip).quantize(0));
+  const ImageCompression tooManyDims(ImageCompression::Algorithm::Rice, { 1, 1, 1, 1, 1, 1, 1 });
+  BOOST_CHECK_THROW(this->assignImageExt("FAILED", counts, tooManyDims), FitsError);
+  this->assignImageExt("RAW", counts); // Compression is not inherited, even after a failure
+  this->close();
+  this->open(this->filename(), FileMode::Read);
+  const auto& compressedCounts = this->access<ImageHdu>("COUNTS");
+  BOOST_TEST(compressedCounts.matches(HduCategory::CompressedImageExt));
+  BOOST_TEST((compressedCounts.readRaster<std::int32_t, 2>().vector() == counts.vector()));
+  const auto& compressedFluxes = this->access<ImageHdu>("FLUXES");
+  BOOST_TEST(compressedFluxes.matches(HduCategory::CompressedImageExt));
+  BOOST_TEST((compressedFluxes.readRaster<float, 2>().vector() == fluxes.vector())); // Lossless
+  const auto& raw = this->access<ImageHdu>("RAW");
+  BOOST_TEST(raw.matches(HduCategory::RawImage));
+  BOOST_TEST((raw.readRaster<std::int32_t, 2>().vector() == counts.vector()));
+  remove(this->filename().c_str());
+}
+
 BOOST_FIXTURE_TEST_CASE(reaccess_hdu_and_use_previous_reference_test, Test::TemporaryMefFile) {
   const auto& firstlyAccessedPrimary = this->primary();
   BOOST_CHECK_NO_THROW(firstlyAccessedPrimary.readName());
@@ -0,0 +1,137 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+#include "EleFits/FitsFileFixture.h"
+#include "EleFits/TableSchema.h"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::Fits;
+
+namespace {
+
+struct Source {
+  std::int64_t id;
+  double ra;
+  float flux[3];
+  std::string name;
+};
+
+bool operator==(const Source& lhs, const Source& rhs) {
+  return lhs.id == rhs.id && lhs.ra == rhs.ra && std::equal(lhs.flux, lhs.flux + 3, rhs.flux) && lhs.name == rhs.name;
+}
+
+std::vector<Source> makeSources(long count) {
+  std::vector<Source> sources(count);
+  for (long i = 0; i < count; ++i) {
+    sources[i] = { i, i * 0.5, { 1.F * i, 2.F * i, 3.F * i }, "SRC" + std::to_string(i) };
+  }
+  return sources;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(TableSchema_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(tforms_are_generated_once_test) {
+  const auto schema = makeTableSchema(
+      SchemaColumn<std::int64_t> { "ID" },
+      SchemaColumn<double> { "RA", "deg" },
+      SchemaColumn<float, 3> { "FLUX", "Jy" });
+  BOOST_TEST(schema.columnCount == 3);
+  BOOST_TEST((schema.names() == std::vector<std::string> { "ID", "RA", "FLUX" }));
+  BOOST_TEST((schema.tforms() == std::vector<std::string> { "1K", "1D", "3E" }));
+  BOOST_TEST((schema.units() == std::vector<std::string> { "", "deg", "Jy" }));
+  BOOST_TEST(std::get<2>(schema.infos()).repeatCount == 3);
+  const auto columns = schema.makeColumns(10);
+  BOOST_TEST(std::get<0>(columns).rowCount() == 10);
+  BOOST_TEST(std::get<2>(columns).elementCount() == 30);
+}
+
+BOOST_AUTO_TEST_CASE(member_binding_test) {
+  struct Row {
+    std::int32_t a;
+    std::array<float, 2> b;
+  };
+  const auto schema = makeTableSchema(SchemaColumn<std::int32_t> { "A" }, SchemaColumn<float, 2> { "B" });
+  const auto binding = schema.bind(&Row::a, &Row::b);
+  Row row { 1, { 2.F, 3.F } };
+  BOOST_TEST(*binding.data<0>(row) == 1);
+  BOOST_TEST(binding.data<1>(row)[1] == 3.F);
+  *binding.data<1>(row) = 4.F;
+  BOOST_TEST(row.b[0] == 4.F);
+}
+
+BOOST_FIXTURE_TEST_CASE(aos_soa_raw_test, Test::TemporaryMefFile) {
+  const auto schema = makeTableSchema(
+      SchemaColumn<std::int64_t> { "ID" },
+      SchemaColumn<double> { "RA", "deg" },
+      SchemaColumn<float, 3> { "FLUX", "Jy" });
+  const auto binding = schema.bind(&Source::id, &Source::ra, &Source::flux);
+  const auto sources = makeSources(100);
+  const auto& columns = initBintableExt("SOURCES", schema).columns();
+  BOOST_TEST(columns.readName(2) == "FLUX");
+  columns.writeStructs(binding, sources);
+  BOOST_TEST(columns.readRowCount() == 100);
+  const auto soa = columns.readSeq(schema);
+  BOOST_TEST(std::get<0>(soa)(42) == 42);
+  BOOST_TEST(std::get<2>(soa)(42, 2) == 3.F * 42);
+  const auto aos = columns.readStructSegment({ 10, 19 }, binding);
+  BOOST_TEST(aos.size() == 10);
+  for (std::size_t i = 0; i < aos.size(); ++i) {
+    BOOST_TEST(aos[i].id == sources[10 + i].id);
+    BOOST_TEST(aos[i].ra == sources[10 + i].ra);
+    BOOST_TEST(aos[i].flux[1] == sources[10 + i].flux[1]);
+  }
+  BOOST_CHECK_THROW(columns.readStructSegment({ -1, 9 }, binding), OutOfBoundsError);
+  BOOST_CHECK_THROW(columns.readStructSegment({ 90, 100 }, binding), OutOfBoundsError);
+}
+
+BOOST_FIXTURE_TEST_CASE(aos_with_strings_and_extra_columns_test, Test::TemporaryMefFile) {
+  const auto schema = makeTableSchema(
+      SchemaColumn<std::int64_t> { "ID" },
+      SchemaColumn<double> { "RA", "deg" },
+      SchemaColumn<float, 3> { "FLUX", "Jy" },
+      SchemaColumn<std::string, 8> { "NAME" });
+  const auto binding = schema.bind(&Source::id, &Source::ra, &Source::flux, &Source::name);
+  const auto sources = makeSources(20);
+  const auto& columns = initBintableExt("SOURCES", schema).columns();
+  columns.writeStructs(binding, sources); // By columns because of the strings
+  BOOST_TEST((columns.readStructs(binding) == sources));
+  const auto numbers = makeTableSchema(SchemaColumn<double> { "RA", "deg" }, SchemaColumn<std::int64_t> { "ID" });
+  struct Number {
+    double ra;
+    std::int64_t id;
+  };
+  const auto numberBinding = numbers.bind(&Number::ra, &Number::id);
+  columns.writeStructSegment(15, numberBinding, std::vector<Number>(10, { -1., -1 })); // Raw, other columns kept
+  BOOST_TEST(columns.readRowCount() == 25);
+  const auto updated = columns.readStructs(binding);
+  BOOST_TEST((updated[14] == sources[14]));
+  BOOST_TEST(updated[15].id == -1);
+  BOOST_TEST(updated[15].name == sources[15].name);
+  BOOST_TEST(updated[24].ra == -1.);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,204 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+#ifndef _ELEFITSDATA_BITCOLUMN_H
+#define _ELEFITSDATA_BITCOLUMN_H
+
+#include "EleFitsData/Column.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup bintable_data_classes
+ * @brief Boolean column stored as a packed bitset.
+ * @details
+ * Values are stored as one bit each, row after row, without padding between rows,
+ * such that a column of `n` flags takes `n / 8` bytes instead of `n` bytes for a column of `unsigned char`s.
+ * Inside each byte, the first value is the most significant bit, like in `X` columns of FITS files.
+ *
+ * Bits are stored in 64-bit words, such that logical operations and counting process 64 values at once.
+ * The padding bits of the last word are always null.
+ *
+ * `BintableColumns` reads and writes such columns from and to bit (`X`) columns by blocks of raw bytes,
+ * and from and to logical (`L`) columns.
+ * @see \ref data_classes
+ */
+class BitColumn {
+
+public:
+  /**
+   * @brief The value type.
+   */
+  using Value = bool;
+
+  /**
+   * @brief The storage type.
+   */
+  using Word = std::uint64_t;
+
+  /**
+   * @brief Create an empty column.
+   */
+  BitColumn();
+
+  /**
+   * @brief Create a column of `false` values with given metadata and number of rows.
+   */
+  BitColumn(ColumnInfo<bool> info, long rowCount);
+
+  /**
+   * @brief Create a column with given metadata and values.
+   * @details
+   * The number of rows is deduced from the number of values and the repeat count.
+   * @throw FitsError if the number of values is not a multiple of the repeat count
+   */
+  BitColumn(ColumnInfo<bool> info, const std::vector<bool>& values);
+
+  /**
+   * @brief Get the column metadata.
+   */
+  const ColumnInfo<bool>& info() const;
+
+  /**
+   * @brief Change the column name.
+   */
+  void rename(const std::string& name);
+
+  /**
+   * @brief Get the number of rows.
+   */
+  long rowCount() const;
+
+  /**
+   * @brief Get the number of values.
+   */
+  long elementCount() const;
+
+  /**
+   * @brief Get the value at given row and repeat index.
+   */
+  bool operator()(long row, long repeat = 0) const;
+
+  /**
+   * @brief Get the value at given row and repeat index with bound checking and backward indexing.
+   * @see Column::at()
+   */
+  bool at(long row, long repeat = 0) const;
+
+  /**
+   * @brief Set the value at given row and repeat index.
+   */
+  void assign(long row, long repeat, bool value);
+
+  /**
+   * @brief Count the `true` values.
+   */
+  long count() const;
+
+  /**
+   * @brief Check whether some value is `true`.
+   */
+  bool any() const;
+
+  /**
+   * @brief Negate all the values.
+   */
+  BitColumn& flip();
+
+  /**
+   * @brief Apply a logical AND with a column of same shape, value-wise.
+   */
+  BitColumn& operator&=(const BitColumn& rhs);
+
+  /**
+   * @brief Apply a logical OR with a column of same shape, value-wise.
+   */
+  BitColumn& operator|=(const BitColumn& rhs);
+
+  /**
+   * @brief Apply a logical XOR with a column of same shape, value-wise.
+   */
+  BitColumn& operator^=(const BitColumn& rhs);
+
+  /**
+   * @brief Get the number of words.
+   */
+  long wordCount() const;
+
+  /**
+   * @brief Get a pointer to the words.
+   */
+  const Word* words() const;
+
+  /**
+   * @copydoc words()
+   */
+  Word* words();
+
+  /**
+   * @brief Get a pointer to the bytes, where the first value is the most significant bit of the first byte.
+   * @details
+   * There are at least `(elementCount() + 7) / 8` bytes.
+   */
+  const unsigned char* bytes() const;
+
+  /**
+   * @copydoc bytes()
+   */
+  unsigned char* bytes();
+
+  /**
+   * @brief Copy the values as a vector of `bool`s.
+   */
+  std::vector<bool> values() const;
+
+private:
+  /**
+   * @brief Throw if the shapes differ.
+   */
+  void mayThrowShapeError(const BitColumn& rhs) const;
+
+  /**
+   * @brief Reset the padding bits to 0.
+   */
+  void clearPadding();
+
+  /**
+   * @brief The column metadata.
+   */
+  ColumnInfo<bool> m_info;
+
+  /**
+   * @brief The number of rows.
+   */
+  long m_rowCount;
+
+  /**
+   * @brief The bitset.
+   */
+  std::vector<Word> m_words;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
@@ -21,6 +21,7 @@
 #define _ELEFITSDATA_COLUMN_H
 
 #include "EleFitsData/DataUtils.h"
+#include "EleFitsData/Raster.h"
 
 #include <complex>
 #include <cstdint>
@@ -39,7 +40,7 @@ namespace Fits {
  * @see ELEFITS_FOREACH_RASTER_TYPE
  */
 #define ELEFITS_FOREACH_COLUMN_TYPE(MACRO) \
-  /* MACRO(bool, bool) // TODO Could be supported at some point */ \
+  /* MACRO(bool, bool) // Packed as BitColumn */ \
   MACRO(char, char) \
   MACRO(std::int16_t, int16) \
   MACRO(std::int32_t, int32) \
@@ -140,6 +141,15 @@ struct ColumnInfo {
    * including the `\0` character.
    */
   long repeatCount = 1;
+
+  /**
+   * @brief Shape of the cells of multidimensional columns, i.e. `TDIMn`, or empty for flat cells.
+   * @details
+   * If not empty, the shape size must be equal to the repeat count.
+   * The first axis is the fastest varying one, like for images, such that a cell can be viewed as a raster
+   * with `Column::entry()`.
+   */
+  Position<-1> shape {};
 };
 
 // Forward declaration for Column::slice()
@@ -194,6 +204,7 @@ public:
    * @brief Change the column repeat count (fold/unfold).
    * @details
    * The repeat count must be a divisor of the columns size, except for string columns.
+   * The cell shape is reset, i.e. the cells are flat.
    */
   void reshape(long repeatCount = 1);
 
@@ -258,6 +269,32 @@ public:
    */
   T& at(long row, long repeat = 0);
 
+  /**
+   * @brief Get a view on the cell at given row, as a raster of the shape given by `ColumnInfo::shape`.
+   * @tparam n The raster dimension, which must match the shape dimension, or -1
+   * @details
+   * No data is copied: the raster points to the column data.
+   * Flat cells are viewed as 1D rasters of length `repeatCount`.
+   * Throw if the dimension or the size of the shape does not match.
+   *
+   * Example usage, e.g. to iterate over a stack of cutouts:
+   * \code
+   * VecColumn<float> cutouts({ "CUTOUT", "", 64 * 32, { 64, 32 } }, rowCount);
+   * for (long row = 0; row < cutouts.rowCount(); ++row) {
+   *   auto cutout = cutouts.entry<2>(row);
+   *   processCutout(cutout); // Accessed as cutout[{ x, y }]
+   * }
+   * \endcode
+   */
+  template <long n = 1>
+  const PtrRaster<const T, n> entry(long row) const;
+
+  /**
+   * @copydoc entry()
+   */
+  template <long n = 1>
+  PtrRaster<T, n> entry(long row);
+
   /// @}
   /**
    * @name Slicing
@@ -277,6 +314,12 @@ public:
   /// @}
 
 private:
+  /**
+   * @brief Get the shape of the cells, and check it against the raster dimension and the repeat count.
+   */
+  template <long n>
+  Position<n> entryShape() const;
+
   /**
    * @brief Implementation of `elementCount()`.
    */
@@ -0,0 +1,161 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITSDATA_FIXEDSTRINGCOLUMN_H
+#define _ELEFITSDATA_FIXEDSTRINGCOLUMN_H
+
+#include "EleFitsData/Column.h"
+
+#include <boost/utility/string_view.hpp>
+#include <string>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup bintable_data_classes
+ * @brief String column stored as a contiguous arena of fixed-width cells.
+ * @details
+ * Unlike `VecColumn<std::string>`, which owns one heap-allocated `std::string` per row,
+ * the values are stored in a single buffer of `rowCount * (repeatCount + 1)` characters,
+ * where each cell is null-terminated.
+ * Values are accessed as `boost::string_view`s, which do not allocate memory.
+ *
+ * `BintableColumns` reads and writes such columns with one call to CFitsIO per chunk of rows,
+ * and without per-row heap allocation.
+ *
+ * The repeat count is the width of the column in the file, i.e. the maximum number of characters in a cell.
+ * @see \ref data_classes
+ */
+class FixedStringColumn {
+
+public:
+  /**
+   * @brief The value type in the file, used to select the column format.
+   */
+  using Value = std::string;
+
+  /**
+   * @brief Create an empty column.
+   */
+  FixedStringColumn();
+
+  /**
+   * @brief Create a column of empty strings with given metadata and number of rows.
+   */
+  FixedStringColumn(ColumnInfo<std::string> info, long rowCount);
+
+  /**
+   * @brief Create a column with given metadata and values.
+   * @details
+   * Throw if some value is longer than the repeat count.
+   */
+  FixedStringColumn(ColumnInfo<std::string> info, const std::vector<std::string>& values);
+
+  /**
+   * @brief Get the column metadata.
+   */
+  const ColumnInfo<std::string>& info() const;
+
+  /**
+   * @brief Change the column name.
+   */
+  void rename(const std::string& name);
+
+  /**
+   * @brief Get the number of rows.
+   */
+  long rowCount() const;
+
+  /**
+   * @brief Get the number of elements, which is the number of rows, like for `Column<std::string>`.
+   */
+  long elementCount() const;
+
+  /**
+   * @brief Get the number of characters between the beginnings of two consecutive cells.
+   */
+  long stride() const;
+
+  /**
+   * @brief Get the value at given row.
+   * @details
+   * The view is valid as long as the column is neither destroyed nor modified.
+   */
+  boost::string_view operator()(long row) const;
+
+  /**
+   * @brief Get the value at given row with bound checking and backward indexing (see `Column::at()`).
+   */
+  boost::string_view at(long row) const;
+
+  /**
+   * @brief Set the value at given row.
+   * @details
+   * Throw if the value is longer than the repeat count.
+   */
+  void assign(long row, boost::string_view value);
+
+  /**
+   * @brief Get a pointer to the null-terminated cell at given row.
+   */
+  const char* cell(long row) const;
+
+  /**
+   * @copydoc cell()
+   */
+  char* cell(long row);
+
+  /**
+   * @brief Get a pointer to the arena.
+   */
+  const char* data() const;
+
+  /**
+   * @copydoc data()
+   */
+  char* data();
+
+  /**
+   * @brief Copy the values as a vector of `std::string`s.
+   */
+  std::vector<std::string> strings() const;
+
+private:
+  /**
+   * @brief The column metadata.
+   */
+  ColumnInfo<std::string> m_info;
+
+  /**
+   * @brief The number of rows.
+   */
+  long m_rowCount;
+
+  /**
+   * @brief The arena.
+   */
+  std::vector<char> m_arena;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
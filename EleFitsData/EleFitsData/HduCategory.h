@@ -78,6 +78,7 @@ protected:
     ImageBintable, ///< Image / binary table HDU
     IntFloatImage, ///< Integer- / real-valued image
     RawCompressedImage, ///< Raw / compressed image
+    RawCompressedBintable, ///< Raw / compressed binary table
     UntouchedTouched, ///< Untouched / accessed HDU
     ExisitedCreated, ///< Pre-existing / created HDU
     ReadEdited, ///< Read / edited HDU
@@ -215,6 +216,7 @@ public:
   static const HduCategory Metadata; ///< HDU without data
   static const HduCategory IntImage; ///< Integer-valued image HDU
   static const HduCategory RawImage; ///< Raw (non-compressed) image HDU
+  static const HduCategory RawBintable; ///< Raw (non-compressed) binary table HDU
 
   /* Opposite categories */
   static const HduCategory Ext; ///< Extension
@@ -223,6 +225,7 @@ public:
   static const HduCategory FloatImage; ///< Real-valued image HDU
   static const HduCategory
       CompressedImageExt; ///< Compressed image HDU (effectively written as a binary table extension)
+  static const HduCategory CompressedBintable; ///< Tile-compressed binary table HDU
 
   /* Compound categories */
   static const HduCategory MetadataPrimary; ///< Primary HDU without data
@@ -0,0 +1,113 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITSDATA_IMAGECOMPRESSION_H
+#define _ELEFITSDATA_IMAGECOMPRESSION_H
+
+#include "EleFitsData/Position.h"
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup image_data_classes
+ * @brief Tile compression parameters of an image.
+ * @details
+ * The image is split into tiles of shape `tileShape`, which are compressed independently with `algorithm`.
+ * Real-valued images are first quantized to integers, with a step of `1 / quantization` times the noise,
+ * and optionally dithered to preserve the statistics of the background:
+ * \code
+ * ImageCompression compression(ImageCompression::Algorithm::Rice, { 512, 512 });
+ * compression.quantize(16, ImageCompression::Dithering::NonZeroPixel);
+ * \endcode
+ * 
+ * Compressed images are read and written like raw images, the tiles being (un)compressed on the fly.
+ * Regions should be written by whole tiles, in file order, e.g. with `ImageTiles`.
+ */
+struct ImageCompression {
+
+  /**
+   * @brief The compression algorithms.
+   */
+  enum class Algorithm
+  {
+    Rice, ///< Rice (`RICE_1`), fast and efficient for noisy images
+    Gzip, ///< Gzip (`GZIP_1`)
+    ShuffledGzip, ///< Gzip with byte shuffling (`GZIP_2`), which generally performs better on numbers
+    Hcompress, ///< H-transform (`HCOMPRESS_1`), for 2D images only
+    Plio ///< IRAF pixel list (`PLIO_1`), for masks of positive integers below 2^24 only
+  };
+
+  /**
+   * @brief The dithering methods of quantization.
+   */
+  enum class Dithering
+  {
+    None, ///< No dithering (`NO_DITHER`)
+    EveryPixel, ///< Subtractive dithering of every pixel (`SUBTRACTIVE_DITHER_1`)
+    NonZeroPixel ///< Subtractive dithering of non-zero pixels (`SUBTRACTIVE_DITHER_2`), which preserves zeros
+  };
+
+  /**
+   * @brief Constructor.
+   * @param algo The algorithm
+   * @param shape The tile shape, or an empty position to compress row by row
+   */
+  explicit ImageCompression(Algorithm algo = Algorithm::Rice, const Position<-1>& shape = {});
+
+  /**
+   * @brief Set the quantization of real-valued images.
+   * @param level The number of quantization levels per noise standard deviation,
+   * or the opposite of the quantization step if negative,
+   * or 0 for lossless compression (only supported by Gzip for real-valued images)
+   * @param method The dithering method
+   */
+  ImageCompression& quantize(float level, Dithering method = Dithering::EveryPixel);
+
+  /**
+   * @brief Check whether the compression of real-valued images is lossless.
+   */
+  bool isLossless() const;
+
+  /**
+   * @brief The algorithm.
+   */
+  Algorithm algorithm;
+
+  /**
+   * @brief The tile shape, or an empty position to compress row by row.
+   */
+  Position<-1> tileShape;
+
+  /**
+   * @brief The quantization level of real-valued images.
+   * @see quantize()
+   */
+  float quantization;
+
+  /**
+   * @brief The dithering method of quantization.
+   */
+  Dithering dithering;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
@@ -0,0 +1,192 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+#ifndef _ELEFITSDATA_NULLABLECOLUMN_H
+#define _ELEFITSDATA_NULLABLECOLUMN_H
+
+#include "EleFitsData/BitColumn.h"
+#include "EleFitsData/Column.h"
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup bintable_data_classes
+ * @brief Column with a validity bitmap.
+ * @details
+ * Values are stored in a `VecColumn`, and their validity in a `BitColumn` of the same shape,
+ * where a `false` bit denotes a null value.
+ * Null values are undefined: they are generally those of the file, e.g. `TNULLn` or NaN.
+ *
+ * The bitmap is built from the values in a single pass by `updateValidity()`,
+ * which compares 8 values at a time and writes whole bytes, such that the loop is vectorized by the compiler.
+ * Null values are then skipped by `foreachValid()` by words of 64 bits,
+ * without comparing the values again.
+ *
+ * `BintableColumns` reads such columns as raw row blocks before building the bitmap,
+ * and writes the `TNULLn` value (or NaN) in bulk with `fill()`.
+ * @see \ref data_classes
+ */
+template <typename T>
+class NullableColumn {
+
+public:
+  /**
+   * @brief The value type.
+   */
+  using Value = std::decay_t<T>;
+
+  /**
+   * @brief Create an empty column.
+   */
+  NullableColumn();
+
+  /**
+   * @brief Create a column of null values with given metadata and number of rows.
+   */
+  NullableColumn(ColumnInfo<Value> info, long rowCount);
+
+  /**
+   * @brief Create a column of valid values.
+   */
+  explicit NullableColumn(VecColumn<Value> values);
+
+  /**
+   * @brief Create a column from values and validity.
+   * @details
+   * Throw if the shapes differ.
+   */
+  NullableColumn(VecColumn<Value> values, BitColumn validity);
+
+  /**
+   * @brief Get the column metadata.
+   */
+  const ColumnInfo<Value>& info() const;
+
+  /**
+   * @brief Change the column name.
+   */
+  void rename(const std::string& name);
+
+  /**
+   * @brief Get the number of rows.
+   */
+  long rowCount() const;
+
+  /**
+   * @brief Get the number of values, including the null ones.
+   */
+  long elementCount() const;
+
+  /**
+   * @brief Get the number of null values.
+   */
+  long nullCount() const;
+
+  /**
+   * @brief Get the values, including the undefined null ones.
+   */
+  const VecColumn<Value>& values() const;
+
+  /**
+   * @copydoc values()
+   */
+  VecColumn<Value>& values();
+
+  /**
+   * @brief Get the validity bitmap.
+   */
+  const BitColumn& validity() const;
+
+  /**
+   * @copydoc validity()
+   */
+  BitColumn& validity();
+
+  /**
+   * @brief Check whether the value at given row and repeat index is not null.
+   */
+  bool isValid(long row, long repeat = 0) const;
+
+  /**
+   * @brief Get the value at given row and repeat index, which is undefined if null.
+   */
+  const Value& operator()(long row, long repeat = 0) const;
+
+  /**
+   * @brief Set the value at given row and repeat index, which becomes valid.
+   */
+  void assign(long row, long repeat, const Value& value);
+
+  /**
+   * @brief Set the value at given row and repeat index to null.
+   */
+  void nullify(long row, long repeat = 0);
+
+  /**
+   * @brief Rebuild the validity bitmap, where NaNs (for floating point and complex types) are null.
+   */
+  void updateValidity();
+
+  /**
+   * @brief Rebuild the validity bitmap, where values equal to a given one (and NaNs) are null.
+   */
+  void updateValidity(const Value& null);
+
+  /**
+   * @brief Copy the values, where null values are replaced with a given one.
+   */
+  VecColumn<Value> fill(const Value& null) const;
+
+  /**
+   * @brief Apply a function to each valid value.
+   * @param func The function, which takes as input the row index, the repeat index and the value
+   * @details
+   * Bytes and words of null values are skipped without accessing the values.
+   */
+  template <typename TFunc>
+  void foreachValid(TFunc&& func) const;
+
+private:
+  /**
+   * @brief Rebuild the validity bitmap with a predicate which returns `true` for null values.
+   */
+  template <typename TPredicate>
+  void updateValidityImpl(TPredicate&& isNull);
+
+  /**
+   * @brief The values.
+   */
+  VecColumn<Value> m_values;
+
+  /**
+   * @brief The validity bitmap.
+   */
+  BitColumn m_validity;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITSDATA_NULLABLECOLUMN_IMPL
+#include "EleFitsData/impl/NullableColumn.hpp"
+#undef _ELEFITSDATA_NULLABLECOLUMN_IMPL
+/// @endcond
+
+#endif
@@ -51,6 +51,17 @@ namespace Fits {
   MACRO(std::uint32_t, uint32) \
   MACRO(std::uint64_t, uint64)
 
+/**
+ * @ingroup image_data_classes
+ * @brief The operation which reduces blocks of pixels to a single pixel when reading binned regions.
+ */
+enum class Aggregation
+{
+  Sum, ///< Sum of the pixels
+  Mean, ///< Mean of the pixels
+  Max ///< Maximum of the pixels
+};
+
 // Forward declaration for Raster::subraster()
 template <typename T, long n>
 class Subraster;
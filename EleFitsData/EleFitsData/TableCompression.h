@@ -0,0 +1,89 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITSDATA_TABLECOMPRESSION_H
+#define _ELEFITSDATA_TABLECOMPRESSION_H
+
+#include <map>
+#include <string>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup bintable_data_classes
+ * @brief Tile compression parameters of a binary table.
+ * @details
+ * Rows are grouped into tiles of `tileRowCount` rows,
+ * and each column of each tile is compressed independently with the algorithm of the column.
+ * Columns without specific algorithm are compressed with the default algorithm:
+ * \code
+ * TableCompression compression(10000); // Shuffled Gzip for all columns
+ * compression.assign("COUNT", TableCompression::Algorithm::Rice);
+ * \endcode
+ */
+struct TableCompression {
+
+  /**
+   * @brief The compression algorithms.
+   */
+  enum class Algorithm
+  {
+    Gzip, ///< Gzip (`GZIP_1`)
+    ShuffledGzip, ///< Gzip with byte shuffling (`GZIP_2`), which generally performs better on numbers
+    Rice ///< Rice (`RICE_1`), for integer columns only
+  };
+
+  /**
+   * @brief Constructor.
+   * @param rowCount The number of rows per tile, or 0 to let CFitsIO choose
+   * @param algo The default algorithm
+   */
+  explicit TableCompression(long rowCount = 0, Algorithm algo = Algorithm::ShuffledGzip);
+
+  /**
+   * @brief Set the algorithm of a given column.
+   */
+  TableCompression& assign(const std::string& name, Algorithm algo);
+
+  /**
+   * @brief Get the algorithm of a given column.
+   */
+  Algorithm algorithm(const std::string& name) const;
+
+  /**
+   * @brief The number of rows per tile, or 0 to let CFitsIO choose.
+   */
+  long tileRowCount;
+
+  /**
+   * @brief The algorithm of the columns which are not in `columnAlgorithms`.
+   */
+  Algorithm defaultAlgorithm;
+
+  /**
+   * @brief The column-specific algorithms, by column name.
+   */
+  std::map<std::string, Algorithm> columnAlgorithms;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
@@ -0,0 +1,199 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+#ifndef _ELEFITSDATA_VLACOLUMN_H
+#define _ELEFITSDATA_VLACOLUMN_H
+
+#include "EleFitsData/Column.h"
+
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @ingroup bintable_data_classes
+ * @brief Variable-length array column, i.e. column of `P` or `Q` format.
+ * @details
+ * Each row, or entry, is an array of arbitrary size.
+ * The values of all the entries are stored contiguously in a single flat buffer,
+ * and the entry at row `i` spans the range `[offsets()[i], offsets()[i + 1])` of the buffer,
+ * such that `offsets()` has `rowCount() + 1` elements, the first of which is 0.
+ *
+ * This layout maps closely the FITS heap,
+ * and allows `BintableColumns` to read and write the entries with a few large heap accesses
+ * instead of one CFitsIO call per row.
+ *
+ * The repeat count of the metadata is that of the descriptors, i.e. 1.
+ * @see \ref data_classes
+ */
+template <typename T>
+class VlaColumn {
+
+public:
+  /**
+   * @brief The value type.
+   */
+  using Value = std::decay_t<T>;
+
+  /**
+   * @brief Create an empty column.
+   */
+  VlaColumn();
+
+  /**
+   * @brief Create a column with given metadata and no rows.
+   */
+  explicit VlaColumn(ColumnInfo<Value> info);
+
+  /**
+   * @brief Create a column with given metadata, offsets and values.
+   * @details
+   * Throw if the offsets are not increasing from 0 to the number of values.
+   */
+  VlaColumn(ColumnInfo<Value> info, std::vector<long> offsets, std::vector<Value> values);
+
+  /**
+   * @brief Create a column with given metadata and entries.
+   */
+  VlaColumn(ColumnInfo<Value> info, const std::vector<std::vector<Value>>& entries);
+
+  /**
+   * @brief Get the column metadata.
+   */
+  const ColumnInfo<Value>& info() const;
+
+  /**
+   * @brief Change the column name.
+   */
+  void rename(const std::string& name);
+
+  /**
+   * @brief Get the number of rows.
+   */
+  long rowCount() const;
+
+  /**
+   * @brief Get the total number of values.
+   */
+  long elementCount() const;
+
+  /**
+   * @brief Get the number of values of the entry at given row.
+   */
+  long entrySize(long row) const;
+
+  /**
+   * @brief Get the largest entry size, or 0 if the column is empty.
+   */
+  long maxEntrySize() const;
+
+  /**
+   * @brief Get a pointer to the first value of the entry at given row.
+   */
+  const Value* entry(long row) const;
+
+  /**
+   * @copydoc entry()
+   */
+  Value* entry(long row);
+
+  /**
+   * @brief Get the value at given row and index in the entry.
+   */
+  const Value& operator()(long row, long index = 0) const;
+
+  /**
+   * @copydoc operator()()
+   */
+  Value& operator()(long row, long index = 0);
+
+  /**
+   * @brief Get the value at given row and index with bound checking and backward indexing (see `Column::at()`).
+   */
+  const Value& at(long row, long index = 0) const;
+
+  /**
+   * @copydoc at()
+   */
+  Value& at(long row, long index = 0);
+
+  /**
+   * @brief Append an uninitialized entry of given size, and get a pointer to its first value.
+   * @details
+   * The pointers to the values are invalidated.
+   */
+  Value* append(long size);
+
+  /**
+   * @brief Append an entry.
+   */
+  void append(const std::vector<Value>& entry);
+
+  /**
+   * @brief Reserve memory for given numbers of rows and values.
+   */
+  void reserve(long rowCount, long elementCount);
+
+  /**
+   * @brief Get the offsets of the entries in the flat buffer, including the end offset.
+   */
+  const std::vector<long>& offsets() const;
+
+  /**
+   * @brief Get a pointer to the flat buffer.
+   */
+  const Value* data() const;
+
+  /**
+   * @copydoc data()
+   */
+  Value* data();
+
+  /**
+   * @brief Copy the entries as a vector of vectors.
+   */
+  std::vector<std::vector<Value>> entries() const;
+
+private:
+  /**
+   * @brief The column metadata.
+   */
+  ColumnInfo<Value> m_info;
+
+  /**
+   * @brief The offsets of the entries, of size `rowCount() + 1`.
+   */
+  std::vector<long> m_offsets;
+
+  /**
+   * @brief The flat buffer.
+   */
+  std::vector<Value> m_values;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITSDATA_VLACOLUMN_IMPL
+#include "EleFitsData/impl/VlaColumn.hpp"
+#undef _ELEFITSDATA_VLACOLUMN_IMPL
+/// @endcond
+
+#endif
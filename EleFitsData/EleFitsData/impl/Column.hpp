@@ -68,6 +68,7 @@ template <typename T>
 void Column<T>::reshape(long repeatCount) {
   // FIXME check that elementCount() % repeatCount = 0, but for strings!
   m_info.repeatCount = repeatCount;
+  m_info.shape = Position<-1>();
 }
 
 template <typename T>
@@ -124,6 +125,40 @@ T* Column<T>::data() {
   return const_cast<T*>(const_cast<const Column<T>*>(this)->data());
 }
 
+template <typename T>
+template <long n>
+const PtrRaster<const T, n> Column<T>::entry(long row) const {
+  return { entryShape<n>(), &operator()(row) };
+}
+
+template <typename T>
+template <long n>
+PtrRaster<T, n> Column<T>::entry(long row) {
+  return { entryShape<n>(), &operator()(row) };
+}
+
+template <typename T>
+template <long n>
+Position<n> Column<T>::entryShape() const {
+  const auto& shape = m_info.shape;
+  if (shape.size() == 0) {
+    if (n != -1 && n != 1) {
+      throw FitsError("Cannot view flat cells as rasters of dimension " + std::to_string(n));
+    }
+    const long flat[] = { m_info.repeatCount };
+    return Position<n>(flat, flat + 1);
+  }
+  if (n != -1 && shape.size() != n) {
+    throw FitsError(
+        "Cannot view cells of dimension " + std::to_string(shape.size()) + " as rasters of dimension " +
+        std::to_string(n));
+  }
+  if (shapeSize(shape) != m_info.repeatCount) {
+    throw FitsError("Cell shape does not match repeat count: " + std::to_string(m_info.repeatCount));
+  }
+  return Position<n>(shape.begin(), shape.end());
+}
+
 template <typename T>
 const PtrColumn<const T> Column<T>::slice(const Segment& rows) const {
   return { info(), elementCount() / rowCount() * rows.size(), &operator()(rows.front) }; // FIXME repeatCount?
@@ -0,0 +1,246 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+#if defined(_ELEFITSDATA_NULLABLECOLUMN_IMPL) || defined(CHECK_QUALITY)
+
+  #include "EleFitsData/FitsError.h"
+  #include "EleFitsData/NullableColumn.h"
+
+  #include <algorithm>
+  #include <complex>
+
+namespace Euclid {
+namespace Fits {
+
+/// @cond INTERNAL
+namespace Internal {
+
+/**
+ * @brief Check whether a value is NaN, which is always `false` for non-floating point types.
+ */
+template <typename T>
+inline bool isNan(const T&) {
+  return false;
+}
+
+/**
+ * @copydoc isNan
+ */
+inline bool isNan(float value) {
+  return value != value;
+}
+
+/**
+ * @copydoc isNan
+ */
+inline bool isNan(double value) {
+  return value != value;
+}
+
+/**
+ * @brief Check whether the real or imaginary part of a complex value is NaN.
+ */
+template <typename T>
+inline bool isNan(const std::complex<T>& value) {
+  return isNan(value.real()) || isNan(value.imag());
+}
+
+} // namespace Internal
+/// @endcond
+
+template <typename T>
+NullableColumn<T>::NullableColumn() : NullableColumn(ColumnInfo<Value> { "", "", 1 }, 0) {}
+
+template <typename T>
+NullableColumn<T>::NullableColumn(ColumnInfo<Value> info, long rowCount) :
+    m_values(info, rowCount), m_validity({ info.name, "", info.repeatCount }, rowCount) {}
+
+template <typename T>
+NullableColumn<T>::NullableColumn(VecColumn<Value> values) :
+    m_values(std::move(values)),
+    m_validity({ m_values.info().name, "", m_values.info().repeatCount }, m_values.rowCount()) {
+  m_validity.flip(); // Padding is not flipped
+}
+
+template <typename T>
+NullableColumn<T>::NullableColumn(VecColumn<Value> values, BitColumn validity) :
+    m_values(std::move(values)), m_validity(std::move(validity)) {
+  if (m_validity.rowCount() != m_values.rowCount() ||
+      m_validity.info().repeatCount != m_values.info().repeatCount) {
+    throw FitsError("Shapes of values and validity of nullable column differ: " + m_values.info().name);
+  }
+}
+
+template <typename T>
+const ColumnInfo<typename NullableColumn<T>::Value>& NullableColumn<T>::info() const {
+  return m_values.info();
+}
+
+template <typename T>
+void NullableColumn<T>::rename(const std::string& name) {
+  m_values.rename(name);
+  m_validity.rename(name);
+}
+
+template <typename T>
+long NullableColumn<T>::rowCount() const {
+  return m_values.rowCount();
+}
+
+template <typename T>
+long NullableColumn<T>::elementCount() const {
+  return m_values.elementCount();
+}
+
+template <typename T>
+long NullableColumn<T>::nullCount() const {
+  return elementCount() - m_validity.count();
+}
+
+template <typename T>
+const VecColumn<typename NullableColumn<T>::Value>& NullableColumn<T>::values() const {
+  return m_values;
+}
+
+template <typename T>
+VecColumn<typename NullableColumn<T>::Value>& NullableColumn<T>::values() {
+  return m_values;
+}
+
+template <typename T>
+const BitColumn& NullableColumn<T>::validity() const {
+  return m_validity;
+}
+
+template <typename T>
+BitColumn& NullableColumn<T>::validity() {
+  return m_validity;
+}
+
+template <typename T>
+bool NullableColumn<T>::isValid(long row, long repeat) const {
+  return m_validity(row, repeat);
+}
+
+template <typename T>
+const typename NullableColumn<T>::Value& NullableColumn<T>::operator()(long row, long repeat) const {
+  return m_values(row, repeat);
+}
+
+template <typename T>
+void NullableColumn<T>::assign(long row, long repeat, const Value& value) {
+  m_values(row, repeat) = value;
+  m_validity.assign(row, repeat, true);
+}
+
+template <typename T>
+void NullableColumn<T>::nullify(long row, long repeat) {
+  m_validity.assign(row, repeat, false);
+}
+
+template <typename T>
+void NullableColumn<T>::updateValidity() {
+  updateValidityImpl([](const Value& v) {
+    return Internal::isNan(v);
+  });
+}
+
+template <typename T>
+void NullableColumn<T>::updateValidity(const Value& null) {
+  updateValidityImpl([&](const Value& v) {
+    return v == null || Internal::isNan(v);
+  });
+}
+
+template <typename T>
+VecColumn<typename NullableColumn<T>::Value> NullableColumn<T>::fill(const Value& null) const {
+  VecColumn<Value> res(m_values);
+  auto* data = res.data();
+  const auto* bytes = m_validity.bytes();
+  const long byteCount = (elementCount() + 7) / 8;
+  for (long b = 0; b < byteCount; ++b) {
+    if (bytes[b] == 0xFF) {
+      continue;
+    }
+    const long front = b * 8;
+    const long size = std::min(8L, elementCount() - front);
+    for (long k = 0; k < size; ++k) {
+      if (not(bytes[b] & (0x80 >> k))) {
+        data[front + k] = null;
+      }
+    }
+  }
+  return res;
+}
+
+template <typename T>
+template <typename TFunc>
+void NullableColumn<T>::foreachValid(TFunc&& func) const {
+  const auto repeatCount = info().repeatCount;
+  const auto* data = m_values.data();
+  const auto* words = m_validity.words();
+  const auto* bytes = m_validity.bytes();
+  const long wordCount = m_validity.wordCount();
+  const long byteCount = (elementCount() + 7) / 8;
+  for (long w = 0; w < wordCount; ++w) {
+    if (words[w] == 0) {
+      continue;
+    }
+    const long end = std::min(byteCount, (w + 1) * 8L);
+    for (long b = w * 8; b < end; ++b) {
+      if (bytes[b] == 0) {
+        continue;
+      }
+      for (long k = 0; k < 8; ++k) {
+        if (bytes[b] & (0x80 >> k)) {
+          const long i = b * 8 + k; // Padding bits are null
+          func(i / repeatCount, i % repeatCount, data[i]);
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+template <typename TPredicate>
+void NullableColumn<T>::updateValidityImpl(TPredicate&& isNull) {
+  const auto* data = m_values.data();
+  auto* bytes = m_validity.bytes();
+  const long elementCount = this->elementCount();
+  const long fullByteCount = elementCount / 8;
+  for (long b = 0; b < fullByteCount; ++b, data += 8) {
+    unsigned char byte = 0;
+    for (long k = 0; k < 8; ++k) { // Branchless, vectorizable
+      byte |= static_cast<unsigned char>(not isNull(data[k])) << (7 - k);
+    }
+    bytes[b] = byte;
+  }
+  const long remainder = elementCount - fullByteCount * 8;
+  if (remainder > 0) {
+    unsigned char byte = 0;
+    for (long k = 0; k < remainder; ++k) {
+      byte |= static_cast<unsigned char>(not isNull(data[k])) << (7 - k);
+    }
+    bytes[fullByteCount] = byte; // Padding bits are kept null
+  }
+}
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
@@ -0,0 +1,172 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+#if defined(_ELEFITSDATA_VLACOLUMN_IMPL) || defined(CHECK_QUALITY)
+
+  #include "EleFitsData/FitsError.h"
+  #include "EleFitsData/VlaColumn.h"
+
+  #include <algorithm>
+
+namespace Euclid {
+namespace Fits {
+
+template <typename T>
+VlaColumn<T>::VlaColumn() : VlaColumn(ColumnInfo<Value> { "", "", 1 }) {}
+
+template <typename T>
+VlaColumn<T>::VlaColumn(ColumnInfo<Value> info) : m_info(std::move(info)), m_offsets(1, 0), m_values() {}
+
+template <typename T>
+VlaColumn<T>::VlaColumn(ColumnInfo<Value> info, std::vector<long> offsets, std::vector<Value> values) :
+    m_info(std::move(info)), m_offsets(std::move(offsets)), m_values(std::move(values)) {
+  if (m_offsets.empty() || m_offsets.front() != 0 || m_offsets.back() != static_cast<long>(m_values.size()) ||
+      not std::is_sorted(m_offsets.begin(), m_offsets.end())) {
+    throw FitsError("Invalid offsets of variable-length array column: " + m_info.name);
+  }
+}
+
+template <typename T>
+VlaColumn<T>::VlaColumn(ColumnInfo<Value> info, const std::vector<std::vector<Value>>& entries) :
+    VlaColumn(std::move(info)) {
+  long elementCount = 0;
+  for (const auto& e : entries) {
+    elementCount += e.size();
+  }
+  reserve(entries.size(), elementCount);
+  for (const auto& e : entries) {
+    append(e);
+  }
+}
+
+template <typename T>
+const ColumnInfo<typename VlaColumn<T>::Value>& VlaColumn<T>::info() const {
+  return m_info;
+}
+
+template <typename T>
+void VlaColumn<T>::rename(const std::string& name) {
+  m_info.name = name;
+}
+
+template <typename T>
+long VlaColumn<T>::rowCount() const {
+  return m_offsets.size() - 1;
+}
+
+template <typename T>
+long VlaColumn<T>::elementCount() const {
+  return m_values.size();
+}
+
+template <typename T>
+long VlaColumn<T>::entrySize(long row) const {
+  return m_offsets[row + 1] - m_offsets[row];
+}
+
+template <typename T>
+long VlaColumn<T>::maxEntrySize() const {
+  long size = 0;
+  for (long row = 0; row < rowCount(); ++row) {
+    size = std::max(size, entrySize(row));
+  }
+  return size;
+}
+
+template <typename T>
+const typename VlaColumn<T>::Value* VlaColumn<T>::entry(long row) const {
+  return m_values.data() + m_offsets[row];
+}
+
+template <typename T>
+typename VlaColumn<T>::Value* VlaColumn<T>::entry(long row) {
+  return m_values.data() + m_offsets[row];
+}
+
+template <typename T>
+const typename VlaColumn<T>::Value& VlaColumn<T>::operator()(long row, long index) const {
+  return m_values[m_offsets[row] + index];
+}
+
+template <typename T>
+typename VlaColumn<T>::Value& VlaColumn<T>::operator()(long row, long index) {
+  return const_cast<Value&>(const_cast<const VlaColumn&>(*this)(row, index));
+}
+
+template <typename T>
+const typename VlaColumn<T>::Value& VlaColumn<T>::at(long row, long index) const {
+  const long rows = rowCount();
+  OutOfBoundsError::mayThrow("Cannot access row", row, { -rows, rows - 1 });
+  const long boundedRow = row < 0 ? row + rows : row;
+  const long size = entrySize(boundedRow);
+  OutOfBoundsError::mayThrow("Cannot access entry index", index, { -size, size - 1 });
+  return operator()(boundedRow, index < 0 ? index + size : index);
+}
+
+template <typename T>
+typename VlaColumn<T>::Value& VlaColumn<T>::at(long row, long index) {
+  return const_cast<Value&>(const_cast<const VlaColumn&>(*this).at(row, index));
+}
+
+template <typename T>
+typename VlaColumn<T>::Value* VlaColumn<T>::append(long size) {
+  const long offset = m_values.size();
+  m_values.resize(offset + size);
+  m_offsets.push_back(offset + size);
+  return m_values.data() + offset;
+}
+
+template <typename T>
+void VlaColumn<T>::append(const std::vector<Value>& entry) {
+  std::copy(entry.begin(), entry.end(), append(entry.size()));
+}
+
+template <typename T>
+void VlaColumn<T>::reserve(long rowCount, long elementCount) {
+  m_offsets.reserve(rowCount + 1);
+  m_values.reserve(elementCount);
+}
+
+template <typename T>
+const std::vector<long>& VlaColumn<T>::offsets() const {
+  return m_offsets;
+}
+
+template <typename T>
+const typename VlaColumn<T>::Value* VlaColumn<T>::data() const {
+  return m_values.data();
+}
+
+template <typename T>
+typename VlaColumn<T>::Value* VlaColumn<T>::data() {
+  return m_values.data();
+}
+
+template <typename T>
+std::vector<std::vector<typename VlaColumn<T>::Value>> VlaColumn<T>::entries() const {
+  std::vector<std::vector<Value>> res(rowCount());
+  for (long row = 0; row < rowCount(); ++row) {
+    res[row].assign(entry(row), entry(row) + entrySize(row));
+  }
+  return res;
+}
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
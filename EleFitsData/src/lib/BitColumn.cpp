@@ -0,0 +1,192 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+#include "EleFitsData/BitColumn.h"
+
+#include "EleFitsData/FitsError.h"
+
+#include <algorithm>
+#include <bitset>
+#include <string>
+
+namespace Euclid {
+namespace Fits {
+
+namespace {
+
+constexpr long wordBits = 64;
+
+/**
+ * @brief Get the number of rows of a column with given repeat count and number of values.
+ */
+long rowCountOf(const ColumnInfo<bool>& info, std::size_t valueCount) {
+  const auto size = static_cast<long>(valueCount);
+  if (info.repeatCount <= 0 || size % info.repeatCount != 0) {
+    throw FitsError(
+        "Cannot create bit column " + info.name + ": " + std::to_string(size) +
+        " values is not a multiple of the repeat count " + std::to_string(info.repeatCount));
+  }
+  return size / info.repeatCount;
+}
+
+} // namespace
+
+BitColumn::BitColumn() : BitColumn({ "", "", 1 }, 0) {}
+
+BitColumn::BitColumn(ColumnInfo<bool> info, long rowCount) :
+    m_info(std::move(info)), m_rowCount(rowCount),
+    m_words((rowCount * m_info.repeatCount + wordBits - 1) / wordBits, 0) {}
+
+BitColumn::BitColumn(ColumnInfo<bool> info, const std::vector<bool>& values) :
+    BitColumn(info, rowCountOf(info, values.size())) {
+  for (long i = 0; i < elementCount(); ++i) {
+    if (values[i]) {
+      bytes()[i / 8] |= 0x80 >> (i % 8);
+    }
+  }
+}
+
+const ColumnInfo<bool>& BitColumn::info() const {
+  return m_info;
+}
+
+void BitColumn::rename(const std::string& name) {
+  m_info.name = name;
+}
+
+long BitColumn::rowCount() const {
+  return m_rowCount;
+}
+
+long BitColumn::elementCount() const {
+  return m_rowCount * m_info.repeatCount;
+}
+
+bool BitColumn::operator()(long row, long repeat) const {
+  const long i = row * m_info.repeatCount + repeat;
+  return bytes()[i / 8] & (0x80 >> (i % 8));
+}
+
+bool BitColumn::at(long row, long repeat) const {
+  OutOfBoundsError::mayThrow("Cannot access row", row, { -m_rowCount, m_rowCount - 1 });
+  OutOfBoundsError::mayThrow("Cannot access repeat index", repeat, { -m_info.repeatCount, m_info.repeatCount - 1 });
+  return operator()(row < 0 ? row + m_rowCount : row, repeat < 0 ? repeat + m_info.repeatCount : repeat);
+}
+
+void BitColumn::assign(long row, long repeat, bool value) {
+  const long i = row * m_info.repeatCount + repeat;
+  const unsigned char mask = 0x80 >> (i % 8);
+  if (value) {
+    bytes()[i / 8] |= mask;
+  } else {
+    bytes()[i / 8] &= ~mask;
+  }
+}
+
+long BitColumn::count() const {
+  long res = 0;
+  for (auto w : m_words) {
+    res += std::bitset<wordBits>(w).count();
+  }
+  return res;
+}
+
+bool BitColumn::any() const {
+  return std::any_of(m_words.begin(), m_words.end(), [](Word w) {
+    return w != 0;
+  });
+}
+
+BitColumn& BitColumn::flip() {
+  for (auto& w : m_words) {
+    w = ~w;
+  }
+  clearPadding();
+  return *this;
+}
+
+BitColumn& BitColumn::operator&=(const BitColumn& rhs) {
+  mayThrowShapeError(rhs);
+  std::transform(m_words.begin(), m_words.end(), rhs.m_words.begin(), m_words.begin(), [](Word l, Word r) {
+    return l & r;
+  });
+  return *this;
+}
+
+BitColumn& BitColumn::operator|=(const BitColumn& rhs) {
+  mayThrowShapeError(rhs);
+  std::transform(m_words.begin(), m_words.end(), rhs.m_words.begin(), m_words.begin(), [](Word l, Word r) {
+    return l | r;
+  });
+  return *this;
+}
+
+BitColumn& BitColumn::operator^=(const BitColumn& rhs) {
+  mayThrowShapeError(rhs);
+  std::transform(m_words.begin(), m_words.end(), rhs.m_words.begin(), m_words.begin(), [](Word l, Word r) {
+    return l ^ r;
+  });
+  return *this;
+}
+
+long BitColumn::wordCount() const {
+  return m_words.size();
+}
+
+const BitColumn::Word* BitColumn::words() const {
+  return m_words.data();
+}
+
+BitColumn::Word* BitColumn::words() {
+  return m_words.data();
+}
+
+const unsigned char* BitColumn::bytes() const {
+  return reinterpret_cast<const unsigned char*>(m_words.data());
+}
+
+unsigned char* BitColumn::bytes() {
+  return reinterpret_cast<unsigned char*>(m_words.data());
+}
+
+std::vector<bool> BitColumn::values() const {
+  std::vector<bool> res(elementCount());
+  for (long i = 0; i < elementCount(); ++i) {
+    res[i] = bytes()[i / 8] & (0x80 >> (i % 8));
+  }
+  return res;
+}
+
+void BitColumn::mayThrowShapeError(const BitColumn& rhs) const {
+  if (rhs.m_rowCount != m_rowCount || rhs.m_info.repeatCount != m_info.repeatCount) {
+    throw FitsError("Bit column shapes differ: " + m_info.name + " and " + rhs.m_info.name);
+  }
+}
+
+void BitColumn::clearPadding() {
+  const long size = elementCount();
+  const long byteCount = (size + 7) / 8;
+  auto* data = bytes();
+  if (size % 8 != 0) {
+    data[byteCount - 1] &= static_cast<unsigned char>(0xFF << (8 - size % 8));
+  }
+  std::fill(data + byteCount, data + m_words.size() * sizeof(Word), 0);
+}
+
+} // namespace Fits
+} // namespace Euclid
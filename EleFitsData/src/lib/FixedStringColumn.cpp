@@ -0,0 +1,108 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsData/FixedStringColumn.h"
+
+#include "EleFitsData/FitsError.h"
+
+#include <algorithm>
+
+namespace Euclid {
+namespace Fits {
+
+FixedStringColumn::FixedStringColumn() : m_info { "", "", 1 }, m_rowCount(0), m_arena() {}
+
+FixedStringColumn::FixedStringColumn(ColumnInfo<std::string> info, long rowCount) :
+    m_info(std::move(info)), m_rowCount(rowCount), m_arena(rowCount * (m_info.repeatCount + 1), '\0') {}
+
+FixedStringColumn::FixedStringColumn(ColumnInfo<std::string> info, const std::vector<std::string>& values) :
+    FixedStringColumn(std::move(info), values.size()) {
+  for (long row = 0; row < m_rowCount; ++row) {
+    assign(row, values[row]);
+  }
+}
+
+const ColumnInfo<std::string>& FixedStringColumn::info() const {
+  return m_info;
+}
+
+void FixedStringColumn::rename(const std::string& name) {
+  m_info.name = name;
+}
+
+long FixedStringColumn::rowCount() const {
+  return m_rowCount;
+}
+
+long FixedStringColumn::elementCount() const {
+  return m_rowCount;
+}
+
+long FixedStringColumn::stride() const {
+  return m_info.repeatCount + 1;
+}
+
+boost::string_view FixedStringColumn::operator()(long row) const {
+  const auto* begin = cell(row);
+  return { begin, static_cast<std::size_t>(std::find(begin, begin + m_info.repeatCount, '\0') - begin) };
+}
+
+boost::string_view FixedStringColumn::at(long row) const {
+  OutOfBoundsError::mayThrow("Cannot access row", row, { -m_rowCount, m_rowCount - 1 });
+  return operator()(row < 0 ? row + m_rowCount : row);
+}
+
+void FixedStringColumn::assign(long row, boost::string_view value) {
+  const long size = value.size();
+  if (size > m_info.repeatCount) {
+    throw FitsError(
+        "Cannot assign string of length " + std::to_string(size) + " to column " + m_info.name + " of width " +
+        std::to_string(m_info.repeatCount));
+  }
+  auto* begin = cell(row);
+  std::copy(value.begin(), value.end(), begin);
+  std::fill(begin + size, begin + stride(), '\0');
+}
+
+const char* FixedStringColumn::cell(long row) const {
+  return m_arena.data() + row * stride();
+}
+
+char* FixedStringColumn::cell(long row) {
+  return m_arena.data() + row * stride();
+}
+
+const char* FixedStringColumn::data() const {
+  return m_arena.data();
+}
+
+char* FixedStringColumn::data() {
+  return m_arena.data();
+}
+
+std::vector<std::string> FixedStringColumn::strings() const {
+  std::vector<std::string> res(m_rowCount);
+  for (long row = 0; row < m_rowCount; ++row) {
+    res[row] = operator()(row).to_string();
+  }
+  return res;
+}
+
+} // namespace Fits
+} // namespace Euclid
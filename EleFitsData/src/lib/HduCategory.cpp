@@ -126,12 +126,18 @@ const HduCategory HduCategory::RawImage {
 const HduCategory HduCategory::Ext { HduCategory::TritPosition::PrimaryExt, HduCategory::Trit::Second };
 const HduCategory HduCategory::Data { ~HduCategory::Metadata };
 const HduCategory HduCategory::Bintable { HduCategory::Ext & ~HduCategory::Image };
+const HduCategory HduCategory::RawBintable {
+  HduCategory::Bintable & HduCategory { HduCategory::TritPosition::RawCompressedBintable, HduCategory::Trit::First }
+};
 const HduCategory HduCategory::FloatImage {
   HduCategory::Image & HduCategory { HduCategory::TritPosition::IntFloatImage, HduCategory::Trit::Second }
 };
 const HduCategory HduCategory::CompressedImageExt {
   HduCategory::Image & HduCategory { HduCategory::TritPosition::RawCompressedImage, HduCategory::Trit::Second }
 };
+const HduCategory HduCategory::CompressedBintable {
+  HduCategory::Bintable & HduCategory { HduCategory::TritPosition::RawCompressedBintable, HduCategory::Trit::Second }
+};
 
 const HduCategory HduCategory::MetadataPrimary { HduCategory::Metadata & HduCategory::Primary };
 const HduCategory HduCategory::DataPrimary { HduCategory::Data & HduCategory::Primary };
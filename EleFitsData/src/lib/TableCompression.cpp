@@ -0,0 +1,39 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsData/TableCompression.h"
+
+namespace Euclid {
+namespace Fits {
+
+TableCompression::TableCompression(long rowCount, Algorithm algo) :
+    tileRowCount(rowCount), defaultAlgorithm(algo), columnAlgorithms() {}
+
+TableCompression& TableCompression::assign(const std::string& name, Algorithm algo) {
+  columnAlgorithms[name] = algo;
+  return *this;
+}
+
+TableCompression::Algorithm TableCompression::algorithm(const std::string& name) const {
+  const auto it = columnAlgorithms.find(name);
+  return it == columnAlgorithms.end() ? defaultAlgorithm : it->second;
+}
+
+} // namespace Fits
+} // namespace Euclid
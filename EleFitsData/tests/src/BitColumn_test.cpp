@@ -0,0 +1,80 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+#include "EleFitsData/BitColumn.h"
+#include "EleFitsData/FitsError.h"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(BitColumn_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(packed_layout_test) {
+  const std::vector<bool> values { true, false, true, true, false, false, false, true, false, true };
+  BitColumn column({ "FLAGS", "", 5 }, values);
+  BOOST_TEST(column.rowCount() == 2);
+  BOOST_TEST(column.elementCount() == 10);
+  BOOST_TEST(column.wordCount() == 1);
+  BOOST_TEST(column.bytes()[0] == 0xB1); // 10110001
+  BOOST_TEST(column.bytes()[1] == 0x40); // 01 + padding
+  BOOST_TEST(column(1, 4));
+  BOOST_TEST(not column.at(-1, -2));
+  BOOST_TEST(column.values() == values);
+  column.assign(1, 3, true);
+  BOOST_TEST(column(1, 3));
+  column.assign(0, 0, false);
+  BOOST_TEST(not column(0, 0));
+  BOOST_CHECK_THROW(column.at(2), OutOfBoundsError);
+  BOOST_CHECK_THROW(column.at(0, 5), OutOfBoundsError);
+  BOOST_CHECK_THROW(BitColumn({ "FLAGS", "", 3 }, values), FitsError); // 10 values in rows of 3
+}
+
+BOOST_AUTO_TEST_CASE(word_operations_test) {
+  const long rowCount = 100;
+  BitColumn even({ "EVEN", "", 1 }, rowCount);
+  BitColumn third({ "THIRD", "", 1 }, rowCount);
+  for (long row = 0; row < rowCount; ++row) {
+    even.assign(row, 0, row % 2 == 0);
+    third.assign(row, 0, row % 3 == 0);
+  }
+  BOOST_TEST(even.count() == 50);
+  BOOST_TEST(third.count() == 34);
+  auto both = even;
+  both &= third;
+  BOOST_TEST(both.count() == 17);
+  auto either = even;
+  either |= third;
+  BOOST_TEST(either.count() == 67);
+  auto exclusive = even;
+  exclusive ^= third;
+  BOOST_TEST(exclusive.count() == 50);
+  even.flip();
+  BOOST_TEST(even.count() == 50); // Padding is not flipped
+  BOOST_TEST(even.any());
+  BOOST_TEST(not BitColumn({ "NONE", "", 1 }, rowCount).any());
+  BOOST_CHECK_THROW(even &= BitColumn({ "SHORT", "", 1 }, 10), FitsError);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
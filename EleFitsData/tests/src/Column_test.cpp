@@ -97,6 +97,27 @@ BOOST_AUTO_TEST_CASE(string_column_elementcount_is_rowcount_test) {
   BOOST_TEST(cPtrColumn.elementCount() == rowCount);
 }
 
+BOOST_AUTO_TEST_CASE(entry_is_a_raster_view_test) {
+  constexpr long rowCount = 3;
+  VecColumn<int> column({ "CUTOUT", "", 6, { 3, 2 } }, rowCount);
+  for (long i = 0; i < column.elementCount(); ++i) {
+    column.data()[i] = i;
+  }
+  for (long row = 0; row < rowCount; ++row) {
+    auto entry = column.entry<2>(row);
+    BOOST_TEST(entry.data() == &column(row));
+    BOOST_TEST((entry.shape() == Position<2> { 3, 2 }));
+    BOOST_TEST((entry[{ 2, 1 }] == row * 6 + 5));
+  }
+  const auto& cColumn = column;
+  BOOST_TEST(cColumn.entry<-1>(1).dimension() == 2);
+  BOOST_CHECK_THROW(column.entry<3>(0), FitsError);
+  column.reshape(2); // Flat cells
+  BOOST_TEST(column.info().shape.size() == 0);
+  BOOST_TEST(column.entry(1).shape()[0] == 2);
+  BOOST_CHECK_THROW(column.entry<2>(0), FitsError);
+}
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE_END()
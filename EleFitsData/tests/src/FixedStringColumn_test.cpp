@@ -0,0 +1,62 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsData/FitsError.h"
+#include "EleFitsData/FixedStringColumn.h"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(FixedStringColumn_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(arena_layout_test) {
+  const std::vector<std::string> values { "", "A", "ABCD", "XY" };
+  FixedStringColumn column({ "STR", "", 4 }, values);
+  BOOST_TEST(column.rowCount() == 4);
+  BOOST_TEST(column.elementCount() == 4);
+  BOOST_TEST(column.stride() == 5);
+  for (long row = 0; row < column.rowCount(); ++row) {
+    BOOST_TEST(column(row) == values[row]);
+    BOOST_TEST(column.cell(row) == column.data() + row * column.stride());
+    BOOST_TEST(column.cell(row)[values[row].size()] == '\0');
+  }
+  BOOST_TEST(column.strings() == values);
+}
+
+BOOST_AUTO_TEST_CASE(assign_and_bounds_test) {
+  FixedStringColumn column({ "STR", "", 3 }, 2);
+  BOOST_TEST(column(0).empty());
+  column.assign(1, "ABC");
+  BOOST_TEST(column.at(-1) == "ABC");
+  column.assign(1, "Z");
+  BOOST_TEST(column.at(1) == "Z");
+  BOOST_TEST(column.cell(1)[1] == '\0');
+  BOOST_CHECK_THROW(column.assign(0, "ABCD"), FitsError);
+  BOOST_CHECK_THROW(column.at(2), OutOfBoundsError);
+  BOOST_CHECK_THROW(column.at(-3), OutOfBoundsError);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
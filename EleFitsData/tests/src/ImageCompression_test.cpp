@@ -0,0 +1,48 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsData/ImageCompression.h"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(ImageCompression_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(quantization_test) {
+  ImageCompression compression(ImageCompression::Algorithm::Hcompress, { 256, 128 });
+  BOOST_TEST((compression.tileShape == Position<-1> { 256, 128 }));
+  BOOST_TEST(compression.quantization == 4);
+  BOOST_TEST((compression.dithering == ImageCompression::Dithering::EveryPixel));
+  BOOST_TEST(not compression.isLossless());
+  compression.quantize(16, ImageCompression::Dithering::NonZeroPixel);
+  BOOST_TEST(compression.quantization == 16);
+  BOOST_TEST((compression.dithering == ImageCompression::Dithering::NonZeroPixel));
+  compression.quantize(0);
+  BOOST_TEST(compression.isLossless());
+  BOOST_TEST((compression.dithering == ImageCompression::Dithering::EveryPixel));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
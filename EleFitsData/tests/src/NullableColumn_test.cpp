@@ -0,0 +1,85 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+#include "EleFitsData/FitsError.h"
+#include "EleFitsData/NullableColumn.h"
+
+#include <boost/test/unit_test.hpp>
+#include <limits>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(NullableColumn_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(sentinel_validity_test) {
+  const long rowCount = 70; // More than a word
+  std::vector<short> values(rowCount * 2);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = i % 3 == 0 ? -1 : static_cast<short>(i);
+  }
+  NullableColumn<short> column(VecColumn<short>({ "SHORT", "", 2 }, values));
+  BOOST_TEST(column.nullCount() == 0);
+  column.updateValidity(-1);
+  BOOST_TEST(column.nullCount() == rowCount * 2 / 3 + 1);
+  BOOST_TEST(not column.isValid(0, 0));
+  BOOST_TEST(column.isValid(0, 1));
+  BOOST_TEST(column.validity().bytes()[17] == 0xD0); // Elements 136-139: 1101 and padding
+  long sum = 0;
+  column.foreachValid([&](long row, long repeat, short value) {
+    BOOST_TEST(value == row * 2 + repeat);
+    sum += value;
+  });
+  const auto filled = column.fill(0);
+  long expected = 0;
+  for (auto v : filled.vector()) {
+    expected += v;
+  }
+  BOOST_TEST(sum == expected);
+}
+
+BOOST_AUTO_TEST_CASE(nan_validity_test) {
+  const auto nan = std::numeric_limits<float>::quiet_NaN();
+  NullableColumn<float> column({ "FLOAT", "", 1 }, 10);
+  BOOST_TEST(column.nullCount() == 10);
+  for (long row = 0; row < 10; ++row) {
+    column.assign(row, 0, row % 4 == 0 ? nan : row);
+  }
+  BOOST_TEST(column.nullCount() == 0); // Assigned values are valid
+  column.updateValidity();
+  BOOST_TEST(column.nullCount() == 3);
+  column.nullify(1);
+  BOOST_TEST(not column.isValid(1));
+  const auto filled = column.fill(-1);
+  BOOST_TEST(filled(0) == -1);
+  BOOST_TEST(filled(1) == -1);
+  BOOST_TEST(filled(2) == 2);
+}
+
+BOOST_AUTO_TEST_CASE(shape_mismatch_test) {
+  VecColumn<int> values({ "INT", "", 1 }, 10);
+  BOOST_CHECK_THROW(NullableColumn<int>(values, BitColumn({ "INT", "", 1 }, 9)), FitsError);
+  BOOST_CHECK_NO_THROW(NullableColumn<int>(values, BitColumn({ "INT", "", 1 }, 10)));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
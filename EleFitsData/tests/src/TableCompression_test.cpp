@@ -0,0 +1,45 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsData/TableCompression.h"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(TableCompression_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(column_algorithm_test) {
+  TableCompression compression(1000, TableCompression::Algorithm::Gzip);
+  BOOST_TEST(compression.tileRowCount == 1000);
+  compression.assign("COUNT", TableCompression::Algorithm::Rice).assign("FLUX", TableCompression::Algorithm::Gzip);
+  BOOST_TEST((compression.algorithm("COUNT") == TableCompression::Algorithm::Rice));
+  BOOST_TEST((compression.algorithm("FLUX") == TableCompression::Algorithm::Gzip));
+  BOOST_TEST((compression.algorithm("OTHER") == compression.defaultAlgorithm));
+  compression.defaultAlgorithm = TableCompression::Algorithm::ShuffledGzip;
+  BOOST_TEST((compression.algorithm("OTHER") == TableCompression::Algorithm::ShuffledGzip));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
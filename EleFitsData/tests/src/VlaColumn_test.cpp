@@ -0,0 +1,66 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+#include "EleFitsData/FitsError.h"
+#include "EleFitsData/VlaColumn.h"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(VlaColumn_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(flat_layout_test) {
+  const std::vector<std::vector<float>> entries { { 1, 2, 3 }, {}, { 4 }, { 5, 6 } };
+  VlaColumn<float> column({ "SPEC", "Jy", 1 }, entries);
+  BOOST_TEST(column.rowCount() == 4);
+  BOOST_TEST(column.elementCount() == 6);
+  BOOST_TEST(column.maxEntrySize() == 3);
+  BOOST_TEST((column.offsets() == std::vector<long> { 0, 3, 3, 4, 6 }));
+  for (long row = 0; row < column.rowCount(); ++row) {
+    BOOST_TEST(column.entrySize(row) == static_cast<long>(entries[row].size()));
+    BOOST_TEST(column.entry(row) == column.data() + column.offsets()[row]);
+  }
+  BOOST_TEST(column(3, 1) == 6);
+  BOOST_TEST(column.at(-1, -2) == 5);
+  BOOST_TEST(column.entries() == entries);
+}
+
+BOOST_AUTO_TEST_CASE(append_and_bounds_test) {
+  VlaColumn<int> column({ "PSF", "", 1 });
+  BOOST_TEST(column.rowCount() == 0);
+  column.append({ 1, 2 });
+  auto* entry = column.append(3);
+  entry[0] = 3;
+  entry[2] = 5;
+  BOOST_TEST(column.rowCount() == 2);
+  BOOST_TEST(column.at(1, 2) == 5);
+  column.at(1, 1) = 4;
+  BOOST_TEST(column(1, 1) == 4);
+  BOOST_CHECK_THROW(column.at(2), OutOfBoundsError);
+  BOOST_CHECK_THROW(column.at(0, 2), OutOfBoundsError);
+  BOOST_CHECK_THROW(VlaColumn<int>({ "BAD", "", 1 }, { 0, 2, 1 }, { 1, 2 }), FitsError);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
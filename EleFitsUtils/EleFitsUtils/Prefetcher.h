@@ -0,0 +1,209 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITSUTILS_PREFETCHER_H
+#define _ELEFITSUTILS_PREFETCHER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @brief Metrics of a `Prefetcher`.
+ */
+struct PrefetchMetrics {
+
+  /**
+   * @brief The number of batches which were consumed.
+   */
+  long batchCount = 0;
+
+  /**
+   * @brief The number of times the consumer had to wait for a batch.
+   */
+  long stallCount = 0;
+
+  /**
+   * @brief The total time the consumer waited for batches.
+   */
+  std::chrono::nanoseconds stallTime = std::chrono::nanoseconds::zero();
+
+  /**
+   * @brief The total time the background thread waited for a free slot, i.e. was ahead of the consumer.
+   */
+  std::chrono::nanoseconds idleTime = std::chrono::nanoseconds::zero();
+};
+
+/**
+ * @brief Read-ahead of a sequence of batches by a background thread.
+ * @tparam TBatch The batch type, e.g. a tuple of columns or a raster
+ * @details
+ * The background thread fills a queue of `queueDepth` slots (e.g. 2 for double buffering)
+ * while the consumer processes the batches in order with `next()`.
+ * A slot is released when the next batch is requested.
+ * 
+ * If the queue depth is 0, batches are read synchronously by `next()`.
+ * 
+ * Stalls of the consumer are recorded in `metrics()`:
+ * high stall times denote an I/O-bound process, where a larger queue would not help,
+ * while high idle times denote a CPU-bound process.
+ * 
+ * @warning
+ * The reader function is called from the background thread,
+ * and must therefore not share state (e.g. a `fitsfile*`) with the consumer.
+ */
+template <typename TBatch>
+class Prefetcher {
+
+public:
+  /**
+   * @brief The function which fills a slot with the batch of given index.
+   */
+  using Reader = std::function<void(long, TBatch&)>;
+
+  /**
+   * @brief Start prefetching.
+   * @param batchCount The number of batches
+   * @param queueDepth The number of slots, or 0 to read synchronously
+   * @param prototype The initial value of the slots
+   * @param reader The function which fills the slots
+   */
+  Prefetcher(long batchCount, long queueDepth, const TBatch& prototype, Reader reader);
+
+  /**
+   * @brief Move constructor.
+   */
+  Prefetcher(Prefetcher&&) = default;
+
+  /**
+   * @brief Non-assignable.
+   */
+  Prefetcher& operator=(Prefetcher&&) = delete;
+
+  /**
+   * @brief Destructor, which stops and joins the background thread.
+   */
+  ~Prefetcher();
+
+  /**
+   * @brief Get the number of batches.
+   */
+  long batchCount() const;
+
+  /**
+   * @brief Get the queue depth.
+   */
+  long queueDepth() const;
+
+  /**
+   * @brief Release the previous batch, and get the next one, which is waited for if needed.
+   * @details
+   * The batch is valid until the next call.
+   * Throws `std::out_of_range` if all the batches were consumed,
+   * and rethrows exceptions of the reader.
+   */
+  TBatch& next();
+
+  /**
+   * @brief Get the metrics.
+   */
+  PrefetchMetrics metrics() const;
+
+private:
+  /**
+   * @brief The state shared with the background thread.
+   */
+  struct State {
+
+    /**
+     * @brief Constructor.
+     */
+    State(long count, long depth, const TBatch& prototype, Reader function);
+
+    /** @brief The number of batches. */
+    long batchCount;
+
+    /** @brief The queue depth. */
+    long queueDepth;
+
+    /** @brief The slots. */
+    std::vector<TBatch> slots;
+
+    /** @brief The reader. */
+    Reader reader;
+
+    /** @brief The number of filled batches. */
+    long producedCount;
+
+    /** @brief The number of released batches. */
+    long releasedCount;
+
+    /** @brief The index of the current batch. */
+    long current;
+
+    /** @brief Whether the background thread should stop. */
+    bool stop;
+
+    /** @brief The exception thrown by the reader, if any. */
+    std::exception_ptr error;
+
+    /** @brief The metrics. */
+    PrefetchMetrics metrics;
+
+    /** @brief The mutex which protects the state. */
+    mutable std::mutex mutex;
+
+    /** @brief The condition variable to wake up the consumer and background thread. */
+    std::condition_variable condition;
+  };
+
+  /**
+   * @brief The loop of the background thread.
+   */
+  static void produce(State& state);
+
+  /**
+   * @brief The shared state.
+   */
+  std::unique_ptr<State> m_state;
+
+  /**
+   * @brief The background thread.
+   */
+  std::thread m_thread;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+/// @cond INTERNAL
+#define _ELEFITSUTILS_PREFETCHER_IMPL
+#include "EleFitsUtils/impl/Prefetcher.hpp"
+#undef _ELEFITSUTILS_PREFETCHER_IMPL
+/// @endcond
+
+#endif
@@ -0,0 +1,132 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#ifndef _ELEFITSUTILS_THREADPOOL_H
+#define _ELEFITSUTILS_THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Euclid {
+namespace Fits {
+
+/**
+ * @brief A fixed-size pool of worker threads to run batches of independent tasks.
+ * @details
+ * Tasks are submitted by batches with `run()`, which blocks until all the tasks of the batch are completed.
+ * The calling thread processes tasks, too, while waiting,
+ * such that a pool without worker threads simply runs the tasks sequentially.
+ * 
+ * Example usage:
+ * \code
+ * std::vector<std::function<void(void)>> tasks;
+ * for (auto& c : columns) {
+ *   tasks.push_back([&]() {
+ *     encode(c);
+ *   });
+ * }
+ * ThreadPool::instance().run(tasks);
+ * \endcode
+ */
+class ThreadPool {
+
+public:
+  /**
+   * @brief Create a pool with a given number of worker threads.
+   */
+  explicit ThreadPool(long threadCount);
+
+  /**
+   * @brief Destructor, which stops and joins the worker threads.
+   */
+  ~ThreadPool();
+
+  /**
+   * @brief Non-copyable.
+   */
+  ThreadPool(const ThreadPool&) = delete;
+
+  /**
+   * @brief Non-copyable.
+   */
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /**
+   * @brief Get the process-wide pool, with one worker thread less than the hardware concurrency.
+   */
+  static ThreadPool& instance();
+
+  /**
+   * @brief Get the number of worker threads.
+   */
+  long threadCount() const;
+
+  /**
+   * @brief Run a batch of tasks and wait for their completion.
+   * @details
+   * If some tasks throw, the first exception is rethrown once all the tasks are completed.
+   */
+  void run(const std::vector<std::function<void(void)>>& tasks);
+
+private:
+  /**
+   * @brief The loop of the worker threads.
+   */
+  void work();
+
+  /**
+   * @brief Pop and run a task if any.
+   * @return True if a task was run.
+   */
+  bool runNext();
+
+  /**
+   * @brief The worker threads.
+   */
+  std::vector<std::thread> m_threads;
+
+  /**
+   * @brief The pending tasks.
+   */
+  std::deque<std::function<void(void)>> m_queue;
+
+  /**
+   * @brief The mutex which protects the queue.
+   */
+  std::mutex m_mutex;
+
+  /**
+   * @brief The condition variable to wake up the workers.
+   */
+  std::condition_variable m_condition;
+
+  /**
+   * @brief Whether the workers should stop.
+   */
+  bool m_stop;
+};
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
@@ -0,0 +1,157 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#if defined(_ELEFITSUTILS_PREFETCHER_IMPL) || defined(CHECK_QUALITY)
+
+  #include "EleFitsUtils/Prefetcher.h"
+
+  #include <algorithm>
+  #include <stdexcept>
+
+namespace Euclid {
+namespace Fits {
+
+template <typename TBatch>
+Prefetcher<TBatch>::State::State(long count, long depth, const TBatch& prototype, Reader function) :
+    batchCount(count), queueDepth(std::max(0L, depth)), slots(std::max(1L, depth), prototype),
+    reader(std::move(function)), producedCount(0), releasedCount(0), current(-1), stop(false), error(), metrics(),
+    mutex(), condition() {}
+
+template <typename TBatch>
+Prefetcher<TBatch>::Prefetcher(long batchCount, long queueDepth, const TBatch& prototype, Reader reader) :
+    m_state(new State(batchCount, queueDepth, prototype, std::move(reader))), m_thread() {
+  if (m_state->queueDepth > 0 && batchCount > 0) {
+    auto& state = *m_state;
+    m_thread = std::thread([&state]() {
+      produce(state);
+    });
+  }
+}
+
+template <typename TBatch>
+Prefetcher<TBatch>::~Prefetcher() {
+  if (not m_state) { // Moved
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    m_state->stop = true;
+  }
+  m_state->condition.notify_all();
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+}
+
+template <typename TBatch>
+long Prefetcher<TBatch>::batchCount() const {
+  return m_state->batchCount;
+}
+
+template <typename TBatch>
+long Prefetcher<TBatch>::queueDepth() const {
+  return m_state->queueDepth;
+}
+
+template <typename TBatch>
+TBatch& Prefetcher<TBatch>::next() {
+  using Clock = std::chrono::steady_clock;
+  auto& state = *m_state;
+  if (state.current + 1 >= state.batchCount) {
+    throw std::out_of_range("No more batches to prefetch.");
+  }
+
+  /* Synchronous case */
+  if (state.queueDepth == 0) {
+    ++state.current;
+    const auto start = Clock::now();
+    state.reader(state.current, state.slots[0]);
+    ++state.metrics.stallCount;
+    state.metrics.stallTime += Clock::now() - start;
+    ++state.metrics.batchCount;
+    return state.slots[0];
+  }
+
+  /* Release the previous slot and wait for the next batch */
+  std::unique_lock<std::mutex> lock(state.mutex);
+  state.releasedCount = state.current + 1;
+  ++state.current;
+  state.condition.notify_all();
+  if (state.producedCount <= state.current && not state.error) {
+    const auto start = Clock::now();
+    state.condition.wait(lock, [&]() {
+      return state.producedCount > state.current || state.error;
+    });
+    ++state.metrics.stallCount;
+    state.metrics.stallTime += Clock::now() - start;
+  }
+  if (state.producedCount <= state.current) {
+    std::rethrow_exception(state.error);
+  }
+  ++state.metrics.batchCount;
+  return state.slots[state.current % state.queueDepth];
+}
+
+template <typename TBatch>
+PrefetchMetrics Prefetcher<TBatch>::metrics() const {
+  std::lock_guard<std::mutex> lock(m_state->mutex);
+  return m_state->metrics;
+}
+
+template <typename TBatch>
+void Prefetcher<TBatch>::produce(State& state) {
+  using Clock = std::chrono::steady_clock;
+  for (long i = 0; i < state.batchCount; ++i) {
+
+    /* Wait for a free slot */
+    {
+      std::unique_lock<std::mutex> lock(state.mutex);
+      const auto start = Clock::now();
+      state.condition.wait(lock, [&]() {
+        return state.stop || i - state.releasedCount < state.queueDepth;
+      });
+      state.metrics.idleTime += Clock::now() - start;
+      if (state.stop) {
+        return;
+      }
+    }
+
+    /* Fill it */
+    try {
+      state.reader(i, state.slots[i % state.queueDepth]);
+    } catch (...) {
+      {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.error = std::current_exception();
+      }
+      state.condition.notify_all();
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(state.mutex);
+      state.producedCount = i + 1;
+    }
+    state.condition.notify_all();
+  }
+}
+
+} // namespace Fits
+} // namespace Euclid
+
+#endif
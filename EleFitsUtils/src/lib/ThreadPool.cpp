@@ -0,0 +1,139 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsUtils/ThreadPool.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace Euclid {
+namespace Fits {
+
+ThreadPool::ThreadPool(long threadCount) : m_threads(), m_queue(), m_mutex(), m_condition(), m_stop(false) {
+  for (long i = 0; i < threadCount; ++i) {
+    m_threads.emplace_back([this]() {
+      work();
+    });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_condition.notify_all();
+  for (auto& t : m_threads) {
+    t.join();
+  }
+}
+
+ThreadPool& ThreadPool::instance() {
+  static ThreadPool pool(std::max(0L, static_cast<long>(std::thread::hardware_concurrency()) - 1));
+  return pool;
+}
+
+long ThreadPool::threadCount() const {
+  return m_threads.size();
+}
+
+void ThreadPool::run(const std::vector<std::function<void(void)>>& tasks) {
+
+  /* Sequential case */
+  if (m_threads.empty() || tasks.size() < 2) {
+    for (const auto& t : tasks) {
+      t();
+    }
+    return;
+  }
+
+  /* Batch state */
+  std::mutex batchMutex;
+  std::condition_variable batchCondition;
+  auto remaining = tasks.size();
+  std::exception_ptr error;
+
+  /* Enqueue */
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& t : tasks) {
+      m_queue.emplace_back([&]() {
+        try {
+          t();
+        } catch (...) {
+          std::lock_guard<std::mutex> batchLock(batchMutex);
+          if (not error) {
+            error = std::current_exception();
+          }
+        }
+        std::lock_guard<std::mutex> batchLock(batchMutex);
+        if (--remaining == 0) {
+          batchCondition.notify_all();
+        }
+      });
+    }
+  }
+  m_condition.notify_all();
+
+  /* Help, then wait */
+  while (runNext()) {
+  }
+  std::unique_lock<std::mutex> batchLock(batchMutex);
+  batchCondition.wait(batchLock, [&]() {
+    return remaining == 0;
+  });
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void ThreadPool::work() {
+  while (true) {
+    std::function<void(void)> task;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock, [&]() {
+        return m_stop || not m_queue.empty();
+      });
+      if (m_queue.empty()) { // Stopped
+        return;
+      }
+      task = std::move(m_queue.front());
+      m_queue.pop_front();
+    }
+    task();
+  }
+}
+
+bool ThreadPool::runNext() {
+  std::function<void(void)> task;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_queue.empty()) {
+      return false;
+    }
+    task = std::move(m_queue.front());
+    m_queue.pop_front();
+  }
+  task();
+  return true;
+}
+
+} // namespace Fits
+} // namespace Euclid
@@ -0,0 +1,86 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsUtils/Prefetcher.h"
+
+#include <boost/test/unit_test.hpp>
+#include <stdexcept>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(Prefetcher_test)
+
+//-----------------------------------------------------------------------------
+
+void checkSequence(long queueDepth) {
+  const long batchCount = 20;
+  const auto reader = [](long i, std::vector<long>& batch) {
+    for (auto& e : batch) {
+      e = i;
+    }
+  };
+  Prefetcher<std::vector<long>> prefetcher(batchCount, queueDepth, std::vector<long>(3), reader);
+  BOOST_TEST(prefetcher.queueDepth() == queueDepth);
+  for (long i = 0; i < batchCount; ++i) {
+    const auto& batch = prefetcher.next();
+    for (auto e : batch) {
+      BOOST_TEST(e == i);
+    }
+  }
+  BOOST_CHECK_THROW(prefetcher.next(), std::out_of_range);
+  const auto metrics = prefetcher.metrics();
+  BOOST_TEST(metrics.batchCount == batchCount);
+  BOOST_TEST(metrics.stallCount <= batchCount);
+}
+
+BOOST_AUTO_TEST_CASE(synchronous_test) {
+  checkSequence(0);
+}
+
+BOOST_AUTO_TEST_CASE(double_buffering_test) {
+  checkSequence(2);
+}
+
+BOOST_AUTO_TEST_CASE(triple_buffering_test) {
+  checkSequence(3);
+}
+
+BOOST_AUTO_TEST_CASE(exception_test) {
+  Prefetcher<long> prefetcher(3, 2, 0, [](long i, long& batch) {
+    if (i == 1) {
+      throw std::runtime_error("Failure");
+    }
+    batch = i;
+  });
+  BOOST_TEST(prefetcher.next() == 0);
+  BOOST_CHECK_THROW(prefetcher.next(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(early_destruction_test) {
+  Prefetcher<long> prefetcher(1000, 2, 0, [](long i, long& batch) {
+    batch = i;
+  });
+  BOOST_TEST(prefetcher.next() == 0);
+} // Should not hang
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,76 @@
+/**
+ * @copyright (C) 2012-2020 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+#include "EleFitsUtils/ThreadPool.h"
+
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <stdexcept>
+
+using namespace Euclid::Fits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(ThreadPool_test)
+
+//-----------------------------------------------------------------------------
+
+void checkAllTasksAreRun(ThreadPool& pool) {
+  std::vector<int> values(100, 0);
+  std::vector<std::function<void(void)>> tasks;
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    tasks.push_back([&, i]() {
+      values[i] = i + 1;
+    });
+  }
+  pool.run(tasks);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    BOOST_TEST(values[i] == i + 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(sequential_test) {
+  ThreadPool pool(0);
+  BOOST_TEST(pool.threadCount() == 0);
+  checkAllTasksAreRun(pool);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_test) {
+  ThreadPool pool(4);
+  BOOST_TEST(pool.threadCount() == 4);
+  checkAllTasksAreRun(pool);
+  checkAllTasksAreRun(pool);
+}
+
+BOOST_AUTO_TEST_CASE(exception_test) {
+  ThreadPool pool(2);
+  std::atomic<int> count(0);
+  std::vector<std::function<void(void)>> tasks(10, [&]() {
+    ++count;
+  });
+  tasks[3] = []() {
+    throw std::runtime_error("Task failed");
+  };
+  BOOST_CHECK_THROW(pool.run(tasks), std::runtime_error);
+  BOOST_TEST(count == 9);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
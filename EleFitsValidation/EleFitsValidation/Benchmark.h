@@ -22,6 +22,7 @@
 
 #include "EleFitsData/Column.h"
 #include "EleFitsData/DataUtils.h"
+#include "EleFitsData/FixedStringColumn.h"
 #include "EleFitsData/Raster.h"
 #include "EleFitsValidation/Chronometer.h"
 #include "ElementsKernel/Logging.h"
@@ -50,7 +51,7 @@ using BColumns = std::tuple<
     VecColumn<double>,
     VecColumn<std::complex<float>>,
     VecColumn<std::complex<double>>,
-    // VecColumn<std::string>, //TODO to be handled specially
+    FixedStringColumn,
     VecColumn<char>,
     VecColumn<std::uint32_t>,
     VecColumn<std::uint64_t>>;
@@ -60,11 +61,32 @@ using BColumns = std::tuple<
  */
 constexpr std::size_t columnCount = std::tuple_size<BColumns>::value;
 
+/**
+ * @brief The column type used for benchmarking scattered updates.
+ */
+using BUpdateColumn = VecColumn<double>;
+
 /**
  * @brief The chronometer used for benchmarking.
  */
 using BChronometer = Chronometer<std::chrono::milliseconds>;
 
+/**
+ * @brief Get the peak resident set size of the current process, in kilobytes.
+ * @details
+ * This is a high-water mark since the process started, and not the footprint of the last phase only:
+ * it includes the input data generation, and the values reported after a read include the preceding write.
+ */
+long peakRss();
+
+/**
+ * @brief Get the CPU time (user and system) consumed by the current process, in milliseconds.
+ * @details
+ * As opposed to the elapsed time, this includes the time spent by all the threads,
+ * e.g. to compress data, and excludes the time spent waiting for I/Os.
+ */
+double cpuTime();
+
 /**
  * @brief The exception which is thrown when a test case is not implemented.
  */
@@ -142,6 +164,16 @@ public:
    */
   const BChronometer& readBintables(long first, long count);
 
+  /**
+   * @brief Update some rows of a column in the given binary table extensions.
+   * @param first The first (0-based) HDU index
+   * @param count The number of HDUs
+   * @param rows The indices of the rows to be updated, in any order
+   * @param column The new values, such that the i-th value is written at row `rows[i]`
+   */
+  const BChronometer&
+  updateBintables(long first, long count, const std::vector<long>& rows, const BUpdateColumn& column);
+
   /**
    * @brief Write the given raster in a new image extension.
    * @details
@@ -176,13 +208,42 @@ public:
     throw TestCaseNotImplemented("Read binary table");
   }
 
+  /**
+   * @brief Update some rows of a column in the given binary table extension.
+   * @copydetails writeImage
+   */
+  virtual BChronometer::Unit updateBintable(long, const std::vector<long>&, const BUpdateColumn&) {
+    throw TestCaseNotImplemented("Update binary table");
+  }
+
+  /**
+   * @brief Get the compression ratio of the HDUs processed by the last call to a multi-HDU method, e.g. `readImages()`.
+   * @details
+   * This is the ratio of the raw data size to the stored data size, or 1 if the data is not compressed.
+   */
+  double compressionRatio() const;
+
 protected:
+  /**
+   * @brief Account for the data sizes of a compressed HDU in the compression ratio.
+   * @details
+   * This method is called by the child classes which compress data, outside of the measured time.
+   */
+  void addCompressedSizes(double rawSize, double storedSize);
+
+  /** @brief Reset the chronometer and data sizes before processing HDUs. */
+  void reset();
+
   /** @brief The file name. */
   std::string m_filename;
   /** @brief The chronometer. */
   BChronometer m_chrono;
   /** @brief The logger. */
   Elements::Logging m_logger;
+  /** @brief The raw size of the compressed data. */
+  double m_rawSize;
+  /** @brief The stored size of the compressed data. */
+  double m_storedSize;
 };
 
 /**
@@ -129,6 +129,31 @@ private:
   template <std::size_t i>
   void readColumn(BColumns& columns, long firstRow, long rowCount);
 
+  /**
+   * @brief Write a chunk of a column with given 1-based index.
+   */
+  template <typename T>
+  void writeChunk(const VecColumn<T>& column, int colnum, long firstRow, long rowCount);
+
+  /**
+   * @brief Write a chunk of a fixed-width string column with given 1-based index.
+   * @details
+   * CFitsIO is given pointers to the cells of the arena, such that no string is allocated.
+   */
+  void writeChunk(const FixedStringColumn& column, int colnum, long firstRow, long rowCount);
+
+  /**
+   * @brief Read a chunk of a column with given 1-based index.
+   */
+  template <typename T>
+  void readChunk(VecColumn<T>& column, int colnum, long firstRow, long rowCount);
+
+  /**
+   * @brief Read a chunk of a fixed-width string column with given 1-based index.
+   * @copydetails writeChunk(const FixedStringColumn&, int, long, long)
+   */
+  void readChunk(FixedStringColumn& column, int colnum, long firstRow, long rowCount);
+
 private:
   /** @brief The Fits file. */
   fitsfile* m_fptr;
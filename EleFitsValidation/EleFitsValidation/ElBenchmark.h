@@ -77,6 +77,16 @@ protected:
   template <long i>
   Indexed<typename std::tuple_element<i, BColumns>::type::Value> colIndexed() const;
 
+  /**
+   * @brief Create a binary table extension with the metadata of given columns.
+   */
+  const BintableHdu& initBintableExt(const BColumns& columns);
+
+  /**
+   * @brief Create columns with the metadata and row count of given binary table extension.
+   */
+  BColumns initColumns(const BintableColumns& ext) const;
+
 protected:
   /**
    * @brief The MEF file handler.
@@ -119,6 +129,221 @@ public:
    * @copybrief Benchmark::readBintable
    */
   virtual BColumns readBintable(long index) override;
+
+  /**
+   * @copybrief Benchmark::updateBintable
+   * @details
+   * The whole column is read, updated in memory, and written back.
+   */
+  virtual BChronometer::Unit updateBintable(long index, const std::vector<long>& rows, const BUpdateColumn& column)
+      override;
+};
+
+/**
+ * @brief Standard EleFits, where the input data is copied before being written.
+ * @details
+ * This emulates the former write path, where a non-const copy of the data was passed to CFitsIO,
+ * in order to measure the time and memory overhead of such copies.
+ * Read methods are inherited from ElBenchmark.
+ */
+class ElCopyBenchmark : public ElBenchmark {
+
+public:
+  /**
+   * @brief Destructor.
+   */
+  virtual ~ElCopyBenchmark() = default;
+
+  /**
+   * @brief Constructor.
+   */
+  explicit ElCopyBenchmark(const std::string& filename);
+
+  /**
+   * @copybrief Benchmark::writeImage
+   */
+  virtual BChronometer::Unit writeImage(const BRaster& raster) override;
+
+  /**
+   * @copybrief Benchmark::writeBintable
+   */
+  virtual BChronometer::Unit writeBintable(const BColumns& columns) override;
+};
+
+/**
+ * @brief Standard EleFits, where binary table rows are updated by scattered writes.
+ * @details
+ * Other methods are inherited from ElBenchmark.
+ * @see BintableColumns::writeRows
+ */
+class ElScatterBenchmark : public ElBenchmark {
+
+public:
+  /**
+   * @brief Destructor.
+   */
+  virtual ~ElScatterBenchmark() = default;
+
+  /**
+   * @brief Constructor.
+   */
+  explicit ElScatterBenchmark(const std::string& filename);
+
+  /**
+   * @copybrief Benchmark::updateBintable
+   */
+  virtual BChronometer::Unit updateBintable(long index, const std::vector<long>& rows, const BUpdateColumn& column)
+      override;
+};
+
+/**
+ * @brief Standard EleFits, where binary tables are read as raw row blocks.
+ * @details
+ * Write methods are inherited from ElBenchmark.
+ * @see BintableColumns::readSegmentSeqRawTo
+ */
+class ElRawBenchmark : public ElBenchmark {
+
+public:
+  /**
+   * @brief Destructor.
+   */
+  virtual ~ElRawBenchmark() = default;
+
+  /**
+   * @brief Constructor.
+   */
+  explicit ElRawBenchmark(const std::string& filename);
+
+  /**
+   * @copybrief Benchmark::readBintable
+   */
+  virtual BColumns readBintable(long index) override;
+};
+
+/**
+ * @brief Standard EleFits, where binary tables are written by appending small segments.
+ * @details
+ * This emulates incremental ingestion, where each append extends the data unit
+ * unless rows are reserved beforehand.
+ * Other methods are inherited from ElBenchmark.
+ * @see BintableColumns::reserve
+ */
+class ElAppendBenchmark : public ElBenchmark {
+
+public:
+  /**
+   * @brief Destructor.
+   */
+  virtual ~ElAppendBenchmark() = default;
+
+  /**
+   * @brief Constructor.
+   * @param filename The file name
+   * @param chunkRowCount The number of rows per appended segment
+   * @param reserve Whether to reserve rows (with geometric growth) or let each append extend the data unit
+   */
+  ElAppendBenchmark(const std::string& filename, long chunkRowCount, bool reserve);
+
+  /**
+   * @copybrief Benchmark::writeBintable
+   */
+  virtual BChronometer::Unit writeBintable(const BColumns& columns) override;
+
+private:
+  /**
+   * @brief The number of rows per appended segment.
+   */
+  long m_chunkRowCount;
+
+  /**
+   * @brief Whether to reserve rows.
+   */
+  bool m_reserve;
+};
+
+/**
+ * @brief Standard EleFits, where binary tables are tile-compressed.
+ * @details
+ * Tables are compressed within the measured write time, and uncompressed within the measured read time.
+ * The compression ratio is reported in the results, and logged for each table when it is written.
+ * Other methods are inherited from ElBenchmark.
+ * @see TableCompression
+ */
+class ElCompressedBenchmark : public ElBenchmark {
+
+public:
+  /**
+   * @brief Destructor.
+   */
+  virtual ~ElCompressedBenchmark() = default;
+
+  /**
+   * @brief Constructor.
+   * @param filename The file name
+   * @param tileRowCount The number of rows per tile
+   * @param algo The compression algorithm of all the columns
+   */
+  ElCompressedBenchmark(const std::string& filename, long tileRowCount, TableCompression::Algorithm algo);
+
+  /**
+   * @copybrief Benchmark::writeBintable
+   */
+  virtual BChronometer::Unit writeBintable(const BColumns& columns) override;
+
+  /**
+   * @copybrief Benchmark::readBintable
+   */
+  virtual BColumns readBintable(long index) override;
+
+private:
+  /**
+   * @brief The compression parameters.
+   */
+  TableCompression m_compression;
+};
+
+/**
+ * @brief Standard EleFits, where images are tile-compressed.
+ * @details
+ * Images are written as 2D 32-bit integer images of 12-bit values,
+ * which is representative of detector images, and compatible with all the algorithms.
+ * The conversions from and to `BRaster` are not measured.
+ * Images are compressed within the measured write time, and uncompressed within the measured read time.
+ * The compression ratio is reported in the results, and logged for each image when it is read.
+ * Other methods are inherited from ElBenchmark.
+ * @see ImageCompression
+ */
+class ElCompressedImageBenchmark : public ElBenchmark {
+
+public:
+  /**
+   * @brief Destructor.
+   */
+  virtual ~ElCompressedImageBenchmark() = default;
+
+  /**
+   * @brief Constructor.
+   * @param filename The file name
+   * @param algo The compression algorithm
+   */
+  ElCompressedImageBenchmark(const std::string& filename, ImageCompression::Algorithm algo);
+
+  /**
+   * @copybrief Benchmark::writeImage
+   */
+  virtual BChronometer::Unit writeImage(const BRaster& raster) override;
+
+  /**
+   * @copybrief Benchmark::readImage
+   */
+  virtual BRaster readImage(long index) override;
+
+private:
+  /**
+   * @brief The compression parameters.
+   */
+  ImageCompression m_compression;
 };
 
 } // namespace Test
@@ -39,21 +39,7 @@ void CfitsioBenchmark::setupColumnInfo(
 
 template <std::size_t i>
 void CfitsioBenchmark::writeColumn(const BColumns& columns, long firstRow, long rowCount) {
-  const auto& col = std::get<i>(columns);
-  const auto begin = col.vector().begin() + firstRow;
-  const auto end = begin + rowCount;
-  using Value = typename std::decay_t<decltype(col)>::Value;
-  std::vector<Value> nonconstVec(begin, end);
-  fits_write_col(
-      m_fptr,
-      Cfitsio::TypeCode<Value>::forBintable(),
-      i + 1,
-      firstRow + 1,
-      1,
-      rowCount,
-      nonconstVec.data(),
-      &m_status);
-  mayThrow("Cannot write column");
+  writeChunk(std::get<i>(columns), i + 1, firstRow, rowCount);
 }
 
 template <std::size_t i>
@@ -70,13 +56,31 @@ void CfitsioBenchmark::initColumn(BColumns& columns, long rowCount) {
 
 template <std::size_t i>
 void CfitsioBenchmark::readColumn(BColumns& columns, long firstRow, long rowCount) {
-  auto& col = std::get<i>(columns);
-  auto begin = col.data() + firstRow;
-  using Value = typename std::decay_t<decltype(col)>::Value;
+  readChunk(std::get<i>(columns), i + 1, firstRow, rowCount);
+}
+
+template <typename T>
+void CfitsioBenchmark::writeChunk(const VecColumn<T>& column, int colnum, long firstRow, long rowCount) {
+  const auto* begin = column.data() + firstRow;
+  fits_write_col(
+      m_fptr,
+      Cfitsio::TypeCode<T>::forBintable(),
+      colnum,
+      firstRow + 1,
+      1,
+      rowCount,
+      Cfitsio::nonconstData(begin),
+      &m_status);
+  mayThrow("Cannot write column");
+}
+
+template <typename T>
+void CfitsioBenchmark::readChunk(VecColumn<T>& column, int colnum, long firstRow, long rowCount) {
+  auto begin = column.data() + firstRow;
   fits_read_col(
       m_fptr,
-      Cfitsio::TypeCode<Value>::forBintable(),
-      i + 1,
+      Cfitsio::TypeCode<T>::forBintable(),
+      colnum,
       firstRow + 1,
       1,
       rowCount,
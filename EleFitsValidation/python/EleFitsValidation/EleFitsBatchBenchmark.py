@@ -42,7 +42,7 @@ def makeCommand(testCase, output, results, log_level):
         cmd += f' --images {int(float(testCase["HDU count"]))} --pixels {int(float(testCase["Value count / HDU"]))}'
         # int(float(value)) allows value to be an integer in scientific notation
     if testCase['HDU type'] == 'Binary table':
-        cmd += f' --tables {int(float(testCase["HDU count"]))} --rows {int(float(testCase["Value count / HDU"]))//10}'
+        cmd += f' --tables {int(float(testCase["HDU count"]))} --rows {int(float(testCase["Value count / HDU"]))//11}'
     return cmd
 
 
@@ -81,7 +81,7 @@ def mainMethod(args):
                 if hduType == 'Image':
                     shape = f'{scientificNotation(valueCount)} pixels'
                 else:
-                    shape = f'10 columns x {scientificNotation(valueCount/10)} rows'
+                    shape = f'11 columns x {scientificNotation(valueCount/11)} rows'
                 testName = f'{testCase["Mode"]} {hduType}\n({testCase["HDU count"]} HDUs x {shape})'
                 testCaseSetup = testCase['Test setup']
                 data = [float(s) for s in testCase["Samples (ms)"].split(',')]
@@ -19,16 +19,52 @@
 
 #include "EleFitsValidation/Benchmark.h"
 
+#include <sys/resource.h>
+
 namespace Euclid {
 namespace Fits {
 namespace Test {
 
+long peakRss() {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return -1;
+  }
+  return usage.ru_maxrss; // Kilobytes on Linux
+}
+
+double cpuTime() {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return -1;
+  }
+  const auto seconds = usage.ru_utime.tv_sec + usage.ru_stime.tv_sec;
+  const auto microseconds = usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+  return seconds * 1000. + microseconds / 1000.;
+}
+
 Benchmark::Benchmark(const std::string& filename) :
-    m_filename(filename), m_chrono(), m_logger(Elements::Logging::getLogger("Benchmark")) {}
+    m_filename(filename), m_chrono(), m_logger(Elements::Logging::getLogger("Benchmark")), m_rawSize(0),
+    m_storedSize(0) {}
+
+double Benchmark::compressionRatio() const {
+  return m_storedSize > 0 ? m_rawSize / m_storedSize : 1;
+}
+
+void Benchmark::addCompressedSizes(double rawSize, double storedSize) {
+  m_rawSize += rawSize;
+  m_storedSize += storedSize;
+}
+
+void Benchmark::reset() {
+  m_chrono.reset();
+  m_rawSize = 0;
+  m_storedSize = 0;
+}
 
 const BChronometer& Benchmark::writeImages(long count, const BRaster& raster) {
   open();
-  m_chrono.reset();
+  reset();
   m_logger.debug() << "First pixel: " << raster.at({ 0 });
   m_logger.debug() << "Last pixel: " << raster.at({ -1 });
   for (long i = 0; i < count; ++i) {
@@ -43,7 +79,7 @@ const BChronometer& Benchmark::writeImages(long count, const BRaster& raster) {
 
 const BChronometer& Benchmark::writeBintables(long count, const BColumns& columns) { // TODO avoid duplication
   open();
-  m_chrono.reset();
+  reset();
   m_logger.debug() << "First column, first row: " << std::get<0>(columns).at(0, 0);
   m_logger.debug() << "Last column, last row: " << std::get<columnCount - 1>(columns).at(-1, -1);
   for (long i = 0; i < count; ++i) {
@@ -58,7 +94,7 @@ const BChronometer& Benchmark::writeBintables(long count, const BColumns& column
 
 const BChronometer& Benchmark::readImages(long first, long count) {
   open();
-  m_chrono.reset();
+  reset();
   for (long i = 0; i < count; ++i) {
     const auto raster = readImage(first + i);
     m_logger.debug() << i + 1 << "/" << count << ": " << m_chrono.last().count() << "ms";
@@ -73,7 +109,7 @@ const BChronometer& Benchmark::readImages(long first, long count) {
 
 const BChronometer& Benchmark::readBintables(long first, long count) {
   open();
-  m_chrono.reset();
+  reset();
   for (long i = 0; i < count; ++i) {
     const auto columns = readBintable(i + first);
     m_logger.debug() << i + 1 << "/" << count << ": " << m_chrono.last().count() << "ms";
@@ -86,6 +122,20 @@ const BChronometer& Benchmark::readBintables(long first, long count) {
   return m_chrono;
 }
 
+const BChronometer&
+Benchmark::updateBintables(long first, long count, const std::vector<long>& rows, const BUpdateColumn& column) {
+  open();
+  reset();
+  for (long i = 0; i < count; ++i) {
+    const auto inc = updateBintable(i + first, rows, column);
+    m_logger.debug() << i + 1 << "/" << count << ": " << inc.count() << "ms";
+  }
+  const auto total = m_chrono.elapsed();
+  m_logger.debug() << "TOTAL: " << total.count() << "ms";
+  close();
+  return m_chrono;
+}
+
 void BenchmarkFactory::registerBenchmarkMaker(const std::string& key, BenchmarkMaker factory) {
   if (m_register.find(key) != m_register.end()) {
     throw std::runtime_error(std::string("Benchmark already registered: ") + key);
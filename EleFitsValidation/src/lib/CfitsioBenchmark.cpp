@@ -57,13 +57,12 @@ BChronometer::Unit CfitsioBenchmark::writeImage(const BRaster& raster) {
       nonconstShape.data(),
       &m_status);
   mayThrow("Cannot create image HDU");
-  std::vector<BRaster::Value> nonconstData(raster.data(), raster.data() + raster.size());
   fits_write_img(
       m_fptr,
       Cfitsio::TypeCode<BRaster::Value>::forImage(),
       1,
       raster.size(),
-      nonconstData.data(),
+      Cfitsio::nonconstData(raster.data()),
       &m_status);
   mayThrow("Cannot write image");
   return m_chrono.stop();
@@ -92,9 +91,9 @@ BRaster CfitsioBenchmark::readImage(long index) {
 
 BChronometer::Unit CfitsioBenchmark::writeBintable(const BColumns& columns) {
   long rowCount = std::get<0>(columns).rowCount();
-  std::vector<std::string> names(rowCount);
-  std::vector<std::string> formats(rowCount);
-  std::vector<std::string> units(rowCount);
+  std::vector<std::string> names(columnCount);
+  std::vector<std::string> formats(columnCount);
+  std::vector<std::string> units(columnCount);
   setupColumnInfo<0>(columns, names, formats, units);
   setupColumnInfo<1>(columns, names, formats, units);
   setupColumnInfo<2>(columns, names, formats, units);
@@ -104,7 +103,8 @@ BChronometer::Unit CfitsioBenchmark::writeBintable(const BColumns& columns) {
   setupColumnInfo<6>(columns, names, formats, units);
   setupColumnInfo<7>(columns, names, formats, units);
   setupColumnInfo<8>(columns, names, formats, units);
-  setupColumnInfo<9>(columns, names, formats, units); // TODO index_sequence
+  setupColumnInfo<9>(columns, names, formats, units);
+  setupColumnInfo<10>(columns, names, formats, units); // TODO index_sequence
   Cfitsio::CStrArray nameArray(names);
   Cfitsio::CStrArray formatArray(formats);
   Cfitsio::CStrArray unitArray(units);
@@ -132,7 +132,8 @@ BChronometer::Unit CfitsioBenchmark::writeBintable(const BColumns& columns) {
     writeColumn<6>(columns, firstRow, pastLastRow - firstRow);
     writeColumn<7>(columns, firstRow, pastLastRow - firstRow);
     writeColumn<8>(columns, firstRow, pastLastRow - firstRow);
-    writeColumn<9>(columns, firstRow, pastLastRow - firstRow); // TODO index_sequence
+    writeColumn<9>(columns, firstRow, pastLastRow - firstRow);
+    writeColumn<10>(columns, firstRow, pastLastRow - firstRow); // TODO index_sequence
     firstRow = pastLastRow;
   }
   return m_chrono.stop();
@@ -157,6 +158,7 @@ BColumns CfitsioBenchmark::readBintable(long index) {
   initColumn<7>(columns, rowCount);
   initColumn<8>(columns, rowCount);
   initColumn<9>(columns, rowCount);
+  initColumn<10>(columns, rowCount);
   long rowChunkSize = computeRowChunkSize(rowCount);
   for (long firstRow = 0; firstRow < rowCount;) {
     const long pastLastRow = std::min(firstRow + rowChunkSize, rowCount);
@@ -169,13 +171,32 @@ BColumns CfitsioBenchmark::readBintable(long index) {
     readColumn<6>(columns, firstRow, pastLastRow - firstRow);
     readColumn<7>(columns, firstRow, pastLastRow - firstRow);
     readColumn<8>(columns, firstRow, pastLastRow - firstRow);
-    readColumn<9>(columns, firstRow, pastLastRow - firstRow); // TODO index_sequence
+    readColumn<9>(columns, firstRow, pastLastRow - firstRow);
+    readColumn<10>(columns, firstRow, pastLastRow - firstRow); // TODO index_sequence
     firstRow = pastLastRow;
   }
   m_chrono.stop();
   return columns;
 }
 
+void CfitsioBenchmark::writeChunk(const FixedStringColumn& column, int colnum, long firstRow, long rowCount) {
+  std::vector<char*> cells(rowCount);
+  for (long i = 0; i < rowCount; ++i) {
+    cells[i] = Cfitsio::nonconstData(column.cell(firstRow + i));
+  }
+  fits_write_col(m_fptr, TSTRING, colnum, firstRow + 1, 1, rowCount, cells.data(), &m_status);
+  mayThrow("Cannot write string column");
+}
+
+void CfitsioBenchmark::readChunk(FixedStringColumn& column, int colnum, long firstRow, long rowCount) {
+  std::vector<char*> cells(rowCount);
+  for (long i = 0; i < rowCount; ++i) {
+    cells[i] = column.cell(firstRow + i);
+  }
+  fits_read_col(m_fptr, TSTRING, colnum, firstRow + 1, 1, rowCount, nullptr, cells.data(), nullptr, &m_status);
+  mayThrow("Cannot read string column");
+}
+
 long CfitsioBenchmark::computeRowChunkSize(long rowCount) {
   if (m_rowChunkSize == -1) {
     m_logger.debug() << "Row chunk size: " << rowCount;
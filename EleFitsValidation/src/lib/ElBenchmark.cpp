@@ -19,10 +19,26 @@
 
 #include "EleFitsValidation/ElBenchmark.h"
 
+#include <algorithm> // min, transform
+#include <cmath> // sqrt
+#include <numeric> // iota
+
 namespace Euclid {
 namespace Fits {
 namespace Test {
 
+namespace {
+
+/**
+ * @brief Get the size of the data unit of a tile-compressed HDU, i.e. of the compressed tiles and their descriptors.
+ */
+double storedSize(const Header& header) {
+  return header.parse<double>("NAXIS1").value * header.parse<double>("NAXIS2").value +
+      header.parse<double>("PCOUNT").value;
+}
+
+} // namespace
+
 ElColwiseBenchmark::ElColwiseBenchmark(const std::string& filename) :
     Benchmark(filename), m_f(filename, FileMode::Overwrite) {
   m_logger.info() << "EleFits benchmark (column-wise, filename: " << filename << ")";
@@ -38,49 +54,44 @@ void ElColwiseBenchmark::close() {
 
 BChronometer::Unit ElColwiseBenchmark::writeBintable(const BColumns& columns) {
   m_chrono.start();
-  const auto& ext = m_f.initBintableExt(
-      "",
-      std::get<0>(columns).info(),
-      std::get<1>(columns).info(),
-      std::get<2>(columns).info(),
-      std::get<3>(columns).info(),
-      std::get<4>(columns).info(),
-      std::get<5>(columns).info(),
-      std::get<6>(columns).info(),
-      std::get<7>(columns).info(),
-      std::get<8>(columns).info(),
-      std::get<9>(columns).info());
-  ext.writeColumn(std::get<0>(columns));
-  ext.writeColumn(std::get<1>(columns));
-  ext.writeColumn(std::get<2>(columns));
-  ext.writeColumn(std::get<3>(columns));
-  ext.writeColumn(std::get<4>(columns));
-  ext.writeColumn(std::get<5>(columns));
-  ext.writeColumn(std::get<6>(columns));
-  ext.writeColumn(std::get<7>(columns));
-  ext.writeColumn(std::get<8>(columns));
-  ext.writeColumn(std::get<9>(columns));
+  const auto& ext = initBintableExt(columns).columns();
+  seqForeach(columns, [&](const auto& c) {
+    ext.write(c);
+  });
   return m_chrono.stop();
 }
 
 BColumns ElColwiseBenchmark::readBintable(long index) {
   m_chrono.start();
-  const auto& ext = m_f.access<BintableHdu>(index);
-  const auto columns = std::make_tuple(
-      ext.readColumn<std::tuple_element<0, BColumns>::type::Value>(0),
-      ext.readColumn<std::tuple_element<1, BColumns>::type::Value>(1),
-      ext.readColumn<std::tuple_element<2, BColumns>::type::Value>(2),
-      ext.readColumn<std::tuple_element<3, BColumns>::type::Value>(3),
-      ext.readColumn<std::tuple_element<4, BColumns>::type::Value>(4),
-      ext.readColumn<std::tuple_element<5, BColumns>::type::Value>(5),
-      ext.readColumn<std::tuple_element<6, BColumns>::type::Value>(6),
-      ext.readColumn<std::tuple_element<7, BColumns>::type::Value>(7),
-      ext.readColumn<std::tuple_element<8, BColumns>::type::Value>(8),
-      ext.readColumn<std::tuple_element<9, BColumns>::type::Value>(9));
+  const auto& ext = m_f.access<BintableHdu>(index).columns();
+  auto columns = initColumns(ext);
+  long i = 0;
+  seqForeach(columns, [&](auto& c) {
+    ext.readSegmentTo(0, i, c);
+    ++i;
+  });
   m_chrono.stop();
   return columns;
 }
 
+const BintableHdu& ElColwiseBenchmark::initBintableExt(const BColumns& columns) {
+  return tupleApply(columns, [&](const auto&... cs) -> const BintableHdu& {
+    return m_f.initBintableExt("", cs.info()...);
+  });
+}
+
+BColumns ElColwiseBenchmark::initColumns(const BintableColumns& ext) const {
+  const auto rowCount = ext.readRowCount();
+  BColumns columns;
+  long i = 0;
+  seqForeach(columns, [&](auto& c) {
+    using TColumn = std::decay_t<decltype(c)>;
+    c = TColumn(ext.readInfo<typename TColumn::Value>(i), rowCount);
+    ++i;
+  });
+  return columns;
+}
+
 ElBenchmark::ElBenchmark(const std::string& filename) : ElColwiseBenchmark(filename) {
   m_logger.info() << "EleFits benchmark (buffered, filename: " << filename << ")";
 }
@@ -93,7 +104,7 @@ BChronometer::Unit ElBenchmark::writeImage(const BRaster& raster) {
 
 BChronometer::Unit ElBenchmark::writeBintable(const BColumns& columns) {
   m_chrono.start();
-  m_f.assignBintableExt("", columns);
+  initBintableExt(columns).columns().writeSeq(columns);
   return m_chrono.stop();
 }
 
@@ -106,21 +117,164 @@ BRaster ElBenchmark::readImage(long index) {
 
 BColumns ElBenchmark::readBintable(long index) {
   m_chrono.start();
-  const auto columns = m_f.access<BintableHdu>(index).columns().readSeq(
-      colIndexed<0>(),
-      colIndexed<1>(),
-      colIndexed<2>(),
-      colIndexed<3>(),
-      colIndexed<4>(),
-      colIndexed<5>(),
-      colIndexed<6>(),
-      colIndexed<7>(),
-      colIndexed<8>(),
-      colIndexed<9>());
+  const auto& ext = m_f.access<BintableHdu>(index).columns();
+  auto columns = initColumns(ext);
+  std::vector<long> indices(columnCount);
+  std::iota(indices.begin(), indices.end(), 0);
+  ext.readSeqTo(indices, columns);
   m_chrono.stop();
   return columns;
 }
 
+BChronometer::Unit
+ElBenchmark::updateBintable(long index, const std::vector<long>& rows, const BUpdateColumn& column) {
+  m_chrono.start();
+  const auto& ext = m_f.access<BintableHdu>(index).columns();
+  auto values = ext.read<BUpdateColumn::Value>(column.info().name);
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    values(rows[i]) = column(i);
+  }
+  ext.write(values);
+  return m_chrono.stop();
+}
+
+ElCopyBenchmark::ElCopyBenchmark(const std::string& filename) : ElBenchmark(filename) {
+  m_logger.info() << "EleFits benchmark (buffered with copy, filename: " << filename << ")";
+}
+
+BChronometer::Unit ElCopyBenchmark::writeImage(const BRaster& raster) {
+  m_chrono.start();
+  const BRaster copy(raster);
+  m_f.assignImageExt("", copy);
+  return m_chrono.stop();
+}
+
+BChronometer::Unit ElCopyBenchmark::writeBintable(const BColumns& columns) {
+  m_chrono.start();
+  const BColumns copy(columns);
+  initBintableExt(copy).columns().writeSeq(copy);
+  return m_chrono.stop();
+}
+
+ElRawBenchmark::ElRawBenchmark(const std::string& filename) : ElBenchmark(filename) {
+  m_logger.info() << "EleFits benchmark (raw row blocks, filename: " << filename << ")";
+}
+
+BColumns ElRawBenchmark::readBintable(long index) {
+  m_chrono.start();
+  const auto& ext = m_f.access<BintableHdu>(index).columns();
+  auto columns = initColumns(ext);
+  ext.readSegmentSeqRawTo(0, columns);
+  m_chrono.stop();
+  return columns;
+}
+
+ElScatterBenchmark::ElScatterBenchmark(const std::string& filename) : ElBenchmark(filename) {
+  m_logger.info() << "EleFits benchmark (scattered updates, filename: " << filename << ")";
+}
+
+BChronometer::Unit
+ElScatterBenchmark::updateBintable(long index, const std::vector<long>& rows, const BUpdateColumn& column) {
+  m_chrono.start();
+  m_f.access<BintableHdu>(index).columns().writeRows(rows, column);
+  return m_chrono.stop();
+}
+
+ElAppendBenchmark::ElAppendBenchmark(const std::string& filename, long chunkRowCount, bool reserve) :
+    ElBenchmark(filename), m_chunkRowCount(chunkRowCount), m_reserve(reserve) {
+  m_logger.info() << "EleFits benchmark (appends of " << chunkRowCount << " rows, "
+                  << (reserve ? "with" : "without") << " reservation, filename: " << filename << ")";
+}
+
+BChronometer::Unit ElAppendBenchmark::writeBintable(const BColumns& columns) {
+  m_chrono.start();
+  const auto& ext = initBintableExt(columns).columns();
+  if (m_reserve) {
+    ext.reserve(m_chunkRowCount); // Then grown geometrically
+  }
+  const long rowCount = columnsRowCount(columns);
+  for (long front = 0; front < rowCount; front += m_chunkRowCount) {
+    const long back = std::min(front + m_chunkRowCount, rowCount) - 1;
+    ext.writeSegmentSeq({ -1, Segment { front, back } }, columns);
+  }
+  ext.shrinkToFit();
+  return m_chrono.stop();
+}
+
+ElCompressedBenchmark::ElCompressedBenchmark(
+    const std::string& filename,
+    long tileRowCount,
+    TableCompression::Algorithm algo) :
+    ElBenchmark(filename),
+    m_compression(tileRowCount, algo) {
+  m_logger.info() << "EleFits benchmark (tile compression of " << tileRowCount << " rows, filename: " << filename
+                  << ")";
+}
+
+BChronometer::Unit ElCompressedBenchmark::writeBintable(const BColumns& columns) {
+  m_chrono.start();
+  const auto& ext = tupleApply(columns, [&](const auto&... cs) -> const BintableHdu& {
+    return m_f.initBintableExt("", m_compression, cs.info()...);
+  });
+  ext.columns().writeSeq(columns);
+  ext.flush(); // Compress now instead of at closing
+  const auto increment = m_chrono.stop();
+  const auto& header = ext.header();
+  const auto rawSize = header.parse<double>("ZNAXIS1").value * header.parse<double>("ZNAXIS2").value;
+  const auto compressedSize = storedSize(header);
+  m_logger.info() << "Compression ratio: " << rawSize / compressedSize;
+  addCompressedSizes(rawSize, compressedSize);
+  return increment;
+}
+
+BColumns ElCompressedBenchmark::readBintable(long index) {
+  auto columns = ElBenchmark::readBintable(index);
+  const auto& header = m_f.access<BintableHdu>(index).header();
+  addCompressedSizes(
+      header.parse<double>("ZNAXIS1").value * header.parse<double>("ZNAXIS2").value,
+      storedSize(header));
+  return columns;
+}
+
+ElCompressedImageBenchmark::ElCompressedImageBenchmark(
+    const std::string& filename,
+    ImageCompression::Algorithm algo) :
+    ElBenchmark(filename),
+    m_compression(algo) {
+  m_logger.info() << "EleFits benchmark (image tile compression, filename: " << filename << ")";
+}
+
+BChronometer::Unit ElCompressedImageBenchmark::writeImage(const BRaster& raster) {
+  const long size = raster.size();
+  long width = std::sqrt(size);
+  while (size % width != 0) {
+    --width;
+  }
+  VecRaster<std::int32_t, 2> image({ width, size / width });
+  std::transform(raster.data(), raster.data() + size, image.data(), [](std::int64_t value) {
+    return static_cast<std::int32_t>(value & 0xFFF);
+  });
+  m_chrono.start();
+  const auto& ext = m_f.assignImageExt("", image, m_compression);
+  const auto increment = m_chrono.stop();
+  addCompressedSizes(image.size() * sizeof(std::int32_t), storedSize(ext.header()));
+  return increment;
+}
+
+BRaster ElCompressedImageBenchmark::readImage(long index) {
+  m_chrono.start();
+  const auto& ext = m_f.access<ImageHdu>(index);
+  const auto image = ext.readRaster<std::int32_t, 2>();
+  m_chrono.stop();
+  const auto rawSize = image.size() * sizeof(std::int32_t);
+  const auto compressedSize = storedSize(ext.header());
+  m_logger.info() << "Compression ratio: " << rawSize / compressedSize;
+  addCompressedSizes(rawSize, compressedSize);
+  BRaster raster({ image.size() });
+  std::copy(image.data(), image.data() + image.size(), raster.data());
+  return raster;
+}
+
 } // namespace Test
 } // namespace Fits
 } // namespace Euclid
@@ -28,8 +28,11 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
+#include <algorithm>
 #include <chrono>
 #include <map>
+#include <numeric>
+#include <random>
 #include <string>
 
 using boost::program_options::value;
@@ -43,6 +46,28 @@ Test::BenchmarkFactory initFactory() {
   factory.registerBenchmark<Test::CfitsioBenchmark>("CFITSIO optimal", 0);
   factory.registerBenchmark<Test::ElColwiseBenchmark>("EleFits column-wise");
   factory.registerBenchmark<Test::ElBenchmark>("EleFits optimal");
+  factory.registerBenchmark<Test::ElCopyBenchmark>("EleFits copy");
+  factory.registerBenchmark<Test::ElRawBenchmark>("EleFits raw");
+  factory.registerBenchmark<Test::ElScatterBenchmark>("EleFits scatter");
+  factory.registerBenchmark<Test::ElAppendBenchmark>("EleFits append", 16L, false);
+  factory.registerBenchmark<Test::ElAppendBenchmark>("EleFits reserved append", 16L, true);
+  factory.registerBenchmark<Test::ElCompressedBenchmark>(
+      "EleFits compressed",
+      10000L,
+      TableCompression::Algorithm::ShuffledGzip);
+  factory.registerBenchmark<Test::ElCompressedBenchmark>(
+      "EleFits Gzip compressed",
+      10000L,
+      TableCompression::Algorithm::Gzip);
+  factory.registerBenchmark<Test::ElCompressedImageBenchmark>("EleFits Rice", ImageCompression::Algorithm::Rice);
+  factory.registerBenchmark<Test::ElCompressedImageBenchmark>("EleFits Gzip", ImageCompression::Algorithm::Gzip);
+  factory.registerBenchmark<Test::ElCompressedImageBenchmark>(
+      "EleFits shuffled Gzip",
+      ImageCompression::Algorithm::ShuffledGzip);
+  factory.registerBenchmark<Test::ElCompressedImageBenchmark>(
+      "EleFits Hcompress",
+      ImageCompression::Algorithm::Hcompress);
+  factory.registerBenchmark<Test::ElCompressedImageBenchmark>("EleFits PLIO", ImageCompression::Algorithm::Plio);
   return factory;
 }
 
@@ -66,6 +91,10 @@ public:
     options.named("pixels", value<int>()->default_value(1), "Number of pixels");
     options.named("tables", value<int>()->default_value(0), "Number of binary table extensions");
     options.named("rows", value<int>()->default_value(1), "Number of rows");
+    options.named(
+        "selectivity",
+        value<double>()->default_value(0),
+        "Fraction of the rows updated in binary table extensions (0 to skip)");
     options.named("output", value<std::string>()->default_value("/tmp/test.fits"), "Output Fits file");
     options.named("res", value<std::string>()->default_value("/tmp/benchmark.csv"), "Output result file");
     return options.asPair();
@@ -80,6 +109,7 @@ public:
     const auto pixelCount = args["pixels"].as<int>();
     const auto tableCount = args["tables"].as<int>();
     const auto rowCount = args["rows"].as<int>();
+    const auto selectivity = args["selectivity"].as<double>();
     const auto filename = args["output"].as<std::string>();
     const auto results = args["res"].as<std::string>();
 
@@ -108,6 +138,9 @@ public:
           "Max (ms)",
           "Mean (ms)",
           "Standard deviation (ms)",
+          "CPU (ms)",
+          "Compression ratio",
+          "Peak RSS (kB, cumulative)",
           "Samples (ms)" });
 
     if (imageCount) {
@@ -119,7 +152,9 @@ public:
       logger.info("Writing image HDUs...");
 
       try {
+        const auto cpuStart = Test::cpuTime();
         const auto chrono = benchmark->writeImages(imageCount, raster);
+        const auto cpu = Test::cpuTime() - cpuStart;
         writer.writeRow(
             "TODO",
             testSetup,
@@ -134,6 +169,9 @@ public:
             chrono.max(),
             chrono.mean(),
             chrono.stdev(),
+            cpu,
+            benchmark->compressionRatio(),
+            Test::peakRss(),
             join(chrono.increments()));
       } catch (const std::exception& e) {
         logger.warn() << e.what();
@@ -142,7 +180,9 @@ public:
       logger.info("Reading image HDUs...");
 
       try {
+        const auto cpuStart = Test::cpuTime();
         const auto chrono = benchmark->readImages(1, imageCount);
+        const auto cpu = Test::cpuTime() - cpuStart;
         writer.writeRow(
             "TODO",
             testSetup,
@@ -157,6 +197,9 @@ public:
             chrono.max(),
             chrono.mean(),
             chrono.stdev(),
+            cpu,
+            benchmark->compressionRatio(),
+            Test::peakRss(),
             join(chrono.increments()));
       } catch (const std::exception& e) {
         logger.warn() << e.what();
@@ -175,6 +218,7 @@ public:
           std::move(table.getColumn<double>()),
           std::move(table.getColumn<std::complex<float>>()),
           std::move(table.getColumn<std::complex<double>>()),
+          FixedStringColumn(table.getColumn<std::string>().info(), table.getColumn<std::string>().vector()),
           std::move(table.getColumn<char>()),
           std::move(table.getColumn<std::uint32_t>()),
           std::move(table.getColumn<std::uint64_t>()));
@@ -182,7 +226,9 @@ public:
       logger.info("Writing binary table HDUs...");
 
       try {
+        const auto cpuStart = Test::cpuTime();
         const auto chrono = benchmark->writeBintables(tableCount, columns);
+        const auto cpu = Test::cpuTime() - cpuStart;
         writer.writeRow(
             "TODO",
             testSetup,
@@ -197,6 +243,9 @@ public:
             chrono.max(),
             chrono.mean(),
             chrono.stdev(),
+            cpu,
+            benchmark->compressionRatio(),
+            Test::peakRss(),
             join(chrono.increments()));
       } catch (const std::exception& e) {
         logger.warn() << e.what();
@@ -205,7 +254,9 @@ public:
       logger.info("Reading binary table HDUs...");
 
       try {
+        const auto cpuStart = Test::cpuTime();
         const auto chrono = benchmark->readBintables(1 + imageCount, tableCount);
+        const auto cpu = Test::cpuTime() - cpuStart;
         writer.writeRow(
             "TODO",
             testSetup,
@@ -220,11 +271,54 @@ public:
             chrono.max(),
             chrono.mean(),
             chrono.stdev(),
+            cpu,
+            benchmark->compressionRatio(),
+            Test::peakRss(),
             join(chrono.increments()));
       } catch (const std::exception& e) {
         logger.warn() << e.what();
       }
 
+      if (selectivity > 0) {
+
+        logger.info("Generating row indices...");
+
+        std::vector<long> rows(rowCount);
+        std::iota(rows.begin(), rows.end(), 0);
+        std::shuffle(rows.begin(), rows.end(), std::mt19937(0));
+        rows.resize(static_cast<long>(selectivity * rowCount));
+        Test::BUpdateColumn column = Test::RandomScalarColumn<Test::BUpdateColumn::Value>(rows.size());
+        column.rename(std::get<Test::BUpdateColumn>(columns).info().name);
+
+        logger.info("Updating binary table HDUs...");
+
+        try {
+          const auto cpuStart = Test::cpuTime();
+          const auto chrono = benchmark->updateBintables(1 + imageCount, tableCount, rows, column);
+          const auto cpu = Test::cpuTime() - cpuStart;
+          writer.writeRow(
+              "TODO",
+              testSetup,
+              "Update",
+              "Binary table",
+              tableCount,
+              rows.size(),
+              tableCount * rows.size(),
+              boost::filesystem::file_size(filename),
+              chrono.elapsed().count(),
+              chrono.min(),
+              chrono.max(),
+              chrono.mean(),
+              chrono.stdev(),
+              cpu,
+              benchmark->compressionRatio(),
+              Test::peakRss(),
+              join(chrono.increments()));
+        } catch (const std::exception& e) {
+          logger.warn() << e.what();
+        }
+      }
+
     } else {
       throw Test::TestCaseNotImplemented(
           "There should be either a positive number of image HDUs or a positive number of binary table HDUs");